@@ -0,0 +1,165 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Runs every ENABLE_BENCHMARKS block and writes the results as JSON.
+    Usage: Benchmarks [--quick] [--filter Group] [--output Results.json] [--baseline Previous.json] [--threshold Percent]
+    With a baseline, anything that got slower than the threshold is listed and the exit code is 1.
+*/
+
+// With BETTER_MALLOC the containers measure mimalloc rather than the CRT heap.
+#define MEMORY_OVERRIDE_NEW
+#include <Utilities.hpp>
+
+#if !defined (BENCHMARK_REVISION)
+    #define BENCHMARK_REVISION "unknown"
+#endif
+
+namespace
+{
+    struct Group_t { std::string_view Name; void (*Callback)(); };
+    constexpr std::array Groups
+    {
+        Group_t{ "AES", Benchmarks::AESbenchmark },
+        Group_t{ "Checksums", Benchmarks::Checksumbenchmark },
+        Group_t{ "SHA", Benchmarks::SHAbenchmark },
+        Group_t{ "Tiger", Benchmarks::Tigerbenchmark },
+        Group_t{ "Bytebuffer", Benchmarks::Bytebufferbenchmark },
+        Group_t{ "Protobuffer", Benchmarks::Protobufferbenchmark },
+        Group_t{ "JSON", Benchmarks::JSONbenchmark },
+        Group_t{ "UTF8", Benchmarks::UTF8benchmark },
+        Group_t{ "Tokenize", Benchmarks::Tokenizebenchmark },
+        Group_t{ "Hex", Benchmarks::Hexbenchmark },
+        Group_t{ "Conversion", Benchmarks::Conversionbenchmark },
+        Group_t{ "LZ4", Benchmarks::LZ4benchmark },
+        Group_t{ "Locks", Benchmarks::Lockbenchmark },
+        Group_t{ "Arena", Benchmarks::Arenabenchmark },
+        Group_t{ "Pool", Benchmarks::Poolbenchmark },
+    };
+
+    std::string Compiler()
+    {
+        #if defined (_MSC_VER) && !defined (__clang__)
+        return std::format("MSVC {}", _MSC_FULL_VER);
+        #elif defined (__clang__)
+        return std::format("Clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__);
+        #else
+        return std::format("GCC {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+        #endif
+    }
+
+    std::string Serialize()
+    {
+        JSON::Array_t Results{};
+        for (const auto &Result : Benchmarks::Results())
+        {
+            JSON::Object_t Entry{};
+            Entry[u8"Name"] = Result.Name;
+            Entry[u8"Threads"] = uint64_t(Result.Threads);
+            Entry[u8"Bytes"] = uint64_t(Result.Bytes);
+            Entry[u8"Iterations"] = Result.Iterations;
+            Entry[u8"NSperop"] = Result.NSperop;
+            Entry[u8"NSmedian"] = Result.NSmedian;
+            Entry[u8"Cyclesperop"] = Result.Cyclesperop;
+            Entry[u8"Cyclesperbyte"] = Result.Cyclesperbyte();
+            Entry[u8"MBpersecond"] = Result.MBpersecond();
+            Results.emplace_back(std::move(Entry));
+        }
+
+        JSON::Object_t Output{};
+        Output[u8"Revision"] = std::string(BENCHMARK_REVISION);
+        Output[u8"Compiler"] = Compiler();
+        Output[u8"Timestamp"] = uint64_t(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        Output[u8"Results"] = std::move(Results);
+
+        return JSON::Dump(JSON::Value_t(std::move(Output)));
+    }
+
+    std::optional<std::string> Readfile(const std::filesystem::path &Path)
+    {
+        const auto File = std::fopen(Path.string().c_str(), "rb");
+        if (!File) return std::nullopt;
+
+        std::string Content{};
+        std::array<char, 4096> Buffer;
+        while (const auto Count = std::fread(Buffer.data(), 1, Buffer.size(), File)) Content.append(Buffer.data(), Count);
+
+        std::fclose(File);
+        return Content;
+    }
+
+    // Matched on name and thread-count, returns the number of regressions.
+    size_t Compare(const std::string &Baseline, double Threshold)
+    {
+        const auto Parsed = JSON::Parse(Baseline);
+        const auto Previous = Parsed[u8"Results"];
+
+        std::unordered_map<std::string, double> Lookup{};
+        for (const auto &Entry : Previous.Get<std::vector<JSON::Value_t>>())
+            Lookup[std::format("{}/{}", Entry[u8"Name"].Get<std::string>(), Entry[u8"Threads"].Get<uint64_t>())] = Entry[u8"NSperop"].Get<double>();
+
+        std::printf("\nCompared to %s:\n", Parsed[u8"Revision"].Get<std::string>().c_str());
+
+        size_t Regressions{};
+        for (const auto &Result : Benchmarks::Results())
+        {
+            const auto Item = Lookup.find(std::format("{}/{}", Result.Name, Result.Threads));
+            if (Item == Lookup.end() || Item->second <= 0.0) continue;
+
+            const auto Change = (Result.NSperop / Item->second - 1.0) * 100.0;
+            const auto isRegression = Change > Threshold;
+            Regressions += isRegression;
+
+            std::printf("%-48s %2zu thr %+8.1f %%%s\n", Result.Name.c_str(), Result.Threads, Change, isRegression ? "  REGRESSED" : "");
+        }
+
+        return Regressions;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string_view Filter{};
+    std::filesystem::path Output{ "Benchmarks.json" }, Baseline{};
+    double Threshold = 10.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view Argument{ argv[i] };
+        const auto hasValue = i + 1 < argc;
+
+        if (Argument == "--quick") { Benchmarks::Roundtime = std::chrono::milliseconds(5); Benchmarks::Rounds = 3; }
+        else if (Argument == "--filter" && hasValue) Filter = argv[++i];
+        else if (Argument == "--output" && hasValue) Output = argv[++i];
+        else if (Argument == "--baseline" && hasValue) Baseline = argv[++i];
+        else if (Argument == "--threshold" && hasValue) Threshold = std::strtod(argv[++i], nullptr);
+        else
+        {
+            std::printf("Usage: %s [--quick] [--filter Group] [--output Results.json] [--baseline Previous.json] [--threshold Percent]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("Revision %s, %s\n\n", BENCHMARK_REVISION, Compiler().c_str());
+    for (const auto &Group : Groups)
+    {
+        if (!Filter.empty() && Group.Name != Filter) continue;
+        Group.Callback();
+    }
+
+    const auto Serialized = Serialize();
+    if (const auto File = std::fopen(Output.string().c_str(), "wb"))
+    {
+        std::fwrite(Serialized.data(), 1, Serialized.size(), File);
+        std::fclose(File);
+    }
+    else std::printf("Could not write %s\n", Output.string().c_str());
+
+    if (Baseline.empty()) return 0;
+
+    const auto Previous = Readfile(Baseline);
+    if (!Previous) { std::printf("Could not read %s\n", Baseline.string().c_str()); return 2; }
+
+    return Compare(*Previous, Threshold) ? 1 : 0;
+}
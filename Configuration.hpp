@@ -27,7 +27,7 @@
 #elif defined (__GNUC__) || defined (__clang__)
 #define EXPORT_ATTR __attribute__((visibility("default")))
 #define IMPORT_ATTR
-#define INLINE_ATTR __attribute__((always_inline))
+#define INLINE_ATTR __attribute__((always_inline)) inline
 #define NOINLINE_ATTR __attribute__((noinline))
 #else
 #error Unknown compiler..
@@ -66,7 +66,7 @@ namespace Build
     #endif
 }
 
-// Information logging.
+// Information logging, messages are usually built with va_view() so Print should copy anything it keeps.
 //namespace Logging { template <typename T> extern void Print(char Prefix, const T &Message); }
 //#define Debugprint(string) if constexpr (Build::isDebug) Logging::Print('D', string)
 //#define Traceprint() if constexpr (Build::isDebug) Logging::Print('>', __FUNCTION__)
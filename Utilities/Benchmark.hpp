@@ -0,0 +1,159 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Tiny harness for the ENABLE_BENCHMARKS blocks, results are collected and dumped by Benchmarks/Main.cpp.
+    Every measurement is repeated for a few rounds and the fastest one kept, so noise only ever makes numbers worse.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+#include "CPUID.hpp"
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    struct Result_t
+    {
+        std::string Name;
+        size_t Threads, Bytes;      // Bytes processed per operation, 0 for pure latency.
+        uint64_t Iterations;        // Per round.
+        double NSperop, NSmedian, Cyclesperop;
+
+        double Cyclesperbyte() const { return Bytes ? Cyclesperop / double(Bytes) : 0.0; }
+        double MBpersecond() const { return Bytes ? double(Bytes) * 1000.0 / NSperop : 0.0; }
+    };
+
+    // Tunables for the runner, shorter rounds for a quick smoke-run.
+    inline std::chrono::nanoseconds Roundtime{ std::chrono::milliseconds(25) };
+    inline size_t Rounds{ 5 };
+
+    inline std::vector<Result_t> &Results()
+    {
+        static std::vector<Result_t> Storage{};
+        return Storage;
+    }
+
+    // TSC cycles where available, nanoseconds otherwise.
+    inline uint64_t Cycles() noexcept
+    {
+        #if defined(HAS_CPUID)
+        return __rdtsc();
+        #else
+        return uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+    }
+
+    // Make the compiler believe the value is used, so the work producing it isn't discarded.
+    template <typename T> INLINE_ATTR void Keep(const T &Value) noexcept
+    {
+        #if defined (_MSC_VER)
+        static const volatile void *volatile Sink{};
+        Sink = &Value;
+        _ReadWriteBarrier();
+        #else
+        __asm__ volatile("" : : "r"(&Value) : "memory");
+        #endif
+    }
+
+    // Deterministic filler so runs are comparable between commits.
+    inline std::vector<uint8_t> Randombytes(size_t Size, uint64_t Seed = 0x9E3779B97F4A7C15ULL)
+    {
+        std::vector<uint8_t> Output(Size);
+        for (auto &Byte : Output) { Seed = Seed * 6364136223846793005ULL + 1442695040888963407ULL; Byte = uint8_t(Seed >> 56); }
+        return Output;
+    }
+
+    namespace Internal
+    {
+        inline void Report(Result_t &&Result)
+        {
+            std::printf("%-48s %2zu thr %12.2f ns/op", Result.Name.c_str(), Result.Threads, Result.NSperop);
+            if (Result.Bytes) std::printf(" %8.2f cycles/byte %10.1f MB/s", Result.Cyclesperbyte(), Result.MBpersecond());
+            std::printf("\n");
+
+            Results().emplace_back(std::move(Result));
+        }
+
+        inline double Median(std::vector<double> Values)
+        {
+            std::ranges::sort(Values);
+            return Values[Values.size() / 2];
+        }
+    }
+
+    // Callback() is one operation touching Bytes bytes.
+    template <typename F> void Measure(std::string_view Name, size_t Bytes, F &&Callback)
+    {
+        using Clock_t = std::chrono::steady_clock;
+
+        // Warmup, then grow the batch until it fills a round.
+        Callback();
+        uint64_t Iterations = 1;
+        while (true)
+        {
+            const auto Start = Clock_t::now();
+            for (uint64_t i = 0; i < Iterations; ++i) Callback();
+            if (Clock_t::now() - Start >= Roundtime / 4 || Iterations >= (uint64_t(1) << 32)) break;
+            Iterations *= 2;
+        }
+        Iterations *= 4;
+
+        std::vector<double> Times{};
+        double Best = std::numeric_limits<double>::max(), Bestcycles{};
+
+        for (size_t Round = 0; Round < Rounds; ++Round)
+        {
+            const auto Start = Clock_t::now();
+            const auto Startcycles = Cycles();
+            for (uint64_t i = 0; i < Iterations; ++i) Callback();
+            const auto Elapsedcycles = Cycles() - Startcycles;
+            const auto Elapsed = std::chrono::duration<double, std::nano>(Clock_t::now() - Start).count();
+
+            Times.push_back(Elapsed / double(Iterations));
+            if (Times.back() < Best) { Best = Times.back(); Bestcycles = double(Elapsedcycles) / double(Iterations); }
+        }
+
+        Internal::Report({ std::string(Name), 1, Bytes, Iterations, Best, Internal::Median(Times), Bestcycles });
+    }
+
+    // Callback(Threadindex) is one operation, run Iterations times on every thread at once; ns/op is wall time over all operations.
+    template <typename F> void Measurethreads(std::string_view Name, size_t Threads, uint64_t Iterations, F &&Callback)
+    {
+        std::vector<double> Times{};
+        double Best = std::numeric_limits<double>::max(), Bestcycles{};
+
+        for (size_t Round = 0; Round < Rounds; ++Round)
+        {
+            std::atomic<size_t> Ready{};
+            std::atomic<bool> Go{};
+
+            std::vector<std::jthread> Workers{};
+            for (size_t t = 0; t < Threads; ++t)
+            {
+                Workers.emplace_back([&, t]()
+                {
+                    Ready.fetch_add(1);
+                    while (!Go.load(std::memory_order_acquire)) std::this_thread::yield();
+                    for (uint64_t i = 0; i < Iterations; ++i) Callback(t);
+                });
+            }
+            while (Ready.load() != Threads) std::this_thread::yield();
+
+            const auto Start = std::chrono::steady_clock::now();
+            const auto Startcycles = Cycles();
+            Go.store(true, std::memory_order_release);
+            for (auto &Worker : Workers) Worker.join();
+            const auto Elapsedcycles = Cycles() - Startcycles;
+            const auto Elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+
+            const auto Operations = double(Iterations * Threads);
+            Times.push_back(Elapsed / Operations);
+            if (Times.back() < Best) { Best = Times.back(); Bestcycles = double(Elapsedcycles) / Operations; }
+        }
+
+        Internal::Report({ std::string(Name), Threads, 0, Iterations, Best, Internal::Median(Times), Bestcycles });
+    }
+}
+#endif
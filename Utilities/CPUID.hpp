@@ -0,0 +1,123 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Runtime detection of instruction-set extensions, queried once per process.
+*/
+
+#pragma once
+#include <bit>
+#include <array>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HAS_CPUID
+#include <intrin.h>
+#endif
+
+namespace CPUID
+{
+    struct Features_t
+    {
+        bool SSSE3, SSE41, SSE42, PCLMUL, AESNI, AVX, F16C;
+        bool AVX2, BMI2, SHA;
+        bool AVX512F, AVX512BW, AVX512VL, AVX512BF16;
+    };
+
+    namespace Internal
+    {
+        inline std::array<uint32_t, 4> Query(uint32_t Leaf, uint32_t Subleaf = 0)
+        {
+            #if defined(HAS_CPUID)
+            #if defined(_MSC_VER)
+            std::array<int, 4> Registers{};
+            __cpuidex(Registers.data(), int(Leaf), int(Subleaf));
+            return std::bit_cast<std::array<uint32_t, 4>>(Registers);
+            #else
+            std::array<uint32_t, 4> Registers{};
+            __cpuid_count(Leaf, Subleaf, Registers[0], Registers[1], Registers[2], Registers[3]);
+            return Registers;
+            #endif
+            #else
+            return {};
+            #endif
+        }
+
+        // Which register-sets the OS saves on context switches.
+        inline uint64_t XCR0()
+        {
+            #if defined(HAS_CPUID)
+            #if defined(_MSC_VER)
+            return _xgetbv(0);
+            #else
+            uint32_t Low, High;
+            __asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+            return (uint64_t(High) << 32) | Low;
+            #endif
+            #else
+            return 0;
+            #endif
+        }
+
+        inline Features_t Detect()
+        {
+            Features_t Features{};
+
+            const auto Maxleaf = Query(0)[0];
+            if (Maxleaf < 1) return Features;
+
+            const auto Leaf1 = Query(1);
+            Features.SSSE3 = Leaf1[2] & (1 << 9);
+            Features.SSE41 = Leaf1[2] & (1 << 19);
+            Features.SSE42 = Leaf1[2] & (1 << 20);
+            Features.PCLMUL = Leaf1[2] & (1 << 1);
+            Features.AESNI = Leaf1[2] & (1 << 25);
+
+            // AVX needs the OS to preserve YMM, AVX-512 also needs the opmask and ZMM state.
+            const bool OSXSAVE = Leaf1[2] & (1 << 27);
+            const auto XCR = OSXSAVE ? XCR0() : 0;
+            const bool YMM = (XCR & 0x06) == 0x06;
+            const bool ZMM = YMM && (XCR & 0xE0) == 0xE0;
+
+            Features.AVX = YMM && (Leaf1[2] & (1 << 28));
+            Features.F16C = Features.AVX && (Leaf1[2] & (1 << 29));
+
+            if (Maxleaf < 7) return Features;
+            const auto Leaf7 = Query(7, 0);
+            const auto Leaf71 = Query(7, 1);
+
+            Features.AVX2 = Features.AVX && (Leaf7[1] & (1 << 5));
+            Features.BMI2 = Leaf7[1] & (1 << 8);
+            Features.SHA = Leaf7[1] & (1 << 29);
+
+            Features.AVX512F = ZMM && (Leaf7[1] & (1 << 16));
+            Features.AVX512BW = Features.AVX512F && (Leaf7[1] & (1 << 30));
+            Features.AVX512VL = Features.AVX512F && (Leaf7[1] & (1U << 31));
+            Features.AVX512BF16 = Features.AVX512F && (Leaf71[0] & (1 << 5));
+
+            return Features;
+        }
+    }
+
+    inline const Features_t &Get()
+    {
+        static const Features_t Features = Internal::Detect();
+        return Features;
+    }
+
+    inline bool hasSSSE3() { return Get().SSSE3; }
+    inline bool hasSSE41() { return Get().SSE41; }
+    inline bool hasSSE42() { return Get().SSE42; }
+    inline bool hasPCLMUL() { return Get().PCLMUL; }
+    inline bool hasAESNI() { return Get().AESNI; }
+    inline bool hasAVX() { return Get().AVX; }
+    inline bool hasF16C() { return Get().F16C; }
+    inline bool hasAVX2() { return Get().AVX2; }
+    inline bool hasBMI2() { return Get().BMI2; }
+    inline bool hasSHA() { return Get().SHA; }
+    inline bool hasAVX512F() { return Get().AVX512F; }
+    inline bool hasAVX512BW() { return Get().AVX512BW; }
+    inline bool hasAVX512VL() { return Get().AVX512VL; }
+    inline bool hasAVX512BF16() { return Get().AVX512BF16; }
+}
@@ -0,0 +1,9 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+*/
+
+#pragma once
+#include "Compression/LZ4.hpp"
+#include "Compression/Pipeline.hpp"
@@ -0,0 +1,445 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Fast LZ compression using the LZ4 block format, and a simple framed format for streaming.
+    Blocks are limited to 2 GiB, frames split the input into independent blocks of 64 KiB by default.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "../Crypto/Checksums.hpp"
+
+namespace LZ4
+{
+    namespace Internal
+    {
+        constexpr size_t Minmatch = 4, Lastliterals = 5, Matchstartlimit = 12;
+        constexpr size_t Hashlog = 12, Maxoffset = 65535;
+
+        inline uint32_t Read32(const uint8_t *Input) { uint32_t Value; std::memcpy(&Value, Input, sizeof(Value)); return Value; }
+        inline uint64_t Read64(const uint8_t *Input) { uint64_t Value; std::memcpy(&Value, Input, sizeof(Value)); return Value; }
+        inline uint32_t Hash(uint32_t Sequence) { return (Sequence * 2654435761U) >> (32 - Hashlog); }
+
+        // Common prefix of the two positions, stopping at Limit.
+        inline size_t Matchlength(const uint8_t *Input, const uint8_t *Match, const uint8_t *Limit)
+        {
+            const auto Start = Input;
+
+            while (Input + 8 <= Limit)
+            {
+                if (const auto Difference = Read64(Input) ^ Read64(Match))
+                    return size_t(Input - Start) + (std::countr_zero(cmp::toLittle(Difference)) >> 3);
+
+                Input += 8; Match += 8;
+            }
+            while (Input < Limit && *Input == *Match) { ++Input; ++Match; }
+
+            return size_t(Input - Start);
+        }
+
+        // Lengths of 15 and up continue in 255-valued bytes.
+        inline uint8_t *Writelength(uint8_t *Output, size_t Length)
+        {
+            for (; Length >= 255; Length -= 255) *Output++ = 255;
+            *Output++ = uint8_t(Length);
+            return Output;
+        }
+        inline bool Readlength(const uint8_t *&Input, const uint8_t *End, size_t &Length)
+        {
+            uint8_t Byte;
+            do
+            {
+                if (Input >= End) [[unlikely]] return false;
+                Byte = *Input++;
+                Length += Byte;
+            } while (Byte == 255);
+
+            return true;
+        }
+    }
+
+    // Worst case output for incompressible input.
+    [[nodiscard]] constexpr size_t Compressbound(size_t Size) { return Size + Size / 255 + 16; }
+
+    // Returns the compressed size, or 0 if Output is too small.
+    [[nodiscard]] inline size_t Compress(std::span<const uint8_t> Input, std::span<uint8_t> Output)
+    {
+        using namespace Internal;
+        ASSERT(Input.size() < 0x7E000000);
+
+        const uint8_t *const Base = Input.data(), *const End = Base + Input.size();
+        uint8_t *Write = Output.data(), *const Outputend = Write + Output.size();
+        const uint8_t *Anchor = Base, *Read = Base;
+
+        // Too short for the end-of-block rules to allow a match.
+        if (Input.size() > Matchstartlimit)
+        {
+            const auto Matchlimit = End - Lastliterals, Startlimit = End - Matchstartlimit;
+            std::array<uint32_t, 1 << Hashlog> Table{};
+            Read++;
+
+            while (true)
+            {
+                // Skip faster the longer nothing matches.
+                const uint8_t *Match{};
+                for (size_t Attempts = 1 << 6; ; Read += Attempts++ >> 6)
+                {
+                    if (Read > Startlimit) goto LABEL_LAST;
+
+                    auto &Slot = Table[Hash(Read32(Read))];
+                    Match = Base + Slot;
+                    Slot = uint32_t(Read - Base);
+
+                    if (Match < Read && size_t(Read - Match) <= Maxoffset && Read32(Match) == Read32(Read)) break;
+                }
+
+                while (Read > Anchor && Match > Base && Read[-1] == Match[-1]) { --Read; --Match; }
+
+                // Token, literals and offset.
+                const auto Literals = size_t(Read - Anchor);
+                if (Write + 1 + Literals / 255 + 1 + Literals + 2 > Outputend) [[unlikely]] return 0;
+
+                const auto Token = Write++;
+                if (Literals >= 15) { *Token = 15 << 4; Write = Writelength(Write, Literals - 15); }
+                else *Token = uint8_t(Literals << 4);
+
+                std::memcpy(Write, Anchor, Literals);
+                Write += Literals;
+
+                const auto Offset = uint16_t(Read - Match);
+                Write[0] = uint8_t(Offset); Write[1] = uint8_t(Offset >> 8);
+                Write += 2;
+
+                const auto Length = Matchlength(Read + Minmatch, Match + Minmatch, Matchlimit);
+                Read += Minmatch + Length;
+
+                if (Write + Length / 255 + 1 > Outputend) [[unlikely]] return 0;
+                if (Length >= 15) { *Token |= 15; Write = Writelength(Write, Length - 15); }
+                else *Token |= uint8_t(Length);
+
+                Anchor = Read;
+                if (Read > Startlimit) break;
+
+                // Positions inside the match are likely to be referenced again.
+                Table[Hash(Read32(Read - 2))] = uint32_t(Read - 2 - Base);
+            }
+        }
+
+        LABEL_LAST:
+        const auto Literals = size_t(End - Anchor);
+        if (Write + 1 + Literals / 255 + 1 + Literals > Outputend) [[unlikely]] return 0;
+
+        const auto Token = Write++;
+        if (Literals >= 15) { *Token = 15 << 4; Write = Internal::Writelength(Write, Literals - 15); }
+        else *Token = uint8_t(Literals << 4);
+
+        if (Literals) std::memcpy(Write, Anchor, Literals);
+        Write += Literals;
+
+        return size_t(Write - Output.data());
+    }
+
+    // Output must be exactly the decompressed size, false on malformed input.
+    [[nodiscard]] inline bool Decompress(std::span<const uint8_t> Input, std::span<uint8_t> Output)
+    {
+        using namespace Internal;
+
+        const uint8_t *Read = Input.data(), *const End = Read + Input.size();
+        uint8_t *Write = Output.data(), *const Outputend = Write + Output.size();
+
+        while (true)
+        {
+            if (Read >= End) [[unlikely]] return false;
+            const auto Token = *Read++;
+
+            size_t Literals = Token >> 4;
+            if (Literals == 15 && !Readlength(Read, End, Literals)) [[unlikely]] return false;
+            if (Literals > size_t(End - Read) || Literals > size_t(Outputend - Write)) [[unlikely]] return false;
+
+            // Short literal runs are copied in one go when there's slack on both sides.
+            if (Literals <= 16 && End - Read >= 16 && Outputend - Write >= 16) std::memcpy(Write, Read, 16);
+            else if (Literals) std::memcpy(Write, Read, Literals);
+            Write += Literals; Read += Literals;
+
+            // The last sequence is only literals.
+            if (Read == End) return Write == Outputend;
+
+            if (End - Read < 2) [[unlikely]] return false;
+            const size_t Offset = Read[0] | (Read[1] << 8);
+            Read += 2;
+
+            if (Offset == 0 || Offset > size_t(Write - Output.data())) [[unlikely]] return false;
+
+            size_t Length = Token & 15;
+            if (Length == 15 && !Readlength(Read, End, Length)) [[unlikely]] return false;
+            Length += Minmatch;
+            if (Length > size_t(Outputend - Write)) [[unlikely]] return false;
+
+            // Overlapping copies repeat the pattern, so byte by byte unless the offset covers a whole word.
+            const auto Match = Write - Offset;
+            if (Offset >= 8 && size_t(Outputend - Write) >= Length + 8)
+            {
+                for (size_t i = 0; i < Length; i += 8) std::memcpy(Write + i, Match + i, 8);
+            }
+            else
+            {
+                for (size_t i = 0; i < Length; ++i) Write[i] = Match[i];
+            }
+            Write += Length;
+        }
+    }
+
+    // Frame: "AYLZ", version, log2(blocksize), then blocks of { stored size | raw flag, raw size, CRC32C of raw data, payload }.
+    // A zero stored size ends the frame.
+    namespace Frame
+    {
+        constexpr uint32_t Magic = 0x5A4C5941;
+        constexpr uint8_t Version = 1, Maxblocklog = 22;
+        constexpr uint32_t Storedflag = 0x80000000U;
+        constexpr size_t Headersize = 6, Blockheadersize = 12;
+
+        inline void Write32(uint8_t *Output, uint32_t Value) { Value = cmp::toLittle(Value); std::memcpy(Output, &Value, sizeof(Value)); }
+        inline uint32_t Read32(const uint8_t *Input) { return cmp::fromLittle(Internal::Read32(Input)); }
+    }
+
+    struct Framewriter_t
+    {
+        Blob_t Output{}, Pending{};
+        size_t Blocksize;
+
+        // Blocksize is rounded down to a power of two, 64 KiB is a good fit for L2.
+        explicit Framewriter_t(size_t Blocksize = 64 * 1024)
+        {
+            const auto Log = uint8_t(std::clamp<size_t>(std::bit_width(Blocksize) - 1, 10, Frame::Maxblocklog));
+            this->Blocksize = size_t(1) << Log;
+
+            Output.resize(Frame::Headersize);
+            Frame::Write32(Output.data(), Frame::Magic);
+            Output[4] = Frame::Version;
+            Output[5] = Log;
+        }
+
+        void Write(std::span<const uint8_t> Input)
+        {
+            // Top up a partial block first, then compress straight from the input.
+            if (!Pending.empty())
+            {
+                const auto Count = std::min(Input.size(), Blocksize - Pending.size());
+                Pending.append(Input.data(), Count);
+                Input = Input.subspan(Count);
+
+                if (Pending.size() < Blocksize) return;
+                Emit(Pending);
+                Pending.clear();
+            }
+
+            for (; Input.size() >= Blocksize; Input = Input.subspan(Blocksize)) Emit(Input.first(Blocksize));
+            if (!Input.empty()) Pending.append(Input.data(), Input.size());
+        }
+
+        // Output produced so far, for sending while the stream is still being written.
+        [[nodiscard]] Blob_t Take() { return std::exchange(Output, {}); }
+
+        [[nodiscard]] Blob_t Finish()
+        {
+            if (!Pending.empty()) Emit(Pending);
+            Pending.clear();
+
+            const auto Offset = Output.size();
+            Output.resize(Offset + 4);
+            Frame::Write32(Output.data() + Offset, 0);
+            return Take();
+        }
+
+        private:
+        void Emit(std::span<const uint8_t> Block)
+        {
+            const auto Offset = Output.size();
+            Output.resize(Offset + Frame::Blockheadersize + Compressbound(Block.size()));
+
+            const auto Payload = Output.data() + Offset + Frame::Blockheadersize;
+            auto Stored = Compress(Block, { Payload, Compressbound(Block.size()) });
+            auto Sizefield = uint32_t(Stored);
+
+            // Incompressible data is kept as is.
+            if (Stored == 0 || Stored >= Block.size())
+            {
+                std::memcpy(Payload, Block.data(), Block.size());
+                Stored = Block.size();
+                Sizefield = uint32_t(Stored) | Frame::Storedflag;
+            }
+
+            Frame::Write32(Output.data() + Offset, Sizefield);
+            Frame::Write32(Output.data() + Offset + 4, uint32_t(Block.size()));
+            Frame::Write32(Output.data() + Offset + 8, Hash::CRC32C(Block));
+            Output.resize(Offset + Frame::Blockheadersize + Stored);
+        }
+    };
+
+    struct Framereader_t
+    {
+        Blob_t Input{}, Output{};
+        size_t Consumed{}, Blocksize{};
+        bool Finished{}, Failed{};
+
+        // Decodes every complete block, returns false once the stream is known to be corrupt.
+        bool Feed(std::span<const uint8_t> Data)
+        {
+            if (Failed) return false;
+            if (Finished) return Data.empty();
+
+            Input.append(Data.data(), Data.size());
+
+            if (!Blocksize)
+            {
+                if (Input.size() < Frame::Headersize) return true;
+                if (Frame::Read32(Input.data()) != Frame::Magic || Input[4] != Frame::Version || Input[5] > Frame::Maxblocklog) return Fail();
+
+                Blocksize = size_t(1) << Input[5];
+                Consumed = Frame::Headersize;
+            }
+
+            while (!Finished)
+            {
+                const auto Available = Input.size() - Consumed;
+                if (Available < 4) break;
+
+                const auto Block = Input.data() + Consumed;
+                const auto Sizefield = Frame::Read32(Block);
+                if (Sizefield == 0)
+                {
+                    Finished = true;
+                    Consumed += 4;
+                    if (Consumed != Input.size()) return Fail();
+                    break;
+                }
+
+                if (Available < Frame::Blockheadersize) break;
+                const auto Stored = size_t(Sizefield & ~Frame::Storedflag), Rawsize = size_t(Frame::Read32(Block + 4));
+                if (Rawsize > Blocksize || Stored > Compressbound(Blocksize)) return Fail();
+                if (Available < Frame::Blockheadersize + Stored) break;
+
+                const auto Payload = std::span(Block + Frame::Blockheadersize, Stored);
+                const auto Offset = Output.size();
+                Output.resize(Offset + Rawsize);
+
+                const auto Target = std::span(Output.data() + Offset, Rawsize);
+                if (Sizefield & Frame::Storedflag)
+                {
+                    if (Stored != Rawsize) return Fail();
+                    std::memcpy(Target.data(), Payload.data(), Rawsize);
+                }
+                else if (!Decompress(Payload, Target)) return Fail();
+
+                if (Hash::CRC32C(Target) != Frame::Read32(Block + 8)) return Fail();
+                Consumed += Frame::Blockheadersize + Stored;
+            }
+
+            // Drop what has been decoded so the buffer doesn't keep growing.
+            if (Consumed > 1 << 20 || Finished)
+            {
+                Input.erase(0, Consumed);
+                Consumed = 0;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] Blob_t Take() { return std::exchange(Output, {}); }
+        [[nodiscard]] bool isDone() const noexcept { return Finished; }
+
+        private:
+        bool Fail() { Failed = true; Output.clear(); return false; }
+    };
+
+    [[nodiscard]] inline Blob_t Compressframe(std::span<const uint8_t> Input, size_t Blocksize = 64 * 1024)
+    {
+        Framewriter_t Writer(Blocksize);
+        Writer.Write(Input);
+        return Writer.Finish();
+    }
+    [[nodiscard]] inline std::optional<Blob_t> Decompressframe(std::span<const uint8_t> Input)
+    {
+        Framereader_t Reader{};
+        if (!Reader.Feed(Input) || !Reader.isDone()) return std::nullopt;
+        return Reader.Take();
+    }
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void LZ4test()
+    {
+        // Text-like, runs, random and tiny inputs.
+        std::vector<Blob_t> Inputs(5);
+        for (size_t i = 0; i < 200000; ++i) Inputs[0].push_back(uint8_t("The quick brown fox jumps over the lazy dog. "[i % 45] + (i / 4500) % 3));
+        Inputs[1].assign(100000, uint8_t(7));
+        for (uint64_t i = 0, State = 42; i < 100000; ++i) { State = State * 6364136223846793005ULL + 1442695040888963407ULL; Inputs[2].push_back(uint8_t(State >> 56)); }
+        Inputs[3] = { 1, 2, 3 };
+
+        for (const auto &Input : Inputs)
+        {
+            Blob_t Compressed(LZ4::Compressbound(Input.size()), 0);
+            Compressed.resize(LZ4::Compress(Input, Compressed));
+
+            Blob_t Output(Input.size(), 0);
+            if (Compressed.empty() || !LZ4::Decompress(Compressed, Output) || Output != Input) { std::printf("BROKEN: LZ4 block roundtrip\n"); break; }
+        }
+
+        {
+            Blob_t Compressed(LZ4::Compressbound(Inputs[1].size()), 0);
+            Compressed.resize(LZ4::Compress(Inputs[1], Compressed));
+            if (Compressed.size() > 1000) std::printf("BROKEN: LZ4 ratio\n");
+
+            // Truncated or wrongly sized data must fail cleanly.
+            Blob_t Output(Inputs[1].size(), 0), Short(Inputs[1].size() - 1, 0);
+            if (LZ4::Decompress(std::span(Compressed).first(Compressed.size() - 1), Output) || LZ4::Decompress(Compressed, Short))
+                std::printf("BROKEN: LZ4 malformed input\n");
+        }
+
+        // Streaming in odd pieces.
+        LZ4::Framewriter_t Writer(16 * 1024);
+        for (size_t Offset = 0; Offset < Inputs[0].size(); Offset += 7777) Writer.Write(std::span(Inputs[0]).subspan(Offset, std::min<size_t>(7777, Inputs[0].size() - Offset)));
+        const auto Frame = Writer.Finish();
+
+        LZ4::Framereader_t Reader{};
+        Blob_t Decoded{};
+        for (size_t Offset = 0; Offset < Frame.size(); Offset += 1000)
+        {
+            if (!Reader.Feed(std::span(Frame).subspan(Offset, std::min<size_t>(1000, Frame.size() - Offset)))) break;
+            Decoded += Reader.Take();
+        }
+        if (!Reader.isDone() || Decoded != Inputs[0]) std::printf("BROKEN: LZ4 frame streaming\n");
+
+        auto Corrupt = LZ4::Compressframe(Inputs[2]);
+        Corrupt[100] ^= 1;
+        if (LZ4::Decompressframe(Corrupt) || LZ4::Decompressframe(LZ4::Compressframe(Inputs[4])) != Inputs[4]) std::printf("BROKEN: LZ4 frame checks\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // Bytes are the uncompressed size both ways.
+    inline void LZ4benchmark()
+    {
+        std::vector<uint8_t> Text{};
+        for (size_t i = 0; Text.size() < 1024 * 1024; ++i)
+        {
+            const auto Line = std::format("{} INFO Request {} served in {} ms\n", 1700000000 + i, i * 7 % 1000, i % 97);
+            Text.insert(Text.end(), Line.begin(), Line.end());
+        }
+        Text.resize(1024 * 1024);
+
+        std::vector<uint8_t> Compressed(LZ4::Compressbound(Text.size())), Output(Text.size());
+        Compressed.resize(LZ4::Compress(Text, Compressed));
+
+        Measure("LZ4::Compress (1 MiB text)", Text.size(), [&]() { Keep(LZ4::Compress(Text, std::span(Output.data(), Output.size()))); });
+        Measure("LZ4::Decompress (1 MiB text)", Text.size(), [&]() { Keep(LZ4::Decompress(Compressed, Output)); });
+    }
+}
+#endif
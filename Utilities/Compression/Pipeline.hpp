@@ -0,0 +1,228 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Compress, encrypt and checksum a payload in one pass per 64 KiB chunk while it's still in cache.
+    Chunks are independent (AES-CTR with a per-chunk nonce), so big payloads are spread over the scheduler.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "../Crypto/AES.hpp"
+#include "../Threading/Scheduler.hpp"
+#include "LZ4.hpp"
+
+// Header: "AYPL", version, flags, reserved, chunk count, total size.
+// Chunks: { stored size | raw flag, raw size, WW64 of the stored (encrypted) bytes, payload }.
+namespace Pipeline
+{
+    using Cipher_t = AES::Context_t<AES::AES_CTR, 8>;
+
+    constexpr uint32_t Magic = 0x4C505941;
+    constexpr uint8_t Version = 1, Encryptedflag = 1;
+    constexpr size_t Chunksize = 64 * 1024, Headersize = 20, Chunkheadersize = 16;
+
+    namespace Internal
+    {
+        inline void Write32(uint8_t *Output, uint32_t Value) { Value = cmp::toLittle(Value); std::memcpy(Output, &Value, sizeof(Value)); }
+        inline void Write64(uint8_t *Output, uint64_t Value) { Value = cmp::toLittle(Value); std::memcpy(Output, &Value, sizeof(Value)); }
+        inline uint32_t Read32(const uint8_t *Input) { uint32_t Value; std::memcpy(&Value, Input, sizeof(Value)); return cmp::fromLittle(Value); }
+        inline uint64_t Read64(const uint8_t *Input) { uint64_t Value; std::memcpy(&Value, Input, sizeof(Value)); return cmp::fromLittle(Value); }
+
+        // The chunk index goes into the nonce above the 32-bit block counter.
+        inline Cipher_t Chunkcipher(const Cipher_t &Cipher, const std::array<uint8_t, 16> &IV, size_t Index)
+        {
+            auto Nonce = IV;
+            for (size_t i = 0; i < 4; ++i) Nonce[8 + i] ^= uint8_t(Index >> (24 - i * 8));
+
+            auto Result = Cipher;
+            Result.Reset(Nonce);
+            return Result;
+        }
+
+        // Runs Body(Index) for every chunk, in parallel once there's enough of them to be worth it.
+        template <typename F> void Forchunks(size_t Count, Scheduler_t &Scheduler, F &&Body)
+        {
+            if (Count < 4) for (size_t i = 0; i < Count; ++i) Body(i);
+            else ParallelFor(std::views::iota(size_t(0), Count), Body, 1, Scheduler);
+        }
+
+        inline Blob_t Encode(std::span<const uint8_t> Input, const Cipher_t *Cipher, Scheduler_t &Scheduler)
+        {
+            const auto Count = (Input.size() + Chunksize - 1) / Chunksize;
+            const auto IV = Cipher ? Cipher->State : std::array<uint8_t, 16>{};
+            std::vector<Blob_t> Chunks(Count);
+
+            Forchunks(Count, Scheduler, [&](size_t Index)
+            {
+                const auto Raw = Input.subspan(Index * Chunksize, std::min(Chunksize, Input.size() - Index * Chunksize));
+                auto &Chunk = Chunks[Index];
+                Chunk.resize(Chunkheadersize + LZ4::Compressbound(Raw.size()));
+
+                const auto Payload = Chunk.data() + Chunkheadersize;
+                auto Stored = LZ4::Compress(Raw, { Payload, Chunk.size() - Chunkheadersize });
+                auto Sizefield = uint32_t(Stored);
+
+                if (Stored == 0 || Stored >= Raw.size())
+                {
+                    std::memcpy(Payload, Raw.data(), Raw.size());
+                    Stored = Raw.size();
+                    Sizefield = uint32_t(Stored) | LZ4::Frame::Storedflag;
+                }
+
+                const auto Body = std::span(Payload, Stored);
+                if (Cipher) Chunkcipher(*Cipher, IV, Index).Encrypt(Body, Payload);
+
+                Write32(Chunk.data(), Sizefield);
+                Write32(Chunk.data() + 4, uint32_t(Raw.size()));
+                Write64(Chunk.data() + 8, Hash::WW64(Body));
+                Chunk.resize(Chunkheadersize + Stored);
+            });
+
+            size_t Total = Headersize;
+            for (const auto &Chunk : Chunks) Total += Chunk.size();
+
+            Blob_t Output(Headersize, 0);
+            Output.reserve(Total);
+            Write32(Output.data(), Magic);
+            Output[4] = Version;
+            Output[5] = Cipher ? Encryptedflag : 0;
+            Write32(Output.data() + 8, uint32_t(Count));
+            Write64(Output.data() + 12, Input.size());
+
+            for (const auto &Chunk : Chunks) Output += Chunk;
+            return Output;
+        }
+
+        inline std::optional<Blob_t> Decode(std::span<const uint8_t> Input, const Cipher_t *Cipher, Scheduler_t &Scheduler)
+        {
+            if (Input.size() < Headersize || Read32(Input.data()) != Magic || Input[4] != Version) return std::nullopt;
+            if (bool(Input[5] & Encryptedflag) != bool(Cipher)) return std::nullopt;
+
+            const auto Count = size_t(Read32(Input.data() + 8));
+            const auto Size = Read64(Input.data() + 12);
+            if (Count != (Size + Chunksize - 1) / Chunksize) return std::nullopt;
+
+            // Both come from the header, so bound them by what the input can hold before allocating anything.
+            if (Count > (Input.size() - Headersize) / Chunkheadersize) return std::nullopt;
+
+            // Cheap serial walk over the headers so the chunks can be processed independently.
+            std::vector<size_t> Offsets(Count);
+            size_t Offset = Headersize;
+
+            for (size_t i = 0; i < Count; ++i)
+            {
+                if (Input.size() - Offset < Chunkheadersize) return std::nullopt;
+
+                const auto Stored = size_t(Read32(Input.data() + Offset) & ~LZ4::Frame::Storedflag);
+                const auto Rawsize = size_t(Read32(Input.data() + Offset + 4));
+                if (Rawsize != std::min<size_t>(Chunksize, Size - i * Chunksize)) return std::nullopt;
+                if (Input.size() - Offset - Chunkheadersize < Stored) return std::nullopt;
+
+                Offsets[i] = Offset;
+                Offset += Chunkheadersize + Stored;
+            }
+            if (Offset != Input.size()) return std::nullopt;
+
+            const auto IV = Cipher ? Cipher->State : std::array<uint8_t, 16>{};
+            Blob_t Output(Size, 0);
+            std::atomic<bool> Failed{};
+
+            Forchunks(Count, Scheduler, [&](size_t Index)
+            {
+                const auto Header = Input.data() + Offsets[Index];
+                const auto Sizefield = Read32(Header);
+                const auto Body = std::span(Header + Chunkheadersize, size_t(Sizefield & ~LZ4::Frame::Storedflag));
+                const auto Target = std::span(Output.data() + Index * Chunksize, size_t(Read32(Header + 4)));
+
+                if (Hash::WW64(Body) != Read64(Header + 8)) { Failed.store(true, std::memory_order_relaxed); return; }
+
+                if (Sizefield & LZ4::Frame::Storedflag)
+                {
+                    if (Body.size() != Target.size()) { Failed.store(true, std::memory_order_relaxed); return; }
+
+                    if (Cipher) Chunkcipher(*Cipher, IV, Index).Decrypt(Body, Target.data());
+                    else std::memcpy(Target.data(), Body.data(), Body.size());
+                    return;
+                }
+
+                // Decrypt next to the output so the compressed bytes stay in cache for the decompressor.
+                std::span<const uint8_t> Compressed = Body;
+                thread_local Blob_t Scratch{};
+                if (Cipher)
+                {
+                    Scratch.resize(Body.size());
+                    Chunkcipher(*Cipher, IV, Index).Decrypt(Body, Scratch.data());
+                    Compressed = Scratch;
+                }
+
+                if (!LZ4::Decompress(Compressed, Target)) Failed.store(true, std::memory_order_relaxed);
+            });
+
+            if (Failed.load()) return std::nullopt;
+            return Output;
+        }
+    }
+
+    // The cipher's current IV is the base nonce, so never reuse one for two payloads with the same key.
+    [[nodiscard]] inline Blob_t Encode(std::span<const uint8_t> Input, Scheduler_t &Scheduler = Scheduler_t::Default())
+    {
+        return Internal::Encode(Input, nullptr, Scheduler);
+    }
+    [[nodiscard]] inline Blob_t Encode(std::span<const uint8_t> Input, const Cipher_t &Cipher, Scheduler_t &Scheduler = Scheduler_t::Default())
+    {
+        return Internal::Encode(Input, &Cipher, Scheduler);
+    }
+
+    // Nullopt if the payload is truncated, fails a checksum or doesn't decompress.
+    [[nodiscard]] inline std::optional<Blob_t> Decode(std::span<const uint8_t> Input, Scheduler_t &Scheduler = Scheduler_t::Default())
+    {
+        return Internal::Decode(Input, nullptr, Scheduler);
+    }
+    [[nodiscard]] inline std::optional<Blob_t> Decode(std::span<const uint8_t> Input, const Cipher_t &Cipher, Scheduler_t &Scheduler = Scheduler_t::Default())
+    {
+        return Internal::Decode(Input, &Cipher, Scheduler);
+    }
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Pipelinetest()
+    {
+        Scheduler_t Pool(2);
+
+        // Compressible text with a random tail, long enough to go parallel.
+        Blob_t Input{};
+        for (size_t i = 0; i < 600000; ++i) Input.push_back(uint8_t('a' + (i % 7) + ((i / 1000) % 5)));
+        for (uint64_t i = 0, State = 7; i < 70000; ++i) { State = State * 6364136223846793005ULL + 1442695040888963407ULL; Input.push_back(uint8_t(State >> 56)); }
+
+        const Pipeline::Cipher_t Cipher({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 }, { 0xA0, 0xA1 });
+        const Pipeline::Cipher_t Othercipher({ 2 }, { 0xA0, 0xA1 });
+
+        const auto Plain = Pipeline::Encode(Input, Pool);
+        const auto Encrypted = Pipeline::Encode(Input, Cipher, Pool);
+        if (Plain.size() >= Input.size() / 2 || Encrypted.size() != Plain.size()) std::printf("BROKEN: Pipeline ratio\n");
+
+        if (Pipeline::Decode(Plain, Pool) != Input || Pipeline::Decode(Encrypted, Cipher, Pool) != Input) std::printf("BROKEN: Pipeline roundtrip\n");
+
+        // The wrong key decrypts to garbage that must not decompress into something plausible.
+        if (const auto Wrong = Pipeline::Decode(Encrypted, Othercipher, Pool); Wrong && *Wrong == Input) std::printf("BROKEN: Pipeline wrong key\n");
+
+        auto Corrupt = Encrypted;
+        Corrupt[Corrupt.size() / 2] ^= 0x10;
+        if (Pipeline::Decode(Corrupt, Cipher, Pool) || Pipeline::Decode(std::span(Encrypted).first(Encrypted.size() - 1), Cipher, Pool) || Pipeline::Decode(Encrypted, Pool))
+            std::printf("BROKEN: Pipeline validation\n");
+
+        if (Pipeline::Decode(Pipeline::Encode({}, Pool), Pool) != Blob_t{}) std::printf("BROKEN: Pipeline empty\n");
+
+        // A bare header claiming four billion chunks must be rejected before anything is allocated for them.
+        Blob_t Header(Plain.begin(), Plain.begin() + 20);
+        const uint64_t Claimed = 0xFFFFFFFFULL * (64 * 1024);
+        for (size_t i = 0; i < 4; ++i) Header[8 + i] = 0xFF;
+        for (size_t i = 0; i < 8; ++i) Header[12 + i] = uint8_t(Claimed >> (i * 8));
+        if (Pipeline::Decode(Header, Pool)) std::printf("BROKEN: Pipeline chunk count\n");
+    }
+}
+#endif
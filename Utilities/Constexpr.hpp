@@ -10,6 +10,7 @@
 #include "Constexpr/Math.hpp"
 #include "Constexpr/Memory.hpp"
 #include "Constexpr/Metaprogramming.hpp"
+#include "Constexpr/Perfectmap.hpp"
 
 // Lookups do not work properly in MSVC, copy this into each module that needs it.
 template <typename T, size_t N, size_t M> constexpr auto operator+(const std::array<T, N> &Left, const std::array<T, M> &Right)
@@ -42,21 +42,21 @@ namespace cmp
     // Struct to create an overload set for use with std::visit and similar functions.
     template<class... Types> struct Overload : Types... { using Types::operator()...; };
 
-    // For serialization, call a visitor with each property of a struct.
-    decltype(auto) Visitmembers(const auto &Object, const auto &Visitor)
+    // For serialization, call a visitor with each property of a struct, const-ness follows the object.
+    decltype(auto) Visitmembers(auto &&Object, const auto &Visitor)
     {
         using Type = std::remove_cvref_t<decltype(Object)>;
 
-             if constexpr (requires { [](Type &This) { const auto &[a1] = This; }; }) { const auto &[a1] = Object; return Visitor(a1); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2] = This; }; }) { const auto &[a1, a2] = Object; return Visitor(a1, a2); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3] = This; }; }) { const auto &[a1, a2, a3] = Object; return Visitor(a1, a2, a3); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4] = This; }; }) { const auto &[a1, a2, a3, a4] = Object; return Visitor(a1, a2, a3, a4); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5] = This; }; }) { const auto &[a1, a2, a3, a4, a5] = Object; return Visitor(a1, a2, a3, a4, a5); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5, a6] = This; }; }) { const auto &[a1, a2, a3, a4, a5, a6] = Object; return Visitor(a1, a2, a3, a4, a5, a6); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5, a6, a7] = This; }; }) { const auto &[a1, a2, a3, a4, a5, a6, a7] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8] = This; }; }) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9] = This; }; }) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8, a9); }
-        else if constexpr (requires { [](Type &This) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = This; }; }) { const auto &[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10); }
+             if constexpr (requires { [](Type &This) { auto &&[a1] = This; }; }) { auto &&[a1] = Object; return Visitor(a1); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2] = This; }; }) { auto &&[a1, a2] = Object; return Visitor(a1, a2); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3] = This; }; }) { auto &&[a1, a2, a3] = Object; return Visitor(a1, a2, a3); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4] = This; }; }) { auto &&[a1, a2, a3, a4] = Object; return Visitor(a1, a2, a3, a4); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5] = This; }; }) { auto &&[a1, a2, a3, a4, a5] = Object; return Visitor(a1, a2, a3, a4, a5); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5, a6] = This; }; }) { auto &&[a1, a2, a3, a4, a5, a6] = Object; return Visitor(a1, a2, a3, a4, a5, a6); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5, a6, a7] = This; }; }) { auto &&[a1, a2, a3, a4, a5, a6, a7] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8] = This; }; }) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8, a9] = This; }; }) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8, a9] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8, a9); }
+        else if constexpr (requires { [](Type &This) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = This; }; }) { auto &&[a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = Object; return Visitor(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10); }
 
         else
         {
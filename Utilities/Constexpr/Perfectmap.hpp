@@ -0,0 +1,281 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Minimal perfect hash for tables known at compile-time, built by makePerfectmap() in a consteval context.
+    Keys are bucketed and every bucket gets a pilot that moves its keys into free slots (PTHash / CHD style),
+    so a lookup is one hash, one probe and one compare.
+*/
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace cmp
+{
+    namespace Perfecthash
+    {
+        // Not constexpr, so reaching it while building a table fails the build with the message in the diagnostic.
+        inline void Error(const char *) {}
+
+        constexpr uint64_t Mix(uint64_t Value) noexcept
+        {
+            Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+            return Value ^ (Value >> 31);
+        }
+
+        // Eight bytes at a time, same result at compile-time and runtime.
+        template <typename C> constexpr uint64_t Hashstring(std::basic_string_view<C> Input, uint64_t Seed) noexcept
+        {
+            constexpr size_t Perword = 8 / sizeof(C);
+            const auto Wordcount = Input.size() / Perword;
+            auto Hash = Seed ^ (uint64_t(Input.size()) * 0x9E3779B97F4A7C15ULL);
+
+            const auto Load = [&](size_t Offset, size_t Count)
+            {
+                uint64_t Word{};
+
+                if (!std::is_constant_evaluated() && std::endian::native == std::endian::little && Count == Perword)
+                    std::memcpy(&Word, Input.data() + Offset, sizeof(Word));
+                else
+                    for (size_t i = 0; i < Count; ++i)
+                        Word |= uint64_t(std::make_unsigned_t<C>(Input[Offset + i])) << (i * 8 * sizeof(C));
+
+                return Word;
+            };
+
+            for (size_t i = 0; i < Wordcount; ++i)
+            {
+                Hash = (Hash ^ Load(i * Perword, Perword)) * 0x9E3779B97F4A7C15ULL;
+                Hash ^= Hash >> 32;
+            }
+            if (const auto Tail = Input.size() % Perword) Hash = (Hash ^ Load(Wordcount * Perword, Tail)) * 0x9E3779B97F4A7C15ULL;
+
+            return Mix(Hash);
+        }
+
+        template <typename T> constexpr uint64_t Hashkey(const T &Key, uint64_t Seed) noexcept
+        {
+            if constexpr (std::is_convertible_v<const T &, std::string_view>) return Hashstring(std::string_view(Key), Seed);
+            else if constexpr (std::is_convertible_v<const T &, std::u8string_view>) return Hashstring(std::u8string_view(Key), Seed);
+            else if constexpr (std::is_convertible_v<const T &, std::wstring_view>) return Hashstring(std::wstring_view(Key), Seed);
+            else
+            {
+                static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Perfectmap keys must be strings or integers.");
+                return Mix(uint64_t(Key) ^ Seed);
+            }
+        }
+    }
+
+    template <typename Key, typename Value, size_t N> requires (N > 0)
+    struct Perfectmap
+    {
+        // Two keys per bucket on average keeps the pilot search short without costing much space.
+        static constexpr size_t Buckets = (N + 1) / 2;
+
+        std::array<std::pair<Key, Value>, N> Entries{};
+        std::array<uint64_t, Buckets> Pilots{};
+        uint64_t Seed{};
+
+        static constexpr size_t Bucketof(uint64_t Hash) noexcept { return size_t((Hash >> 32) % Buckets); }
+        // Remixed so that every pilot moves all bits of the hash, a plain XOR can't change the residue for power-of-two N.
+        static constexpr size_t Slotof(uint64_t Hash, uint64_t Pilot) noexcept { return size_t(Perfecthash::Mix(Hash ^ Pilot) % N); }
+
+        [[nodiscard]] constexpr const Value *find(const Key &Item) const noexcept
+        {
+            const auto Hash = Perfecthash::Hashkey(Item, Seed);
+            const auto &Entry = Entries[Slotof(Hash, Pilots[Bucketof(Hash)])];
+            return Entry.first == Item ? &Entry.second : nullptr;
+        }
+        [[nodiscard]] constexpr bool contains(const Key &Item) const noexcept { return find(Item) != nullptr; }
+        [[nodiscard]] constexpr Value value_or(const Key &Item, const Value &Default) const noexcept
+        {
+            const auto Result = find(Item);
+            return Result ? *Result : Default;
+        }
+
+        [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+        [[nodiscard]] constexpr auto begin() const noexcept { return Entries.begin(); }
+        [[nodiscard]] constexpr auto end() const noexcept { return Entries.end(); }
+    };
+
+    namespace Perfecthash
+    {
+        template <typename Key, typename Value, size_t N, typename Items_t>
+        consteval Perfectmap<Key, Value, N> Build(const Items_t &Items)
+        {
+            using Map_t = Perfectmap<Key, Value, N>;
+            Map_t Result{};
+
+            // A single key needs about N / free-slots tries, so this only fails when the seed is bad rather than unlucky.
+            constexpr uint64_t Pilotlimit = std::max<uint64_t>(1024, 32 * N);
+
+            for (uint64_t Attempt = 0; Attempt < 64; ++Attempt)
+            {
+                Result.Seed = Perfecthash::Mix(0x5851F42D4C957F2DULL + Attempt);
+
+                std::array<uint64_t, N> Hashes{};
+                for (size_t i = 0; i < N; ++i) Hashes[i] = Perfecthash::Hashkey(Items[i].first, Result.Seed);
+
+                // Equal hashes can never be separated, either a duplicate key or a (very) unlucky seed.
+                auto Sorted = Hashes;
+                std::ranges::sort(Sorted);
+                if (std::ranges::adjacent_find(Sorted) != Sorted.end())
+                {
+                    for (size_t i = 0; i < N; ++i)
+                        for (size_t c = i + 1; c < N; ++c)
+                            if (Items[i].first == Items[c].first) Perfecthash::Error("Perfectmap: duplicate key");
+                    continue;
+                }
+
+                // Group the keys by bucket, counting sort.
+                std::array<size_t, Map_t::Buckets + 1> Offsets{};
+                std::array<size_t, N> Members{};
+                for (size_t i = 0; i < N; ++i) Offsets[Map_t::Bucketof(Hashes[i]) + 1]++;
+                for (size_t b = 0; b < Map_t::Buckets; ++b) Offsets[b + 1] += Offsets[b];
+
+                auto Cursor = Offsets;
+                for (size_t i = 0; i < N; ++i) Members[Cursor[Map_t::Bucketof(Hashes[i])]++] = i;
+
+                // Largest buckets first while the table is still mostly empty.
+                std::array<size_t, Map_t::Buckets> Order{};
+                for (size_t b = 0; b < Map_t::Buckets; ++b) Order[b] = b;
+                std::ranges::sort(Order, [&](size_t A, size_t B)
+                {
+                    const auto Left = Offsets[A + 1] - Offsets[A], Right = Offsets[B + 1] - Offsets[B];
+                    return Left != Right ? Left > Right : A < B;
+                });
+
+                std::array<bool, N> Taken{};
+                std::array<size_t, N> Placement{};
+                bool Failed{};
+
+                for (const auto Bucket : Order)
+                {
+                    const auto First = Offsets[Bucket], Last = Offsets[Bucket + 1];
+                    if (First == Last) continue;
+
+                    bool Placed{};
+                    for (uint64_t Pilot = 0; Pilot < Pilotlimit && !Placed; ++Pilot)
+                    {
+                        Placed = true;
+                        for (size_t m = First; m < Last && Placed; ++m)
+                        {
+                            const auto Slot = Map_t::Slotof(Hashes[Members[m]], Pilot);
+                            if (Taken[Slot]) { Placed = false; break; }
+
+                            // Keys within the bucket must not collide with each other either.
+                            for (size_t o = First; o < m; ++o)
+                                if (Placement[Members[o]] == Slot) { Placed = false; break; }
+
+                            Placement[Members[m]] = Slot;
+                        }
+
+                        if (Placed)
+                        {
+                            Result.Pilots[Bucket] = Pilot;
+                            for (size_t m = First; m < Last; ++m) Taken[Placement[Members[m]]] = true;
+                        }
+                    }
+
+                    if (!Placed) { Failed = true; break; }
+                }
+                if (Failed) continue;
+
+                for (size_t i = 0; i < N; ++i) Result.Entries[Placement[i]] = Items[i];
+                return Result;
+            }
+
+            Perfecthash::Error("Perfectmap: no perfect hash found");
+            return Result;
+        }
+    }
+
+    template <typename Key, typename Value, size_t N>
+    consteval Perfectmap<Key, Value, N> makePerfectmap(const std::pair<Key, Value>(&Items)[N])
+    {
+        return Perfecthash::Build<Key, Value, N>(Items);
+    }
+    template <typename Key, typename Value, size_t N>
+    consteval Perfectmap<Key, Value, N> makePerfectmap(const std::array<std::pair<Key, Value>, N> &Items)
+    {
+        return Perfecthash::Build<Key, Value, N>(Items);
+    }
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    namespace Perfectmapkeys
+    {
+        // Pseudo-random lowercase keys of 3-14 characters, the two-letter suffix keeps them unique.
+        template <size_t N> constexpr auto Makestrings()
+        {
+            std::array<std::array<char, 16>, N> Storage{};
+            for (size_t i = 0; i < N; ++i)
+            {
+                const auto Random = cmp::Perfecthash::Mix(i + N);
+                const auto Length = 1 + Random % 12;
+
+                for (size_t c = 0; c < Length; ++c) Storage[i][c] = char('a' + ((Random >> (c * 5)) % 26));
+                Storage[i][Length] = char('a' + i % 26);
+                Storage[i][Length + 1] = char('a' + i / 26);
+            }
+            return Storage;
+        }
+        template <size_t N> constexpr auto Strings = Makestrings<N>();
+
+        template <size_t N> consteval auto Stringmap()
+        {
+            std::array<std::pair<std::string_view, size_t>, N> Items{};
+            for (size_t i = 0; i < N; ++i) Items[i] = { std::string_view(Strings<N>[i].data()), i };
+            return cmp::makePerfectmap(Items);
+        }
+        template <size_t N> consteval auto Integermap()
+        {
+            std::array<std::pair<uint64_t, size_t>, N> Items{};
+            for (size_t i = 0; i < N; ++i) Items[i] = { cmp::Perfecthash::Mix(i * 7919), i };
+            return cmp::makePerfectmap(Items);
+        }
+
+        template <size_t N> constexpr bool Verify()
+        {
+            constexpr auto Stringtable = Stringmap<N>();
+            constexpr auto Integertable = Integermap<N>();
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                const auto String = Stringtable.find(std::string_view(Strings<N>[i].data()));
+                const auto Integer = Integertable.find(cmp::Perfecthash::Mix(i * 7919));
+                if (!String || *String != i || !Integer || *Integer != i) return false;
+            }
+            return !Stringtable.contains("A") && !Integertable.contains(1);
+        }
+    }
+
+    constexpr bool Perfectmaptest = []()
+    {
+        constexpr auto Commands = cmp::makePerfectmap<std::string_view, int>({
+            { "connect", 1 }, { "disconnect", 2 }, { "say", 3 }, { "quit", 4 }, { "map", 5 },
+            { "kick", 6 }, { "ban", 7 }, { "status", 8 }, { "a_rather_long_command_name", 9 }, { "", 10 } });
+
+        static_assert(*Commands.find("connect") == 1 && *Commands.find("a_rather_long_command_name") == 9, "BROKEN: Perfectmap lookup");
+        static_assert(*Commands.find("") == 10 && !Commands.contains("conn") && Commands.value_or("unknown", -1) == -1, "BROKEN: Perfectmap misses");
+
+        constexpr auto Codes = cmp::makePerfectmap<uint32_t, char>({ { 200, 'O' }, { 404, 'N' }, { 500, 'E' } });
+        static_assert(*Codes.find(404) == 'N' && !Codes.contains(403), "BROKEN: Perfectmap integers");
+
+        // Power-of-two sizes are the ones a plain modulo reduction can't separate.
+        static_assert(Perfectmapkeys::Verify<32>() && Perfectmapkeys::Verify<64>() && Perfectmapkeys::Verify<256>(), "BROKEN: Perfectmap larger tables");
+
+        return true;
+    }();
+}
+#endif
@@ -7,8 +7,11 @@
 #pragma once
 #include "Containers/Inlinedvector.hpp"
 #include "Containers/Bytebuffer.hpp"
+#include "Containers/Bytechain.hpp"
 #include "Containers/Protobuffer.hpp"
 #include "Containers/Ringbuffer.hpp"
+#include "Containers/Hashmap.hpp"
+#include "Containers/Mappedfile.hpp"
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
@@ -17,11 +20,11 @@
 #if __has_include(<absl/container/inlined_vector.h>)
 #include <absl/container/inlined_vector.h>
 
-template <typename T, size_t N>
-using Inlinedvector_t = absl::InlinedVector<T, N>;
+template <typename T, size_t N, typename A = std::allocator<T>>
+using Inlinedvector_t = absl::InlinedVector<T, N, A>;
 #else
-template <typename T, size_t N>
-using Inlinedvector_t = Inlinedvector<T, N>;
+template <typename T, size_t N, typename A = std::allocator<T>>
+using Inlinedvector_t = Inlinedvector<T, N, A>;
 #endif
 
 #if __has_include(<absl/container/flat_hash_map.h>)
@@ -33,9 +36,9 @@ template <class K, class V,
 using Hashmap_t = absl::flat_hash_map<K, V, Hash, Eq>;
 #else
 template <class K, class V,
-          class Hash = std::hash<K>,
-          class Eq = std::equal_to<K>>
-using Hashmap_t = std::unordered_map<K, V, Hash, Eq>;
+          class Hash = Flathash::WW64hash_t,
+          class Eq = std::equal_to<>>
+using Hashmap_t = Flatmap_t<K, V, Hash, Eq>;
 #endif
 
 #if __has_include(<absl/container/btree_map.h>)
@@ -59,7 +62,7 @@ template <class T, class Hash = absl::container_internal::hash_default_hash<T>,
           class Eq = absl::container_internal::hash_default_eq<T>>
 using Hashset_t = absl::flat_hash_set<T, Hash, Eq>;
 #else
-template <class T, class Hash = std::hash<T>,
-          class Eq = std::equal_to<T>>
-using Hashset_t = std::unordered_set<T, Hash, Eq>;
+template <class T, class Hash = Flathash::WW64hash_t,
+          class Eq = std::equal_to<>>
+using Hashset_t = Flatset_t<T, Hash, Eq>;
 #endif
@@ -105,9 +105,25 @@ struct Bytebuffer_t
 {
     // Default to owning mode if nothing else is specified..
     std::variant<const uint8_t *, uint8_t *> Internalbuffer{ (uint8_t *)nullptr };
+    uint32_t Internalcapacity{};
     uint32_t Internaliterator{};
     uint32_t Internalsize{};
 
+    // Where owned memory comes from, nullptr for the general heap.
+    std::pmr::memory_resource *Resource{};
+
+    // Owned memory goes through here so buffers can live in an arena or pool.
+    [[nodiscard]] uint8_t *Allocatebuffer(size_t Size) const
+    {
+        if (Resource) return static_cast<uint8_t *>(Resource->allocate(Size, alignof(std::max_align_t)));
+        return static_cast<uint8_t *>(Memory::Malloc(Size));
+    }
+    void Releasebuffer(uint8_t *Buffer, size_t Size) const noexcept
+    {
+        if (Resource) Resource->deallocate(Buffer, Size, alignof(std::max_align_t));
+        else Memory::Free(Buffer);
+    }
+
     // Utility access.
     void Rewind() noexcept
     {
@@ -147,44 +163,50 @@ struct Bytebuffer_t
     }
     void Expandbuffer(size_t Extracapacity)
     {
-        // Need to switch to owning mode.
+        reserve(Internalsize + Extracapacity);
+
+        // Callers expect the new region to be readable.
+        std::memset(std::get<uint8_t *>(Internalbuffer) + Internalsize, 0, Extracapacity);
+        Internalsize += uint32_t(Extracapacity);
+    }
+    void reserve(size_t Capacity)
+    {
+        // Need to switch to owning mode, even if the view is large enough.
         if (!isOwning())
         {
             const auto Originalbuffer = std::get<const uint8_t *>(Internalbuffer);
-            const auto Originalsize = Internalsize;
+            const auto Newcapacity = std::max<size_t>(Capacity, Internalsize);
 
             // Original buffer should never be nullptr, but better safe than sorry..
-            const auto Newbuffer = (uint8_t *)malloc(Originalsize + Extracapacity);
-            if (Originalbuffer) std::memcpy(Newbuffer, Originalbuffer, Originalsize);
-            std::memset(Newbuffer + Originalsize, 0, Extracapacity);
+            const auto Newbuffer = Allocatebuffer(Newcapacity);
+            if (Originalbuffer && Internalsize) std::memcpy(Newbuffer, Originalbuffer, Internalsize);
 
             Internalbuffer = Newbuffer;
-            Internalsize = Originalsize + Extracapacity;
+            Internalcapacity = uint32_t(Newcapacity);
+            return;
         }
 
-        // Else we just alloc/realloc.
+        if (Capacity <= Internalcapacity) return;
+
+        // Contents beyond Internalsize are left uninitialized.
+        const auto Oldbuffer = std::get<uint8_t *>(Internalbuffer);
+        if (!Resource) Internalbuffer = (uint8_t *)Memory::Realloc(Oldbuffer, Capacity);
         else
         {
-            const auto Originalbuffer = std::get<uint8_t *>(Internalbuffer);
-            const auto Originalsize = Internalsize;
-
-            if (Originalbuffer)
-            {
-                const auto Newbuffer = (uint8_t *)realloc(Originalbuffer, Originalsize + Extracapacity);
-                std::memset(Newbuffer + Originalsize, 0, Extracapacity);
-
-                Internalbuffer = Newbuffer;
-                Internalsize = Originalsize + Extracapacity;
-            }
-            else
+            // Resources can't grow in place.
+            const auto Newbuffer = Allocatebuffer(Capacity);
+            if (Oldbuffer)
             {
-                const auto Newbuffer = (uint8_t *)malloc(Originalsize + Extracapacity);
-                std::memset(Newbuffer + Originalsize, 0, Extracapacity);
-
-                Internalbuffer = Newbuffer;
-                Internalsize = Originalsize + Extracapacity;
+                std::memcpy(Newbuffer, Oldbuffer, Internalsize);
+                Releasebuffer(Oldbuffer, Internalcapacity);
             }
+            Internalbuffer = Newbuffer;
         }
+        Internalcapacity = uint32_t(Capacity);
+    }
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return isOwning() ? Internalcapacity : Internalsize;
     }
     [[nodiscard]] size_t size(bool Remainder = false) const noexcept
     {
@@ -219,16 +241,33 @@ struct Bytebuffer_t
     }
     void rawWrite(size_t Size, const void *Buffer = nullptr)
     {
-        // If we were created as non-owning we need to do a realloc regardless.
-        if (!isOwning() || ((Internaliterator + Size) > Internalsize))
-            Expandbuffer((Internaliterator + Size) - Internalsize);
-
         // A null-buffer is just a memset.
-        const auto pBuffer = std::get<uint8_t *>(Internalbuffer) + Internaliterator;
+        const auto pBuffer = rawReserve(Size);
         if (Buffer) std::memcpy(pBuffer, Buffer, Size);
         else std::memset(pBuffer, 0, Size);
+    }
 
-        Internaliterator += Size;
+    // Returns Size writable bytes at the iterator without zeroing them, the caller fills them in.
+    [[nodiscard]] uint8_t *rawReserve(size_t Size)
+    {
+        const auto End = Internaliterator + Size;
+
+        // If we were created as non-owning we need to do a realloc regardless.
+        if (!isOwning() || End > Internalcapacity) [[unlikely]]
+            reserve(std::max<size_t>({ End, size_t(Internalcapacity) * 2, 64 }));
+
+        const auto pBuffer = std::get<uint8_t *>(Internalbuffer) + Internaliterator;
+        Internalsize = uint32_t(std::max<size_t>(Internalsize, End));
+        Internaliterator = uint32_t(End);
+        return pBuffer;
+    }
+
+    // Gives back the tail of a rawReserve() that was never filled in.
+    void Shrink(size_t Unused) noexcept
+    {
+        ASSERT(Unused <= Internalsize);
+        Internalsize -= uint32_t(std::min<size_t>(Unused, Internalsize));
+        Internaliterator = std::min(Internaliterator, Internalsize);
     }
 
     // Typed IO, prefix the type with the ID.
@@ -301,8 +340,10 @@ struct Bytebuffer_t
         {
             if constexpr (std::is_same_v<Type, Blob_t>)
             {
-                // Just a size and a block of bytes..
-                const auto Size = Read<uint32_t>(Typechecked);
+                // Just a size and a block of bytes, a truncated size is a failure rather than an empty blob.
+                uint32_t Size{};
+                if (!Read(Size, Typechecked)) [[unlikely]] return false;
+                if (Size > size(true)) [[unlikely]] return false;
                 Buffer.resize(Size);
 
                 return rawRead(Size, Buffer.data());
@@ -535,12 +576,13 @@ struct Bytebuffer_t
 
     // Construct a owning buffer.
     Bytebuffer_t() = default;
-    explicit Bytebuffer_t(size_t Size)
+    explicit Bytebuffer_t(size_t Size, std::pmr::memory_resource *Allocator = nullptr) : Resource(Allocator)
     {
-        const auto Newbuffer = (uint8_t *)malloc(Size);
+        const auto Newbuffer = Allocatebuffer(Size);
         std::memset(Newbuffer, 0, Size);
 
         Internalbuffer = Newbuffer;
+        Internalcapacity = Size;
         Internaliterator = 0;
         Internalsize = Size;
     }
@@ -551,12 +593,15 @@ struct Bytebuffer_t
         Internalbuffer = Other.data();
         Internalsize = Other.Internalsize;
         Internaliterator = Other.Internaliterator;
+        Resource = Other.Resource;
     }
     Bytebuffer_t(Bytebuffer_t &&Other) noexcept
     {
         Internalbuffer.swap(Other.Internalbuffer);
+        Internalcapacity = std::exchange(Other.Internalcapacity, 0);
         Internaliterator = Other.Internaliterator;
         Internalsize = Other.Internalsize;
+        Resource = Other.Resource;
     }
 
     // Cleanup for owning mode.
@@ -566,12 +611,72 @@ struct Bytebuffer_t
         {
             if (const auto Buffer = std::get<uint8_t *>(Internalbuffer))
             {
-                free(Buffer);
+                Releasebuffer(Buffer, Internalcapacity);
             }
         }
     }
 };
 
+// Read-only cursor over external memory, never allocates or copies.
+struct Bytebuffer_view_t : private Bytebuffer_t
+{
+    using Bytebuffer_t::Rewind;
+    using Bytebuffer_t::Peek;
+    using Bytebuffer_t::Seek;
+    using Bytebuffer_t::size;
+    using Bytebuffer_t::data;
+    using Bytebuffer_t::as_span;
+    using Bytebuffer_t::rawRead;
+    using Bytebuffer_t::Read;
+    using Bytebuffer_t::to_hex;
+    using Bytebuffer_t::to_string;
+
+    // Blobs and strings that point into the underlying memory, valid as long as it is.
+    template <typename T> bool Readview(std::basic_string_view<T> &Buffer, bool Typechecked = true)
+    {
+        constexpr auto ExpectedID = Bytebuffer::toID<std::basic_string_view<T>>();
+
+        if (Typechecked)
+        {
+            if (Peek() != ExpectedID) [[unlikely]] return false;
+            rawRead(sizeof(ExpectedID));
+        }
+
+        if constexpr (std::is_same_v<T, uint8_t>)
+        {
+            uint32_t Size{};
+            if (!Read(Size, Typechecked)) [[unlikely]] return false;
+            if (Size > size(true)) [[unlikely]] return false;
+
+            Buffer = { data(true), Size };
+            return rawRead(Size);
+        }
+        else
+        {
+            // Null-terminated, but don't trust the terminator to exist.
+            const auto Data = (const T *)data(true);
+            const auto Max = size(true) / sizeof(T);
+            if (!Data) [[unlikely]] return false;
+
+            const auto Length = std::find(Data, Data + Max, T{}) - Data;
+            if (size_t(Length) == Max) [[unlikely]] return false;
+
+            Buffer = { Data, size_t(Length) };
+            return rawRead((Length + 1) * sizeof(T));
+        }
+    }
+    template <typename Type> Type Readview(bool Typechecked = true)
+    {
+        Type Result{};
+        Readview(Result, Typechecked);
+        return Result;
+    }
+
+    Bytebuffer_view_t(const void *Buffer, size_t Size) : Bytebuffer_t(Buffer, Size) {}
+    template <cmp::Range_t Range> Bytebuffer_view_t(const Range &Input) : Bytebuffer_t(Input) {}
+    Bytebuffer_view_t(const Bytebuffer_t &Buffer) : Bytebuffer_t(Buffer.data(), Buffer.size()) {}
+};
+
 // Helper to serialize structs until we get reflection..
 namespace Bytebuffer
 {
@@ -587,6 +692,162 @@ namespace Bytebuffer
 
         return Buffer;
     }
+
+    // Schema-compiled layout for fixed structs: a single schema hash, then the fields untagged.
+    // Fixed-size fields are copied at compile-time offsets, strings and vectors are size-prefixed.
+    namespace Compiled
+    {
+        template <typename T> concept Flat_t = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+            (cmp::isDerivedEx<T, std::array> && (std::is_arithmetic_v<typename T::value_type> || std::is_enum_v<typename T::value_type>));
+        template <typename T> concept Dynamic_t = (cmp::isDerived<T, std::basic_string> || cmp::isDerived<T, std::basic_string_view> || cmp::isDerived<T, std::vector>) &&
+            (std::is_arithmetic_v<typename T::value_type> || std::is_enum_v<typename T::value_type>) && !std::is_same_v<typename T::value_type, bool>;
+
+        // Member types without constructing the object.
+        struct Fieldtypes_t { template <typename ...Types> std::tuple<std::remove_cvref_t<Types>...> operator()(const Types &...) const; };
+        template <typename T> using Fields_t = decltype(cmp::Visitmembers(std::declval<const T &>(), Fieldtypes_t{}));
+
+        template <typename T, size_t ...i> consteval size_t getFlatsize(std::index_sequence<i...>)
+        {
+            return ((Flat_t<std::tuple_element_t<i, Fields_t<T>>> ? sizeof(std::tuple_element_t<i, Fields_t<T>>) : 0) + ... + 0);
+        }
+        template <typename T> constexpr size_t Flatsize = getFlatsize<T>(std::make_index_sequence<std::tuple_size_v<Fields_t<T>>>{});
+
+        // FNV1a over each fields type-ID and wire size, so that layout changes are detected.
+        // Size-prefixed fields get a fixed marker, sizeof(std::string) etc. differs between standard libraries and builds.
+        constexpr uint32_t Dynamicmarker = 0xFFFFFFFF;
+        template <typename Type> consteval uint32_t getWiresize()
+        {
+            if constexpr (Flat_t<Type>) return uint32_t(sizeof(Type));
+            else return Dynamicmarker;
+        }
+        template <typename T, size_t ...i> consteval uint32_t getSchemahash(std::index_sequence<i...>)
+        {
+            constexpr std::array<uint32_t, sizeof...(i)> IDs{ toID<std::tuple_element_t<i, Fields_t<T>>>()... };
+            constexpr std::array<uint32_t, sizeof...(i)> Sizes{ getWiresize<std::tuple_element_t<i, Fields_t<T>>>()... };
+            uint32_t Hash = 2166136261UL;
+
+            for (size_t Index = 0; Index < sizeof...(i); ++Index)
+            {
+                for (const auto Value : { IDs[Index], Sizes[Index] })
+                {
+                    for (size_t b = 0; b < 4; ++b) { Hash ^= uint8_t(Value >> (b * 8)); Hash *= 16777619UL; }
+                }
+            }
+
+            return Hash;
+        }
+        template <typename T> constexpr uint32_t Schemahash = getSchemahash<T>(std::make_index_sequence<std::tuple_size_v<Fields_t<T>>>{});
+
+        template <typename T> void Encodeflat(uint8_t *Output, const T &Value)
+        {
+            if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) std::memcpy(Output, &Value, sizeof(T));
+            else if constexpr (std::is_enum_v<T>) Encodeflat(Output, std::to_underlying(Value));
+            else if constexpr (std::is_arithmetic_v<T>) { const auto Temp = cmp::toLittle(Value); std::memcpy(Output, &Temp, sizeof(T)); }
+            else for (size_t i = 0; i < Value.size(); ++i) Encodeflat(Output + i * sizeof(Value[0]), Value[i]);
+        }
+        template <typename T> void Decodeflat(const uint8_t *Input, T &Value)
+        {
+            if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) std::memcpy(&Value, Input, sizeof(T));
+            else if constexpr (std::is_enum_v<T>) { std::underlying_type_t<T> Temp; Decodeflat(Input, Temp); Value = T(Temp); }
+            else if constexpr (std::is_arithmetic_v<T>) { std::memcpy(&Value, Input, sizeof(T)); Value = cmp::fromLittle(Value); }
+            else for (size_t i = 0; i < Value.size(); ++i) Decodeflat(Input + i * sizeof(Value[0]), Value[i]);
+        }
+
+        template <typename T> void Write(Bytebuffer_t &Buffer, const T &Object)
+        {
+            // One reservation for the hash and every fixed-size field.
+            auto Output = Buffer.rawReserve(sizeof(uint32_t) + Flatsize<T>);
+            Encodeflat(Output, Schemahash<T>);
+            Output += sizeof(uint32_t);
+
+            cmp::Visitmembers(Object, [&](const auto &...Items)
+            {
+                const auto Field = [&](const auto &Item)
+                {
+                    using Type = std::remove_cvref_t<decltype(Item)>;
+                    static_assert(Flat_t<Type> || Dynamic_t<Type>, "Compiled schemas only support POD, arrays of POD, strings and vectors of POD.");
+
+                    if constexpr (Flat_t<Type>)
+                    {
+                        Encodeflat(Output, Item);
+                        Output += sizeof(Type);
+                    }
+                };
+                (Field(Items), ...);
+
+                // Variable-length data follows the fixed part.
+                const auto Tail = [&](const auto &Item)
+                {
+                    using Type = std::remove_cvref_t<decltype(Item)>;
+                    if constexpr (Dynamic_t<Type>)
+                    {
+                        using Element_t = typename Type::value_type;
+                        const auto Data = Buffer.rawReserve(sizeof(uint32_t) + Item.size() * sizeof(Element_t));
+
+                        Encodeflat(Data, uint32_t(Item.size()));
+                        for (size_t i = 0; i < Item.size(); ++i) Encodeflat(Data + sizeof(uint32_t) + i * sizeof(Element_t), Item[i]);
+                    }
+                };
+                (Tail(Items), ...);
+            });
+        }
+
+        template <typename T> bool Read(Bytebuffer_t &Buffer, T &Object)
+        {
+            // One bounds-check for the hash and every fixed-size field.
+            const auto Input = Buffer.data(true);
+            if (!Input || Buffer.size(true) < sizeof(uint32_t) + Flatsize<T>) [[unlikely]] return false;
+
+            uint32_t Hash{};
+            Decodeflat(Input, Hash);
+            if (Hash != Schemahash<T>) [[unlikely]] return false;
+
+            return cmp::Visitmembers(Object, [&](auto &...Items)
+            {
+                auto Offset = Input + sizeof(uint32_t);
+                const auto Field = [&](auto &Item)
+                {
+                    using Type = std::remove_cvref_t<decltype(Item)>;
+                    if constexpr (Flat_t<Type>)
+                    {
+                        Decodeflat(Offset, Item);
+                        Offset += sizeof(Type);
+                    }
+                };
+                (Field(Items), ...);
+                Buffer.rawRead(sizeof(uint32_t) + Flatsize<T>);
+
+                const auto Tail = [&](auto &Item) -> bool
+                {
+                    using Type = std::remove_cvref_t<decltype(Item)>;
+                    if constexpr (Dynamic_t<Type>)
+                    {
+                        using Element_t = typename Type::value_type;
+                        static_assert(!cmp::isDerived<Type, std::basic_string_view>, "Can not read into a string view.");
+
+                        uint32_t Count{};
+                        const auto Data = Buffer.data(true);
+                        if (!Data || Buffer.size(true) < sizeof(uint32_t)) [[unlikely]] return false;
+                        Decodeflat(Data, Count);
+
+                        if ((Buffer.size(true) - sizeof(uint32_t)) / sizeof(Element_t) < Count) [[unlikely]] return false;
+                        Item.resize(Count);
+                        for (size_t i = 0; i < Count; ++i) Decodeflat(Data + sizeof(uint32_t) + i * sizeof(Element_t), Item[i]);
+
+                        return Buffer.rawRead(sizeof(uint32_t) + Count * sizeof(Element_t));
+                    }
+                    return true;
+                };
+                return (Tail(Items) && ...);
+            });
+        }
+        template <typename T> T Read(Bytebuffer_t &Buffer)
+        {
+            T Result{};
+            Read(Buffer, Result);
+            return Result;
+        }
+    }
 }
 
 #if defined(ENABLE_UNITTESTS)
@@ -612,6 +873,118 @@ namespace Unittests
         if (2 != Buffer.Read<uint8_t>()) std::printf("BROKEN: Bytebuffer reading\n");
         if (3 != Buffer.Read<uint8_t>(false)) std::printf("BROKEN: Bytebuffer reading\n");
         if ("Hello"s != Buffer.Read<std::string>()) std::printf("BROKEN: Bytebuffer reading\n");
+
+        // Many small writes should only grow geometrically.
+        Bytebuffer_t Growing{};
+        for (uint32_t i = 0; i < 1000; ++i) Growing.Write(i, false);
+        if (Growing.size() != 4000 || Growing.capacity() < Growing.size() || Growing.capacity() > 8192) std::printf("BROKEN: Bytebuffer growth\n");
+
+        // Views point into the buffer rather than copying.
+        Buffer.Seek(0, SEEK_END);
+        Buffer << Blob_t(300, 0xAA);
+
+        Bytebuffer_view_t View(Buffer);
+        View.Seek(15, SEEK_SET);
+        const auto Blob = View.Readview<Blob_view_t>();
+        if (Blob.size() != 300 || Blob.data() < Buffer.data() || Blob.data() >= Buffer.data() + Buffer.size()) std::printf("BROKEN: Bytebuffer view\n");
+
+        View.Seek(8, SEEK_SET);
+        if ("Hello"sv != View.Readview<std::string_view>()) std::printf("BROKEN: Bytebuffer view\n");
+
+        // Growth through a memory resource rather than the heap.
+        Memory::Arena_t Arena(1024);
+        Bytebuffer_t Arenabuffer(0, &Arena);
+        for (uint32_t i = 0; i < 1000; ++i) Arenabuffer.Write(i, false);
+        Arenabuffer.Rewind();
+        if (Arenabuffer.Read<uint32_t>(false) != 0 || Arena.Reserved() < 4000) std::printf("BROKEN: Bytebuffer resource\n");
+
+        // The resource is only ever a trailing argument, so plain sizes stay unambiguous.
+        Bytebuffer_t Sized(0);
+        Sized.Write(uint8_t(1), false);
+        if (Sized.size() != 1) std::printf("BROKEN: Bytebuffer sized\n");
+    }
+
+    inline void Bytebuffercompiledtest()
+    {
+        struct Record_t
+        {
+            uint32_t ID;
+            std::string Name;
+            double Score;
+            std::array<uint16_t, 3> Flags;
+            std::vector<uint64_t> Timestamps;
+            bool Active;
+        };
+        const Record_t Input{ 42, "Hello", 3.5, { 1, 2, 3 }, { 100, 200, 300 }, true };
+
+        // Pinned, so every compiler and standard library agrees on the wire.
+        static_assert(Bytebuffer::Compiled::Schemahash<Record_t> == 0xA6499241, "BROKEN: Compiled Bytebuffer schema hash is not portable");
+
+        Bytebuffer_t Buffer{};
+        Bytebuffer::Compiled::Write(Buffer, Input);
+
+        // Hash + fixed fields + two size-prefixed tails.
+        if (Buffer.size() != 4 + (4 + 8 + 6 + 1) + (4 + 5) + (4 + 24)) std::printf("BROKEN: Compiled Bytebuffer size\n");
+
+        Buffer.Rewind();
+        const auto Output = Bytebuffer::Compiled::Read<Record_t>(Buffer);
+        if (Output.ID != 42 || Output.Name != "Hello" || Output.Score != 3.5 || Output.Flags != Input.Flags || Output.Timestamps != Input.Timestamps || !Output.Active)
+            std::printf("BROKEN: Compiled Bytebuffer reading\n");
+
+        // A different layout must be rejected.
+        struct Other_t { uint32_t ID; std::string Name; };
+        Buffer.Rewind();
+        Other_t Wrong{};
+        if (Bytebuffer::Compiled::Read(Buffer, Wrong)) std::printf("BROKEN: Compiled Bytebuffer schema check\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // A few hundred mixed records, typed and untyped, through the generic and compiled paths.
+    inline void Bytebufferbenchmark()
+    {
+        constexpr size_t Count = 256;
+        const auto Encode = [](bool Typed)
+        {
+            Bytebuffer_t Buffer{};
+            for (uint32_t i = 0; i < Count; ++i)
+            {
+                Buffer.Write(i, Typed);
+                Buffer.Write(uint64_t(i * 0x9E3779B97F4A7C15ULL), Typed);
+                Buffer.Write(double(i) * 0.5, Typed);
+                Buffer.Write("Record name"sv, Typed);
+            }
+            return Buffer;
+        };
+        const auto Decode = [](Bytebuffer_view_t View, bool Typed)
+        {
+            uint64_t Sum{};
+            for (size_t i = 0; i < Count; ++i)
+            {
+                Sum += View.Read<uint32_t>(Typed);
+                Sum += View.Read<uint64_t>(Typed);
+                Sum += uint64_t(View.Read<double>(Typed));
+                Sum += View.Readview<std::string_view>(Typed).size();
+            }
+            return Sum;
+        };
+
+        const auto Typed = Encode(true), Untyped = Encode(false);
+        Measure("Bytebuffer_t encode (typed)", Typed.size(), [&]() { Keep(Encode(true)); });
+        Measure("Bytebuffer_t encode (untyped)", Untyped.size(), [&]() { Keep(Encode(false)); });
+        Measure("Bytebuffer_t decode (typed)", Typed.size(), [&]() { Keep(Decode(Bytebuffer_view_t(Typed), true)); });
+        Measure("Bytebuffer_t decode (untyped)", Untyped.size(), [&]() { Keep(Decode(Bytebuffer_view_t(Untyped), false)); });
+
+        struct Record_t { uint32_t ID; std::string Name; double Score; std::vector<uint64_t> Timestamps; };
+        const Record_t Record{ 42, "Record name", 3.5, { 100, 200, 300, 400 } };
+
+        Bytebuffer_t Compiled{};
+        Bytebuffer::Compiled::Write(Compiled, Record);
+        Measure("Bytebuffer::Compiled::Write", Compiled.size(), [&]() { Bytebuffer_t Buffer{}; Bytebuffer::Compiled::Write(Buffer, Record); Keep(Buffer); });
+        Measure("Bytebuffer::Compiled::Read", Compiled.size(), [&]() { Compiled.Rewind(); Keep(Bytebuffer::Compiled::Read<Record_t>(Compiled)); });
     }
 }
 #endif
@@ -0,0 +1,341 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Segmented Bytebuffer for vectored IO.
+    Small fields are serialized into an owned buffer, large payloads are referenced in-place.
+*/
+
+#pragma once
+#include <Utilities/Utilities.hpp>
+#include "Bytebuffer.hpp"
+
+#if defined(_WIN32)
+using IOVector_t = WSABUF;
+#else
+#include <sys/uio.h>
+using IOVector_t = iovec;
+#endif
+
+struct Bytechain_t
+{
+    // External segments must outlive the chain, owned ones are offsets into Owned as it may reallocate.
+    struct Segment_t
+    {
+        const uint8_t *External;
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    Bytebuffer_t Owned{};
+    std::vector<Segment_t> Segments{};
+    Blob_t Scratch{};
+    size_t Readsegment{}, Readoffset{};
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        size_t Total{};
+        for (const auto &Segment : Segments) Total += Segment.Size;
+        return Total;
+    }
+    [[nodiscard]] std::span<const uint8_t> Segment(size_t Index) const noexcept
+    {
+        const auto &Item = Segments[Index];
+        return { Item.External ? Item.External : Owned.data() + Item.Offset, Item.Size };
+    }
+
+    // The segments in order, for writev / WSASend. Invalidated by further writes.
+    [[nodiscard]] std::vector<IOVector_t> Gather() const
+    {
+        std::vector<IOVector_t> Result;
+        Result.reserve(Segments.size());
+
+        for (size_t i = 0; i < Segments.size(); ++i)
+        {
+            const auto Span = Segment(i);
+
+            #if defined(_WIN32)
+            Result.push_back({ ULONG(Span.size()), (CHAR *)Span.data() });
+            #else
+            Result.push_back({ (void *)Span.data(), Span.size() });
+            #endif
+        }
+
+        return Result;
+    }
+
+    // For transports that need contiguous memory.
+    [[nodiscard]] Bytebuffer_t Flatten() const
+    {
+        Bytebuffer_t Result{};
+        Result.reserve(size());
+
+        for (size_t i = 0; i < Segments.size(); ++i)
+        {
+            const auto Span = Segment(i);
+            Result.rawWrite(Span.size(), Span.data());
+        }
+
+        return Result;
+    }
+
+    // Typed IO into the owned buffer, same layout as Bytebuffer_t.
+    template <typename Type> void Write(const Type &Value, bool Typechecked = true)
+    {
+        const auto Start = Owned.size();
+        Owned.Seek(0, SEEK_END);
+        Owned.Write(Value, Typechecked);
+        Extend(Start, Owned.size() - Start);
+    }
+    void rawWrite(size_t Size, const void *Buffer = nullptr)
+    {
+        const auto Start = Owned.size();
+        Owned.Seek(0, SEEK_END);
+        Owned.rawWrite(Size, Buffer);
+        Extend(Start, Size);
+    }
+
+    // Reference the payload rather than copying it, reads back as a Blob_t.
+    void Attach(Blob_view_t Payload, bool Typechecked = true)
+    {
+        constexpr auto TypeID = Bytebuffer::BB_BLOB;
+        if (Typechecked) rawWrite(sizeof(TypeID), &TypeID);
+        Write<uint32_t>(uint32_t(Payload.size()), Typechecked);
+        rawAttach(Payload);
+    }
+    void rawAttach(Blob_view_t Payload)
+    {
+        if (!Payload.empty()) Segments.push_back({ Payload.data(), 0, uint32_t(Payload.size()) });
+    }
+
+    // Copies across segments as needed.
+    bool rawRead(size_t Size, void *Buffer = nullptr)
+    {
+        if (Size > size(true)) [[unlikely]] return false;
+        auto Output = (uint8_t *)Buffer;
+
+        while (Size)
+        {
+            const auto Span = Segment(Readsegment).subspan(Readoffset);
+            const auto Count = std::min(Size, Span.size());
+
+            if (Output) { std::memcpy(Output, Span.data(), Count); Output += Count; }
+            Advance(Count);
+            Size -= Count;
+        }
+
+        return true;
+    }
+
+    // Values that straddle a segment boundary are copied to scratch first, only the bytes they need.
+    template <typename Type> bool Read(Type &Buffer, bool Typechecked = true)
+    {
+        const auto Needed = Pendingsize<Type>(Typechecked);
+        if (!Needed || *Needed > size(true)) [[unlikely]] return false;
+
+        auto Span = Segment(Readsegment).subspan(Readoffset);
+        if (Span.size() < *Needed)
+        {
+            Scratch.resize(*Needed);
+            Peek(0, *Needed, Scratch.data());
+            Span = Scratch;
+        }
+
+        Bytebuffer_view_t View(Span.data(), *Needed);
+        if (!View.Read(Buffer, Typechecked)) [[unlikely]] return false;
+
+        Advance(*Needed - View.size(true));
+        return true;
+    }
+    template <typename Type> Type Read(bool Typechecked = true)
+    {
+        Type Result{};
+        Read(Result, Typechecked);
+        return Result;
+    }
+    [[nodiscard]] size_t size(bool Remainder) const noexcept
+    {
+        if (!Remainder) return size();
+
+        size_t Total{};
+        for (size_t i = Readsegment; i < Segments.size(); ++i) Total += Segments[i].Size;
+        return Total - Readoffset;
+    }
+    void Rewind() noexcept
+    {
+        Readsegment = 0;
+        Readoffset = 0;
+    }
+
+    // Helper for reading and writing.
+    template <typename Type> Bytechain_t &operator<<(const Type &Value)
+    {
+        if constexpr (std::is_same_v<Type, Blob_view_t>) Attach(Value);
+        else Write(Value);
+        return *this;
+    }
+    template <cmp::Char_t T, size_t N> Bytechain_t &operator<<(const T(&Input)[N])
+    {
+        Write(std::basic_string_view<T>(Input));
+        return *this;
+    }
+    template <typename Type> void operator>>(Type &Buffer)
+    {
+        Read(Buffer);
+    }
+
+    Bytechain_t() = default;
+    Bytechain_t(Bytechain_t &&) noexcept = default;
+
+    // Received data, already segmented.
+    explicit Bytechain_t(std::span<const Blob_view_t> Input)
+    {
+        for (const auto &Item : Input) rawAttach(Item);
+    }
+
+private:
+    void Extend(size_t Offset, size_t Size)
+    {
+        if (Size == 0) return;
+
+        // Consecutive writes share a segment.
+        if (!Segments.empty() && !Segments.back().External && Segments.back().Offset + Segments.back().Size == Offset)
+            Segments.back().Size += uint32_t(Size);
+        else
+            Segments.push_back({ nullptr, uint32_t(Offset), uint32_t(Size) });
+    }
+    void Advance(size_t Count)
+    {
+        Readoffset += Count;
+        while (Readsegment < Segments.size() && Readoffset >= Segments[Readsegment].Size)
+        {
+            Readoffset -= Segments[Readsegment].Size;
+            ++Readsegment;
+        }
+    }
+
+    // Calls Callback(Byte) for the unread bytes in order until it returns false.
+    template <typename F> void Forbytes(F &&Callback) const
+    {
+        for (size_t i = Readsegment, Skip = Readoffset; i < Segments.size(); ++i, Skip = 0)
+        {
+            for (const auto Byte : Segment(i).subspan(Skip))
+                if (!Callback(Byte)) return;
+        }
+    }
+
+    // Copies without consuming, false if the chain is too short.
+    bool Peek(size_t Offset, size_t Size, void *Output) const
+    {
+        auto Cursor = (uint8_t *)Output;
+        Offset += Readoffset;
+
+        for (size_t i = Readsegment; i < Segments.size() && Size; ++i)
+        {
+            const auto Span = Segment(i);
+            if (Offset >= Span.size()) { Offset -= Span.size(); continue; }
+
+            const auto Count = std::min(Size, Span.size() - Offset);
+            std::memcpy(Cursor, Span.data() + Offset, Count);
+            Cursor += Count; Size -= Count;
+            Offset = 0;
+        }
+
+        return Size == 0;
+    }
+
+    // Bytes the next value occupies on the wire, same layout as Bytebuffer_t::Read. Mismatched types fail here without copying.
+    template <typename Type> std::optional<size_t> Pendingsize(bool Typechecked) const
+    {
+        constexpr auto ExpectedID = Bytebuffer::toID<Type>();
+        size_t Prefix{};
+
+        if (Typechecked || ExpectedID > Bytebuffer::BB_ARRAY)
+        {
+            uint8_t StoredID{};
+            if (!Peek(0, sizeof(StoredID), &StoredID)) return std::nullopt;
+            if (StoredID == Bytebuffer::BB_NONE) return sizeof(StoredID);
+            if (StoredID != ExpectedID) return std::nullopt;
+            Prefix = sizeof(StoredID);
+        }
+
+        // Typed size, untyped count, then the elements.
+        if constexpr (cmp::isDerived<Type, std::vector>)
+        {
+            uint32_t Size{};
+            if (!Peek(Prefix + 1, sizeof(Size), &Size)) return std::nullopt;
+            return Prefix + 1 + sizeof(Size) + sizeof(uint32_t) + cmp::fromLittle(Size);
+        }
+        else if constexpr (std::is_same_v<Type, Blob_t>)
+        {
+            const size_t Header = (Typechecked ? 1 : 0) + sizeof(uint32_t);
+            uint32_t Size{};
+            if (!Peek(Prefix + Header - sizeof(Size), sizeof(Size), &Size)) return std::nullopt;
+            return Prefix + Header + cmp::fromLittle(Size);
+        }
+        else if constexpr (cmp::isDerived<Type, std::basic_string>)
+        {
+            using Char_t = typename Type::value_type;
+            std::optional<size_t> Result{};
+            size_t Position{}, Filled{};
+            Char_t Item{};
+
+            Forbytes([&](uint8_t Byte)
+            {
+                if (Position++ < Prefix) return true;
+
+                std::memcpy((uint8_t *)&Item + Filled, &Byte, 1);
+                if (++Filled < sizeof(Char_t)) return true;
+
+                Filled = 0;
+                if (Item != Char_t{}) return true;
+
+                Result = Position;
+                return false;
+            });
+
+            return Result;
+        }
+        else return Prefix + sizeof(Type);
+    }
+};
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Bytechaintest()
+    {
+        const Blob_t Payload(4096, 0x5A);
+        Bytechain_t Chain{};
+        Bytebuffer_t Reference{};
+
+        Chain << uint32_t(0x2A) << Blob_view_t(Payload) << "Hello";
+        Reference << uint32_t(0x2A) << Payload << "Hello";
+
+        // The payload is referenced, not copied.
+        const auto Vectors = Chain.Gather();
+        if (Vectors.size() != 3 || Chain.Segment(1).data() != Payload.data()) std::printf("BROKEN: Bytechain gather\n");
+
+        const auto Flat = Chain.Flatten();
+        if (Flat.as_span().size() != Reference.size() || std::memcmp(Flat.data(), Reference.data(), Reference.size()))
+            std::printf("BROKEN: Bytechain layout\n");
+
+        // Tiny segments so that every value straddles a boundary.
+        std::vector<Blob_view_t> Pieces;
+        for (size_t i = 0; i < Reference.size(); i += 3) Pieces.emplace_back(Reference.data() + i, std::min<size_t>(3, Reference.size() - i));
+
+        Bytechain_t Reader(Pieces);
+        if (0x2A != Reader.Read<uint32_t>()) std::printf("BROKEN: Bytechain reading\n");
+        if (Payload != Reader.Read<Blob_t>()) std::printf("BROKEN: Bytechain reading\n");
+        if ("Hello"s != Reader.Read<std::string>()) std::printf("BROKEN: Bytechain reading\n");
+        if (Reader.size(true) != 0) std::printf("BROKEN: Bytechain reading\n");
+
+        // A mismatched type is rejected without consuming anything, and a straddling read doesn't grow the chain.
+        Reader.Rewind();
+        const auto Segmentcount = Reader.Segments.size();
+        if (Reader.Read<uint64_t>() != 0 || Reader.Read<uint32_t>() != 0x2A || Reader.Segments.size() != Segmentcount || Reader.Scratch.size() > sizeof(uint64_t))
+            std::printf("BROKEN: Bytechain scratch\n");
+    }
+}
+#endif
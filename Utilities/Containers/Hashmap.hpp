@@ -0,0 +1,475 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Open-addressing hash table in the style of SwissTable, used when abseil isn't available.
+    One control byte per slot holds 7 bits of the hash so that a group of 16 is probed with a single compare.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "../Crypto/Checksums.hpp"
+
+namespace Flathash
+{
+    // Transparent, so Hashmap_t<std::string, T> can be queried with a string_view or literal.
+    struct WW64hash_t
+    {
+        using is_transparent = void;
+
+        template <typename C> static size_t Hashstring(std::basic_string_view<C> Key) noexcept
+        {
+            return size_t(Hash::Checksums::WW64({ reinterpret_cast<const uint8_t *>(Key.data()), Key.size() * sizeof(C) }));
+        }
+
+        template <typename T> size_t operator()(const T &Key) const noexcept
+        {
+            if constexpr (std::is_convertible_v<const T &, std::string_view>) return Hashstring(std::string_view(Key));
+            else if constexpr (std::is_convertible_v<const T &, std::u8string_view>) return Hashstring(std::u8string_view(Key));
+            else if constexpr (std::is_convertible_v<const T &, std::wstring_view>) return Hashstring(std::wstring_view(Key));
+            else if constexpr (std::is_convertible_v<const T &, std::u16string_view>) return Hashstring(std::u16string_view(Key));
+            else if constexpr (std::is_convertible_v<const T &, std::u32string_view>) return Hashstring(std::u32string_view(Key));
+            else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+            {
+                // Widened so that mixed integer lookups agree.
+                const auto Wide = uint64_t(Key);
+                return size_t(Hash::Checksums::WW64({ reinterpret_cast<const uint8_t *>(&Wide), sizeof(Wide) }));
+            }
+            else if constexpr (std::has_unique_object_representations_v<T>)
+                return size_t(Hash::Checksums::WW64({ reinterpret_cast<const uint8_t *>(&Key), sizeof(T) }));
+            else
+            {
+                // std::hash is the identity for most types, so spread it out over the control bits.
+                auto Value = uint64_t(std::hash<T>{}(Key));
+                Value = (Value ^ (Value >> 33)) * 0xFF51AFD7ED558CCDULL;
+                Value = (Value ^ (Value >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+                return size_t(Value ^ (Value >> 33));
+            }
+        }
+    };
+
+    namespace Internal
+    {
+        // Full slots store the low 7 bits of the hash, free ones have the top bit set.
+        constexpr int8_t Empty = int8_t(0x80), Deleted = int8_t(0xFE);
+        constexpr size_t Groupwidth = 16;
+
+        struct Group_t
+        {
+            #if defined (HAS_CPUID)
+            __m128i Control;
+
+            explicit Group_t(const int8_t *Pointer) noexcept : Control(_mm_load_si128(reinterpret_cast<const __m128i *>(Pointer))) {}
+
+            uint32_t Match(int8_t Tag) const noexcept { return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(Control, _mm_set1_epi8(Tag)))); }
+            uint32_t Matchempty() const noexcept { return Match(Empty); }
+            uint32_t Matchfree() const noexcept { return uint32_t(_mm_movemask_epi8(Control)); }
+            #else
+            std::array<int8_t, Groupwidth> Control;
+
+            explicit Group_t(const int8_t *Pointer) noexcept { std::memcpy(Control.data(), Pointer, Groupwidth); }
+
+            uint32_t Match(int8_t Tag) const noexcept
+            {
+                uint32_t Mask{};
+                for (size_t i = 0; i < Groupwidth; ++i) Mask |= uint32_t(Control[i] == Tag) << i;
+                return Mask;
+            }
+            uint32_t Matchempty() const noexcept { return Match(Empty); }
+            uint32_t Matchfree() const noexcept
+            {
+                uint32_t Mask{};
+                for (size_t i = 0; i < Groupwidth; ++i) Mask |= uint32_t(Control[i] < 0) << i;
+                return Mask;
+            }
+            #endif
+        };
+
+        // Shared empty group so that lookups in a default-constructed table need no branch.
+        alignas(Groupwidth) inline constexpr std::array<int8_t, Groupwidth> Emptygroup{ Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+                                                                                        Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty };
+    }
+
+    // Set when V is void, map of std::pair<K, V> otherwise. Keys must not be modified through iterators.
+    template <typename K, typename V, typename Hasher, typename Equal>
+    struct Table_t
+    {
+        static constexpr bool isSet = std::is_void_v<V>;
+        static constexpr bool isTransparent = requires { typename Hasher::is_transparent; typename Equal::is_transparent; };
+
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::conditional_t<isSet, K, std::pair<K, std::conditional_t<isSet, int, V>>>;
+        using size_type = size_t;
+
+    private:
+        static constexpr size_t Alignment = std::max(Internal::Groupwidth, alignof(value_type));
+        static constexpr size_t Slotoffset(size_t Capacity) noexcept { return (Capacity + alignof(value_type) - 1) & ~(alignof(value_type) - 1); }
+        static constexpr size_t Allocationsize(size_t Capacity) noexcept { return Slotoffset(Capacity) + Capacity * sizeof(value_type); }
+
+        int8_t *Control{ const_cast<int8_t *>(Internal::Emptygroup.data()) };
+        value_type *Slots{};
+        size_t Capacity{}, Count{}, Growthleft{};
+        [[no_unique_address]] Hasher Hashfunction{};
+        [[no_unique_address]] Equal Keyequal{};
+
+        static const K &Keyof(const value_type &Slot) noexcept
+        {
+            if constexpr (isSet) return Slot;
+            else return Slot.first;
+        }
+
+        // Triangular probing over groups visits every group once for power-of-two counts.
+        struct Probe_t
+        {
+            size_t Mask, Group, Step{};
+
+            size_t Offset() const noexcept { return Group * Internal::Groupwidth; }
+            void Next() noexcept { Group = (Group + ++Step) & Mask; }
+        };
+        Probe_t Startprobe(size_t Hash) const noexcept
+        {
+            const auto Mask = Capacity / Internal::Groupwidth - 1;
+            return { Mask, (Hash >> 7) & Mask };
+        }
+        static int8_t Tagof(size_t Hash) noexcept { return int8_t(Hash & 0x7F); }
+
+        void Setcontrol(size_t Index, int8_t Tag) noexcept { Control[Index] = Tag; }
+
+        template <typename Q> size_t Findindex(const Q &Key, size_t Hash) const noexcept
+        {
+            if (Capacity == 0) [[unlikely]] return Capacity;
+
+            for (auto Probe = Startprobe(Hash); ; Probe.Next())
+            {
+                const Internal::Group_t Group(Control + Probe.Offset());
+
+                for (auto Matches = Group.Match(Tagof(Hash)); Matches; Matches &= Matches - 1)
+                {
+                    const auto Index = Probe.Offset() + std::countr_zero(Matches);
+                    if (Keyequal(Keyof(Slots[Index]), Key)) [[likely]] return Index;
+                }
+
+                if (Group.Matchempty()) return Capacity;
+            }
+        }
+
+        // First empty or deleted slot along the probe sequence.
+        size_t Findfree(size_t Hash) const noexcept
+        {
+            for (auto Probe = Startprobe(Hash); ; Probe.Next())
+            {
+                if (const auto Free = Internal::Group_t(Control + Probe.Offset()).Matchfree())
+                    return Probe.Offset() + std::countr_zero(Free);
+            }
+        }
+
+        void Allocate(size_t Newcapacity)
+        {
+            const auto Memory = static_cast<uint8_t *>(::operator new(Allocationsize(Newcapacity), std::align_val_t(Alignment)));
+            Control = reinterpret_cast<int8_t *>(Memory);
+            Slots = reinterpret_cast<value_type *>(Memory + Slotoffset(Newcapacity));
+            std::memset(Control, Internal::Empty, Newcapacity);
+
+            Capacity = Newcapacity;
+            Growthleft = Newcapacity - Newcapacity / 8 - Count;
+        }
+        void Deallocate(int8_t *Memory, size_t Oldcapacity) noexcept
+        {
+            if (Oldcapacity) ::operator delete(Memory, Allocationsize(Oldcapacity), std::align_val_t(Alignment));
+        }
+
+        void Rehash(size_t Newcapacity)
+        {
+            const auto Oldcontrol = Control;
+            const auto Oldslots = Slots;
+            const auto Oldcapacity = Capacity;
+
+            Allocate(Newcapacity);
+
+            // No duplicates or tombstones in the new table, so just take the first free slot.
+            for (size_t i = 0; i < Oldcapacity; ++i)
+            {
+                if (Oldcontrol[i] < 0) continue;
+
+                const auto Hash = Hashfunction(Keyof(Oldslots[i]));
+                const auto Index = Findfree(Hash);
+
+                Setcontrol(Index, Tagof(Hash));
+                std::construct_at(Slots + Index, std::move(Oldslots[i]));
+                std::destroy_at(Oldslots + i);
+            }
+
+            Deallocate(Oldcontrol, Oldcapacity);
+        }
+        static size_t Capacityfor(size_t Elements) noexcept
+        {
+            // Keep the load at or below 7/8.
+            return std::bit_ceil(std::max(Internal::Groupwidth, Elements + Elements / 7 + 1));
+        }
+
+        // Returns the slot for the key, whether it needs to be constructed and the tag to Occupy() it with once it is.
+        template <typename Q> std::tuple<size_t, bool, int8_t> Findorprepare(const Q &Key)
+        {
+            const auto Hash = Hashfunction(Key);
+            if (const auto Index = Findindex(Key, Hash); Index != Capacity) return { Index, false, 0 };
+
+            auto Index = Capacity ? Findfree(Hash) : 0;
+            if (Capacity == 0 || (Growthleft == 0 && Control[Index] == Internal::Empty)) [[unlikely]]
+            {
+                // Mostly tombstones, clean up in place rather than grow.
+                if (Capacity && Count * 32 <= Capacity * 25) Rehash(Capacity);
+                else Rehash(Capacityfor(Count + 1) == Capacity ? Capacity * 2 : Capacityfor(Count + 1));
+                Index = Findfree(Hash);
+            }
+
+            return { Index, true, Tagof(Hash) };
+        }
+        void Occupy(size_t Index, int8_t Tag) noexcept
+        {
+            if (Control[Index] == Internal::Empty) --Growthleft;
+            Setcontrol(Index, Tag);
+            ++Count;
+        }
+
+        void Eraseindex(size_t Index) noexcept
+        {
+            std::destroy_at(Slots + Index);
+            --Count;
+
+            // A group with an empty slot was never full, so no probe ever continued past it.
+            const Internal::Group_t Group(Control + (Index & ~(Internal::Groupwidth - 1)));
+            if (Group.Matchempty()) { Setcontrol(Index, Internal::Empty); ++Growthleft; }
+            else Setcontrol(Index, Internal::Deleted);
+        }
+
+    public:
+        template <bool Const> struct Iterator_t
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = Table_t::value_type;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+            std::conditional_t<Const, const Table_t *, Table_t *> Table{};
+            size_t Index{};
+
+            void Skip() noexcept { while (Index < Table->Capacity && Table->Control[Index] < 0) ++Index; }
+
+            reference operator*() const noexcept { return Table->Slots[Index]; }
+            pointer operator->() const noexcept { return Table->Slots + Index; }
+
+            Iterator_t &operator++() noexcept { ++Index; Skip(); return *this; }
+            Iterator_t operator++(int) noexcept { auto Copy{ *this }; operator++(); return Copy; }
+
+            bool operator==(const Iterator_t &Right) const noexcept { return Index == Right.Index; }
+            operator Iterator_t<true>() const noexcept requires (!Const) { return { Table, Index }; }
+        };
+        using iterator = Iterator_t<false>;
+        using const_iterator = Iterator_t<true>;
+
+        Table_t() = default;
+        Table_t(std::initializer_list<value_type> Items) { reserve(Items.size()); for (const auto &Item : Items) insert(Item); }
+        template <std::ranges::input_range R> requires (!std::is_same_v<std::remove_cvref_t<R>, Table_t>) explicit Table_t(R &&Items) { for (auto &&Item : Items) insert(std::forward<decltype(Item)>(Item)); }
+
+        Table_t(const Table_t &Other) : Hashfunction(Other.Hashfunction), Keyequal(Other.Keyequal)
+        {
+            reserve(Other.Count);
+            for (const auto &Item : Other) insert(Item);
+        }
+        Table_t(Table_t &&Other) noexcept { swap(Other); }
+        Table_t &operator=(const Table_t &Other)
+        {
+            if (this != &Other) { Table_t Copy(Other); swap(Copy); }
+            return *this;
+        }
+        Table_t &operator=(Table_t &&Other) noexcept
+        {
+            if (this != &Other) { Table_t Temp(std::move(Other)); swap(Temp); }
+            return *this;
+        }
+        ~Table_t()
+        {
+            clear();
+            Deallocate(Control, Capacity);
+        }
+
+        void swap(Table_t &Other) noexcept
+        {
+            std::swap(Control, Other.Control); std::swap(Slots, Other.Slots);
+            std::swap(Capacity, Other.Capacity); std::swap(Count, Other.Count); std::swap(Growthleft, Other.Growthleft);
+            std::swap(Hashfunction, Other.Hashfunction); std::swap(Keyequal, Other.Keyequal);
+        }
+
+        [[nodiscard]] iterator begin() noexcept { iterator It{ this, 0 }; It.Skip(); return It; }
+        [[nodiscard]] const_iterator begin() const noexcept { const_iterator It{ this, 0 }; It.Skip(); return It; }
+        [[nodiscard]] iterator end() noexcept { return { this, Capacity }; }
+        [[nodiscard]] const_iterator end() const noexcept { return { this, Capacity }; }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+        [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+        [[nodiscard]] bool empty() const noexcept { return Count == 0; }
+        [[nodiscard]] size_t size() const noexcept { return Count; }
+        [[nodiscard]] size_t capacity() const noexcept { return Capacity; }
+        [[nodiscard]] float load_factor() const noexcept { return Capacity ? float(Count) / float(Capacity) : 0.0f; }
+
+        void reserve(size_t Elements)
+        {
+            if (const auto Needed = Capacityfor(Elements); Needed > Capacity) Rehash(Needed);
+        }
+        void clear() noexcept
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+                if (Control[i] >= 0) std::destroy_at(Slots + i);
+
+            if (Capacity) std::memset(Control, Internal::Empty, Capacity);
+            Count = 0;
+            Growthleft = Capacity - Capacity / 8;
+        }
+
+        // Lookups, any type the hasher and comparator accept when they are transparent.
+        [[nodiscard]] iterator find(const K &Key) noexcept { return { this, Findindex(Key, Hashfunction(Key)) }; }
+        [[nodiscard]] const_iterator find(const K &Key) const noexcept { return { this, Findindex(Key, Hashfunction(Key)) }; }
+        [[nodiscard]] bool contains(const K &Key) const noexcept { return Findindex(Key, Hashfunction(Key)) != Capacity; }
+        [[nodiscard]] size_t count(const K &Key) const noexcept { return contains(Key); }
+
+        template <typename Q> requires (isTransparent) [[nodiscard]] iterator find(const Q &Key) noexcept { return { this, Findindex(Key, Hashfunction(Key)) }; }
+        template <typename Q> requires (isTransparent) [[nodiscard]] const_iterator find(const Q &Key) const noexcept { return { this, Findindex(Key, Hashfunction(Key)) }; }
+        template <typename Q> requires (isTransparent) [[nodiscard]] bool contains(const Q &Key) const noexcept { return Findindex(Key, Hashfunction(Key)) != Capacity; }
+        template <typename Q> requires (isTransparent) [[nodiscard]] size_t count(const Q &Key) const noexcept { return contains(Key); }
+
+        // Insertion, existing entries are left untouched.
+        std::pair<iterator, bool> insert(const value_type &Value)
+        {
+            const auto [Index, isNew, Tag] = Findorprepare(Keyof(Value));
+            if (isNew) { std::construct_at(Slots + Index, Value); Occupy(Index, Tag); }
+            return { { this, Index }, isNew };
+        }
+        std::pair<iterator, bool> insert(value_type &&Value)
+        {
+            const auto [Index, isNew, Tag] = Findorprepare(Keyof(Value));
+            if (isNew) { std::construct_at(Slots + Index, std::move(Value)); Occupy(Index, Tag); }
+            return { { this, Index }, isNew };
+        }
+        template <typename ...Args> std::pair<iterator, bool> emplace(Args&& ...args)
+        {
+            // Need the key before we know where it goes.
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        // Map specific.
+        template <typename Q = K, typename ...Args> requires (!isSet) std::pair<iterator, bool> try_emplace(Q &&Key, Args&& ...args)
+        {
+            // Without transparency the lookup has to go through a key.
+            if constexpr (!isTransparent && !std::is_same_v<std::remove_cvref_t<Q>, K>)
+                return try_emplace(K(std::forward<Q>(Key)), std::forward<Args>(args)...);
+            else
+            {
+                const auto [Index, isNew, Tag] = Findorprepare(Key);
+                if (isNew)
+                {
+                    std::construct_at(Slots + Index, std::piecewise_construct, std::forward_as_tuple(std::forward<Q>(Key)), std::forward_as_tuple(std::forward<Args>(args)...));
+                    Occupy(Index, Tag);
+                }
+                return { { this, Index }, isNew };
+            }
+        }
+        template <typename Q = K, typename T> requires (!isSet) std::pair<iterator, bool> insert_or_assign(Q &&Key, T &&Value)
+        {
+            auto Result = try_emplace(std::forward<Q>(Key), std::forward<T>(Value));
+            if (!Result.second) Result.first->second = std::forward<T>(Value);
+            return Result;
+        }
+        template <typename Q = K> requires (!isSet) auto &operator[](Q &&Key)
+        {
+            return try_emplace(std::forward<Q>(Key)).first->second;
+        }
+        template <typename Q = K> requires (!isSet && (isTransparent || std::is_same_v<Q, K>)) [[nodiscard]] auto &at(const Q &Key)
+        {
+            const auto Index = Findindex(Key, Hashfunction(Key));
+            ASSERT(Index != Capacity);
+            return Slots[Index].second;
+        }
+        template <typename Q = K> requires (!isSet && (isTransparent || std::is_same_v<Q, K>)) [[nodiscard]] const auto &at(const Q &Key) const
+        {
+            const auto Index = Findindex(Key, Hashfunction(Key));
+            ASSERT(Index != Capacity);
+            return Slots[Index].second;
+        }
+
+        // Erasure never moves other elements, so iterators stay valid.
+        size_t erase(const K &Key) noexcept { return erase<K>(Key); }
+        template <typename Q> requires (isTransparent || std::is_same_v<Q, K>) size_t erase(const Q &Key) noexcept
+        {
+            const auto Index = Findindex(Key, Hashfunction(Key));
+            if (Index == Capacity) return 0;
+
+            Eraseindex(Index);
+            return 1;
+        }
+        iterator erase(const_iterator Position) noexcept
+        {
+            Eraseindex(Position.Index);
+            iterator Next{ this, Position.Index };
+            return ++Next;
+        }
+        iterator erase(iterator Position) noexcept { return erase(const_iterator(Position)); }
+
+        [[nodiscard]] bool operator==(const Table_t &Right) const
+        {
+            if (Count != Right.Count) return false;
+
+            return std::ranges::all_of(*this, [&](const value_type &Item)
+            {
+                const auto It = Right.find(Keyof(Item));
+                if constexpr (isSet) return It != Right.end();
+                else return It != Right.end() && It->second == Item.second;
+            });
+        }
+    };
+}
+
+template <typename K, typename V, typename Hash = Flathash::WW64hash_t, typename Eq = std::equal_to<>>
+using Flatmap_t = Flathash::Table_t<K, V, Hash, Eq>;
+template <typename K, typename Hash = Flathash::WW64hash_t, typename Eq = std::equal_to<>>
+using Flatset_t = Flathash::Table_t<K, void, Hash, Eq>;
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Hashmaptest()
+    {
+        Flatmap_t<std::string, int> Map{};
+        for (int i = 0; i < 10000; ++i) Map.try_emplace(std::to_string(i), i);
+
+        // Heterogeneous lookups don't construct a std::string.
+        if (Map.size() != 10000 || Map.find(std::string_view("1234"))->second != 1234 || !Map.contains("9999"))
+            std::printf("BROKEN: Flatmap_t lookup\n");
+
+        // Tombstones get reused and cleaned up without growing the table.
+        const auto Capacity = Map.capacity();
+        for (int Round = 0; Round < 10; ++Round)
+        {
+            for (int i = 0; i < 5000; ++i) Map.erase(std::to_string(i));
+            for (int i = 0; i < 5000; ++i) Map[std::to_string(i)] = i;
+        }
+        if (Map.size() != 10000 || Map.capacity() != Capacity) std::printf("BROKEN: Flatmap_t tombstones\n");
+
+        int Sum{};
+        for (auto It = Map.begin(); It != Map.end();)
+        {
+            if (It->second & 1) It = Map.erase(It);
+            else { Sum += It->second; ++It; }
+        }
+        if (Map.size() != 5000 || Sum != 24995000) std::printf("BROKEN: Flatmap_t iteration\n");
+
+        const auto Copy = Map;
+        if (!(Copy == Map) || Copy.at("42") != 42) std::printf("BROKEN: Flatmap_t copy\n");
+
+        Flatset_t<uint64_t> Set{ 1, 2, 3, 2, 1 };
+        if (Set.size() != 3 || !Set.contains(3) || Set.contains(4)) std::printf("BROKEN: Flatset_t\n");
+    }
+}
+#endif
@@ -3,7 +3,9 @@
     Started: 2024-07-20
     License: MIT
 
-    Very simple vector for when we have an expected amount of elements.
+    Small-buffer vector for when we have an expected amount of elements.
+    The inline storage is left uninitialized and shares space with the heap pointer once spilled.
+    Spilled storage comes from the Allocator, e.g. Memory::Poolallocator_t or std::pmr::polymorphic_allocator.
 */
 
 #pragma once
@@ -11,163 +13,415 @@
 #include <memory>
 #include <ranges>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <memory_resource>
 #include "../Constexpr.hpp"
 
-template <typename T, uint32_t Fixedsize> requires (Fixedsize > 0)
+namespace cmp
+{
+    // Types that can be moved with a memcpy and the source forgotten, specialize for more.
+    template <typename T> constexpr bool isRelocatable = std::is_trivially_copyable_v<T>;
+}
+
+template <typename T, uint32_t Fixedsize, typename Allocator = std::allocator<T>> requires (Fixedsize > 0)
 struct Inlinedvector
 {
-    uint32_t Capacity = Fixedsize, Size{};
-    std::array<T, Fixedsize> Static{};
-    T *Dynamic{};
+    using allocator_type = Allocator;
+    using value_type = T;
+    using size_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
 
-    // The operator[] already does selection for us.
-    struct Iterator_t
-    {
-        using difference_type = std::ptrdiff_t;
-        using reference = const T &;
-        using pointer = const T *;
-        using value_type = T;
+private:
+    using Traits_t = std::allocator_traits<Allocator>;
 
-        uint32_t Index, Count;
-        const Inlinedvector &Parent;
+    // Unequal allocators that don't propagate, e.g. pmr, have to copy the elements over into a new allocation when moving.
+    static constexpr bool Nothrowmove = Traits_t::propagate_on_container_move_assignment::value || Traits_t::is_always_equal::value;
+    [[no_unique_address]] Allocator Alloc{};
 
-        const T &operator*() const noexcept { return Parent[Index]; }
-        const T *operator->() const noexcept { return &Parent[Index]; }
+    // Capacity above Fixedsize means the heap is in use.
+    uint32_t Size{}, Capacity{ Fixedsize };
+    union
+    {
+        alignas(T) std::byte Inline[sizeof(T) * Fixedsize];
+        T *Heap;
+    };
 
-        bool operator==(const std::default_sentinel_t) const noexcept { return Count == 0; }
-        bool operator==(const Iterator_t &Right) const noexcept { return Count == Right.Count; }
+    [[nodiscard]] bool isDynamic() const noexcept { return Capacity > Fixedsize; }
+    [[nodiscard]] T *Inlinedata() noexcept { return std::launder(reinterpret_cast<T *>(Inline)); }
 
-        Iterator_t &operator++() noexcept { ++Index; --Count; return *this; }
-        Iterator_t &operator--() noexcept { --Index; ++Count; return *this; }
+    // Moves Count elements into uninitialized memory and ends the lifetime of the source.
+    static void Relocate(T *Destination, T *Source, uint32_t Count) noexcept
+    {
+        if (Count == 0) return;
 
-        Iterator_t operator++(int) noexcept { auto Copy{ *this }; operator++(); return Copy; }
-        Iterator_t operator--(int) noexcept { auto Copy{ *this }; operator--(); return Copy; }
-    };
+        if constexpr (cmp::isRelocatable<T>) std::memcpy((void *)Destination, (const void *)Source, sizeof(T) * Count);
+        else
+        {
+            std::uninitialized_move_n(Source, Count, Destination);
+            std::destroy_n(Source, Count);
+        }
+    }
 
-    // General information.
-    [[nodiscard]] bool empty() const noexcept
+    void Release() noexcept
     {
-        return Size == 0;
+        if (isDynamic()) Traits_t::deallocate(Alloc, Heap, Capacity);
     }
-    [[nodiscard]] uint32_t size() const noexcept
+
+    // Grows and constructs the new element before moving the rest, so arguments may refer to our own elements.
+    template <typename ...Args> T &Emplaceslow(uint32_t Index, Args&& ...args)
     {
-        return Size;
+        const auto Newcapacity = cmp::max(Capacity * 2, Size + 1);
+        const auto Newbuffer = Traits_t::allocate(Alloc, Newcapacity);
+        const auto Old = data();
+
+        const auto Result = std::construct_at(Newbuffer + Index, std::forward<Args>(args)...);
+        Relocate(Newbuffer, Old, Index);
+        Relocate(Newbuffer + Index + 1, Old + Index, Size - Index);
+
+        Release();
+        Heap = Newbuffer;
+        Capacity = Newcapacity;
+        ++Size;
+        return *Result;
     }
 
-    // New memory is not initialized.
-    void reserve(uint32_t Newsize) noexcept
+    // Steal the allocation, inline elements have to be moved over. Expects us to be empty, inline and using an equal allocator.
+    void Takefrom(Inlinedvector &Other) noexcept
     {
-        if (Newsize > Capacity)
+        if (Other.isDynamic())
         {
-            // If realloc fails, we have bigger problems than a segfault..
-            Dynamic = (T *)std::realloc(Dynamic, Newsize - Fixedsize);
-            Capacity = Newsize;
+            Heap = std::exchange(Other.Heap, nullptr);
+            Capacity = std::exchange(Other.Capacity, Fixedsize);
         }
+        else Relocate(Inlinedata(), Other.Inlinedata(), Other.Size);
+
+        Size = std::exchange(Other.Size, 0);
     }
-    void resize(uint32_t Newsize) noexcept
+
+    void Reallocate(uint32_t Newcapacity)
     {
-        if (Newsize <= Fixedsize && Dynamic)
-        {
-            if constexpr (!std::is_trivially_destructible_v<T>)
-                for (uint32_t i = 0; i < (Size - Fixedsize); ++i)
-                    Dynamic[i].~T();
+        const auto Old = data();
+        const auto Wasdynamic = isDynamic();
+        const auto Oldcapacity = Capacity;
 
-            std::free(std::exchange(Dynamic, nullptr));
+        if (Newcapacity > Fixedsize)
+        {
+            const auto Newbuffer = Traits_t::allocate(Alloc, Newcapacity);
+            Relocate(Newbuffer, Old, Size);
+            if (Wasdynamic) Traits_t::deallocate(Alloc, Old, Oldcapacity);
+            Heap = Newbuffer;
+        }
+        else if (Wasdynamic)
+        {
+            Relocate(Inlinedata(), Old, Size);
+            Traits_t::deallocate(Alloc, Old, Oldcapacity);
         }
-        if (Newsize < Fixedsize) std::fill(Static.begin() + Newsize, Static.end(), T{});
-        if (Newsize > Capacity) reserve(Newsize);
 
-        Size = Newsize;
-        Capacity = cmp::max(Newsize, Fixedsize);
+        Capacity = cmp::max(Newcapacity, Fixedsize);
     }
 
-    // STL-like modifiers.
-    template <typename... Args> T &emplace_back(Args&&... args) noexcept
+public:
+    // General information.
+    [[nodiscard]] bool empty() const noexcept { return Size == 0; }
+    [[nodiscard]] uint32_t size() const noexcept { return Size; }
+    [[nodiscard]] uint32_t capacity() const noexcept { return Capacity; }
+    [[nodiscard]] static constexpr uint32_t inlined_capacity() noexcept { return Fixedsize; }
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return Alloc; }
+
+    [[nodiscard]] T *data() noexcept { return isDynamic() ? Heap : Inlinedata(); }
+    [[nodiscard]] const T *data() const noexcept { return const_cast<Inlinedvector *>(this)->data(); }
+
+    // Plain pointers so that loops vectorize.
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + Size; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + Size; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return data() + Size; }
+
+    // Simple access to elements.
+    [[nodiscard]] T &operator[](uint32_t Index) noexcept { assert(Size > Index); return data()[Index]; }
+    [[nodiscard]] const T &operator[](uint32_t Index) const noexcept { assert(Size > Index); return data()[Index]; }
+    [[nodiscard]] T &front() noexcept { return operator[](0); }
+    [[nodiscard]] const T &front() const noexcept { return operator[](0); }
+    [[nodiscard]] T &back() noexcept { return operator[](Size - 1); }
+    [[nodiscard]] const T &back() const noexcept { return operator[](Size - 1); }
+
+    // New memory is not initialized.
+    void reserve(uint32_t Newcapacity)
+    {
+        if (Newcapacity > Capacity) Reallocate(Newcapacity);
+    }
+    void shrink_to_fit()
     {
-        if (Size < Fixedsize)
+        if (isDynamic() && Size < Capacity) Reallocate(Size);
+    }
+    void resize(uint32_t Newsize)
+    {
+        if (Newsize < Size) std::destroy(begin() + Newsize, end());
+        else
         {
-            return Static[Size++] = { args... };
+            reserve(Newsize);
+            std::uninitialized_value_construct(end(), data() + Newsize);
         }
-        if (Size < Capacity)
+
+        Size = Newsize;
+    }
+    void resize(uint32_t Newsize, const T &Value)
+    {
+        if (Newsize < Size) std::destroy(begin() + Newsize, end());
+        else if (Newsize > Size)
         {
-            return Dynamic[Size++ - Fixedsize] = { args... };
+            // Value may be one of ours.
+            if (Newsize > Capacity) { const T Copy(Value); reserve(Newsize); std::uninitialized_fill(end(), data() + Newsize, Copy); }
+            else std::uninitialized_fill(end(), data() + Newsize, Value);
         }
 
-        reserve(Capacity + 1);
-        return Dynamic[Size++ - Fixedsize] = { args... };
+        Size = Newsize;
     }
-    void push_back(const T &Value) noexcept
+
+    // STL-like modifiers.
+    template <typename ...Args> T &emplace_back(Args&& ...args)
     {
-        emplace_back(Value);
+        if (Size == Capacity) [[unlikely]] return Emplaceslow(Size, std::forward<Args>(args)...);
+
+        const auto Result = std::construct_at(data() + Size, std::forward<Args>(args)...);
+        ++Size;
+        return *Result;
     }
+    void push_back(const T &Value) { emplace_back(Value); }
+    void push_back(T &&Value) { emplace_back(std::move(Value)); }
     void pop_back() noexcept
     {
-        resize(Size - 1);
+        assert(Size > 0);
+        std::destroy_at(data() + --Size);
     }
 
-    // Simple access to elements.
-    [[nodiscard]] const T &back() const noexcept
+    // Only reallocates when out of capacity.
+    template <typename ...Args> iterator emplace(const_iterator Position, Args&& ...args)
     {
-        return operator[](Size - 1);
+        const auto Index = uint32_t(Position - begin());
+        if (Size == Capacity) [[unlikely]] return &Emplaceslow(Index, std::forward<Args>(args)...);
+
+        // Construct at the end first so that arguments referring into the vector stay valid, then rotate it into place.
+        const auto Base = data();
+        std::construct_at(Base + Size, std::forward<Args>(args)...);
+
+        if constexpr (cmp::isRelocatable<T>)
+        {
+            alignas(T) std::byte Temp[sizeof(T)];
+            std::memcpy(Temp, (const void *)(Base + Size), sizeof(T));
+            std::memmove((void *)(Base + Index + 1), (const void *)(Base + Index), sizeof(T) * (Size - Index));
+            std::memcpy((void *)(Base + Index), Temp, sizeof(T));
+        }
+        else std::rotate(Base + Index, Base + Size, Base + Size + 1);
+
+        ++Size;
+        return Base + Index;
     }
-    [[nodiscard]] const T &front() const noexcept
+    iterator insert(const_iterator Position, const T &Value) { return emplace(Position, Value); }
+    iterator insert(const_iterator Position, T &&Value) { return emplace(Position, std::move(Value)); }
+    iterator insert(const_iterator Position, uint32_t Count, const T &Value)
     {
-        return operator[](0);
+        const auto Index = uint32_t(Position - begin());
+        const auto Oldsize = Size;
+        const T Copy(Value);
+
+        if (Size + Count > Capacity) reserve(cmp::max(Size + Count, Capacity * 2));
+        std::uninitialized_fill_n(end(), Count, Copy);
+        Size += Count;
+
+        std::rotate(begin() + Index, begin() + Oldsize, end());
+        return begin() + Index;
     }
-    [[nodiscard]] T &operator[](uint32_t Index) const noexcept
+    template <std::input_iterator It> iterator insert(const_iterator Position, It First, It Last)
     {
-        assert(Size > Index);
-        if (Index < Fixedsize) return Static[Index];
-        else return Dynamic[1 + Index - Fixedsize];
+        const auto Index = uint32_t(Position - begin());
+        const auto Oldsize = Size;
+
+        if constexpr (std::forward_iterator<It>)
+        {
+            const auto Count = uint32_t(std::distance(First, Last));
+            if (Size + Count > Capacity) reserve(cmp::max(Size + Count, Capacity * 2));
+            std::uninitialized_copy(First, Last, end());
+            Size += Count;
+        }
+        else for (; First != Last; ++First) emplace_back(*First);
+
+        std::rotate(begin() + Index, begin() + Oldsize, end());
+        return begin() + Index;
     }
+    iterator insert(const_iterator Position, std::initializer_list<T> Items) { return insert(Position, Items.begin(), Items.end()); }
 
-    // STL compatibility.
-    [[nodiscard]] static auto end() noexcept { return std::default_sentinel_t{}; }
-    [[nodiscard]] auto begin() const noexcept { return std::counted_iterator{ Iterator_t{ 0, Size, *this }, Size }; }
+    // Never reallocates.
+    iterator erase(const_iterator First, const_iterator Last) noexcept
+    {
+        const auto Base = begin();
+        const auto Index = uint32_t(First - Base), Count = uint32_t(Last - First);
+        if (Count == 0) return Base + Index;
 
-    // Provide some common vector members incase someone wants them.
-    [[nodiscard]] auto insert(const std::counted_iterator<Iterator_t> &Position, const T &Value) noexcept
+        if constexpr (cmp::isRelocatable<T>)
+        {
+            std::destroy_n(Base + Index, Count);
+            std::memmove((void *)(Base + Index), (const void *)(Base + Index + Count), sizeof(T) * (Size - Index - Count));
+        }
+        else
+        {
+            std::move(Base + Index + Count, Base + Size, Base + Index);
+            std::destroy(Base + Size - Count, Base + Size);
+        }
+
+        Size -= Count;
+        return Base + Index;
+    }
+    iterator erase(const_iterator Position) noexcept { return erase(Position, Position + 1); }
+
+    void assign(uint32_t Newsize, const T &Value)
     {
-        const auto Index = Position.base().Index;
-        operator[](Index) = Value;
-        return Position;
+        const T Copy(Value);
+        clear();
+        resize(Newsize, Copy);
     }
-    [[nodiscard]] auto insert(std::counted_iterator<Iterator_t> &Position, const T &Value) noexcept
+    void clear() noexcept
     {
-        const auto Index = Position.base().Index;
-        operator[](Index) = Value;
-        return Position;
+        std::destroy(begin(), end());
+        Size = 0;
     }
-    void assign(uint32_t Newsize, const T &Value) noexcept
+    void swap(Inlinedvector &Other) noexcept(Nothrowmove)
     {
-        resize(Newsize);
-        std::fill_n(Static.data(), cmp::min(Newsize, Fixedsize), Value);
-        if (Newsize > Fixedsize) std::fill_n(Dynamic, Newsize - Fixedsize, Value);
+        Inlinedvector Temp(std::move(Other));
+        Other = std::move(*this);
+        *this = std::move(Temp);
     }
-    void clear() noexcept
+
+    [[nodiscard]] bool operator==(const Inlinedvector &Right) const
     {
-        resize(0);
+        return std::ranges::equal(*this, Right);
     }
 
     // Simplify constructing from any valid range (T.begin(), T.end()).
-    template <cmp::Range_t U> requires (std::is_same_v<typename U::value_type, T>) Inlinedvector(const U &Range) noexcept
+    template <cmp::Range_t U> requires (std::is_same_v<typename U::value_type, T> && !std::is_same_v<U, Inlinedvector>)
+    Inlinedvector(const U &Range, const Allocator &Instance = Allocator()) : Alloc(Instance)
+    {
+        insert(end(), Range.begin(), Range.end());
+    }
+    Inlinedvector(std::initializer_list<T> Items, const Allocator &Instance = Allocator()) : Alloc(Instance)
+    {
+        insert(end(), Items.begin(), Items.end());
+    }
+    explicit Inlinedvector(uint32_t Newsize, const Allocator &Instance = Allocator()) : Alloc(Instance) { resize(Newsize); }
+    Inlinedvector(uint32_t Newsize, const T &Value, const Allocator &Instance = Allocator()) : Alloc(Instance) { resize(Newsize, Value); }
+    explicit Inlinedvector(const Allocator &Instance) noexcept : Alloc(Instance) {}
+
+    Inlinedvector(const Inlinedvector &Other) : Alloc(Traits_t::select_on_container_copy_construction(Other.Alloc))
+    {
+        reserve(Other.Size);
+        std::uninitialized_copy_n(Other.data(), Other.Size, data());
+        Size = Other.Size;
+    }
+    Inlinedvector(Inlinedvector &&Other) noexcept : Alloc(std::move(Other.Alloc)) { Takefrom(Other); }
+    Inlinedvector &operator=(const Inlinedvector &Other)
     {
-        const auto PartA = cmp::min(Range.size(), Fixedsize);
-        const auto PartB = Range.size() - PartA;
+        if (this == &Other) return *this;
+
+        clear();
+        if constexpr (Traits_t::propagate_on_container_copy_assignment::value)
+        {
+            // Our storage has to go back to the allocator that made it.
+            if (Alloc != Other.Alloc) { Release(); Capacity = Fixedsize; }
+            Alloc = Other.Alloc;
+        }
 
-        resize(Range.size());
-        std::ranges::copy_n(Range, PartA, Static.data());
-        std::ranges::copy_n(Range.begin() + PartA, PartB, Dynamic);
+        reserve(Other.Size);
+        std::uninitialized_copy_n(Other.data(), Other.Size, data());
+        Size = Other.Size;
+        return *this;
     }
-    Inlinedvector(uint32_t Newsize) noexcept
+    Inlinedvector &operator=(Inlinedvector &&Other) noexcept(Nothrowmove)
     {
-        const auto PartA = cmp::min(Newsize, Fixedsize);
-        const auto PartB = Newsize - PartA;
+        if (this == &Other) return *this;
 
-        resize(Newsize);
-        std::fill_n(Static, PartA, T{});
-        std::fill_n(Dynamic, PartB, T{});
+        clear();
+
+        // Allocations can only change hands between equal allocators, otherwise the elements are moved one by one.
+        if constexpr (!Nothrowmove)
+        {
+            if (Alloc != Other.Alloc)
+            {
+                reserve(Other.Size);
+                std::uninitialized_move_n(Other.data(), Other.Size, data());
+                Size = Other.Size;
+                Other.clear();
+                return *this;
+            }
+        }
+
+        Release();
+        Capacity = Fixedsize;
+        if constexpr (Traits_t::propagate_on_container_move_assignment::value) Alloc = std::move(Other.Alloc);
+        Takefrom(Other);
+        return *this;
     }
-    ~Inlinedvector() noexcept { clear(); }
-    Inlinedvector() = default;
+
+    ~Inlinedvector() noexcept
+    {
+        clear();
+        Release();
+    }
+    Inlinedvector() noexcept {}
 };
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Inlinedvectortest()
+    {
+        // Trivial types take the memcpy paths.
+        Inlinedvector<int, 4> Trivial{ 1, 2, 3 };
+        for (int i = 4; i <= 10; ++i) Trivial.push_back(i);
+        Trivial.insert(Trivial.begin() + 1, 42);
+        Trivial.erase(Trivial.begin() + 3, Trivial.begin() + 5);
+        if (Trivial != Inlinedvector<int, 4>{ 1, 42, 2, 5, 6, 7, 8, 9, 10 }) std::printf("BROKEN: Inlinedvector trivial\n");
+
+        // Moving an inlined vector moves the elements, a spilled one hands over its allocation.
+        Inlinedvector<std::string, 2> Strings{};
+        Strings.emplace_back("a rather long string that is not in the SSO buffer");
+        Strings.insert(Strings.begin(), Strings.back());
+        Strings.emplace(Strings.begin() + 1, "b");
+
+        const auto Pointer = Strings.data();
+        const auto Moved = std::move(Strings);
+        if (Moved.size() != 3 || Moved.data() != Pointer || Moved[1] != "b" || Moved[0] != Moved[2] || !Strings.empty())
+            std::printf("BROKEN: Inlinedvector move\n");
+
+        Inlinedvector<std::string, 4> Small{ "x", "y" };
+        auto Copy = Small;
+        Copy.erase(Copy.begin());
+        Copy.resize(3, "z");
+        if (Copy.size() != 3 || Copy[0] != "y" || Copy[2] != "z" || Copy.capacity() != 4 || Small.size() != 2)
+            std::printf("BROKEN: Inlinedvector copy\n");
+
+        // Spilled storage from a polymorphic resource, moving between different resources copies the elements.
+        std::array<std::byte, 4096> Storage;
+        std::pmr::monotonic_buffer_resource Local(Storage.data(), Storage.size(), std::pmr::null_memory_resource());
+        Inlinedvector<int, 2, std::pmr::polymorphic_allocator<int>> Left{}, Right(&Local);
+        for (int i = 0; i < 100; ++i) Left.push_back(i);
+        Right = std::move(Left);
+
+        const auto Inside = (const std::byte *)Right.data() >= Storage.data() && (const std::byte *)Right.data() < Storage.data() + Storage.size();
+        if (Right.size() != 100 || Right.back() != 99 || !Inside || Right.get_allocator().resource() != &Local)
+            std::printf("BROKEN: Inlinedvector allocator\n");
+
+        // Each side keeps its resource, so swapping may have to allocate.
+        Left.swap(Right);
+        if (Left.size() != 100 || !Right.empty() || Left.get_allocator().resource() == &Local) std::printf("BROKEN: Inlinedvector swap\n");
+        static_assert(!noexcept(Left.swap(Right)) && noexcept(Trivial.swap(Trivial)));
+    }
+}
+#endif
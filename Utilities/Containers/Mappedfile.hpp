@@ -0,0 +1,350 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Memory-mapped files, pages are faulted in on access rather than copied up front.
+    Read-only mappings hand out non-owning buffers, writable ones grow as data is appended.
+*/
+
+#pragma once
+#include "Bytebuffer.hpp"
+#include "Protobuffer.hpp"
+
+#if !defined (_WIN32)
+#include <fcntl.h>
+#endif
+
+class Mappedfile_t
+{
+    public:
+    enum class Access_t : uint8_t { Normal, Sequential, Random };
+
+    private:
+    #if defined (_WIN32)
+    HANDLE File{ INVALID_HANDLE_VALUE };
+    HANDLE Mapping{};
+    #else
+    int File{ -1 };
+    #endif
+
+    uint8_t *Base{};
+    size_t Mappedsize{};    // Bytes currently mapped, the file is this large while writing.
+    size_t Contentsize{};   // Bytes that are actually in use.
+    bool isWritable{};
+
+    static size_t Pagesize()
+    {
+        #if defined (_WIN32)
+        static const size_t Size = []() { SYSTEM_INFO Info{}; GetSystemInfo(&Info); return size_t(Info.dwAllocationGranularity); }();
+        #else
+        static const size_t Size = size_t(sysconf(_SC_PAGESIZE));
+        #endif
+        return Size;
+    }
+
+    bool Map(size_t Size)
+    {
+        Unmap();
+        if (Size == 0) return true;
+
+        #if defined (_WIN32)
+        const auto Protection = isWritable ? PAGE_READWRITE : PAGE_READONLY;
+        Mapping = CreateFileMappingW(File, nullptr, Protection, DWORD(uint64_t(Size) >> 32), DWORD(Size), nullptr);
+        if (!Mapping) return false;
+
+        Base = (uint8_t *)MapViewOfFile(Mapping, isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, Size);
+        if (!Base) { CloseHandle(Mapping); Mapping = {}; return false; }
+        #else
+        const auto Address = mmap(nullptr, Size, isWritable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, File, 0);
+        if (Address == MAP_FAILED) return false;
+        Base = (uint8_t *)Address;
+        #endif
+
+        Mappedsize = Size;
+        return true;
+    }
+    void Unmap()
+    {
+        #if defined (_WIN32)
+        if (Base) UnmapViewOfFile(Base);
+        if (Mapping) CloseHandle(Mapping);
+        Mapping = {};
+        #else
+        if (Base) munmap(Base, Mappedsize);
+        #endif
+
+        Base = nullptr;
+        Mappedsize = 0;
+    }
+
+    bool Setfilesize(size_t Size)
+    {
+        #if defined (_WIN32)
+        LARGE_INTEGER Offset{}; Offset.QuadPart = LONGLONG(Size);
+        return SetFilePointerEx(File, Offset, nullptr, FILE_BEGIN) && SetEndOfFile(File);
+        #else
+        return ftruncate(File, off_t(Size)) == 0;
+        #endif
+    }
+
+    bool Openfile(const std::filesystem::path &Path, bool Writable, Access_t Hint)
+    {
+        isWritable = Writable;
+
+        #if defined (_WIN32)
+        DWORD Flags = FILE_ATTRIBUTE_NORMAL;
+        if (Hint == Access_t::Sequential) Flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        if (Hint == Access_t::Random) Flags |= FILE_FLAG_RANDOM_ACCESS;
+
+        File = Writable ? CreateFileW(Path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, Flags, nullptr)
+                        : CreateFileW(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, Flags, nullptr);
+        return File != INVALID_HANDLE_VALUE;
+        #else
+        (void)Hint;
+        File = Writable ? open(Path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+                        : open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+        return File != -1;
+        #endif
+    }
+
+    public:
+    // Read-only mapping of an existing file, check with isOpen() / operator bool.
+    Mappedfile_t() = default;
+    explicit Mappedfile_t(const std::filesystem::path &Path, Access_t Hint = Access_t::Normal)
+    {
+        if (!Openfile(Path, false, Hint)) return;
+
+        #if defined (_WIN32)
+        LARGE_INTEGER Size{};
+        if (!GetFileSizeEx(File, &Size) || !Map(size_t(Size.QuadPart))) { Close(); return; }
+        #else
+        struct stat Info{};
+        if (fstat(File, &Info) != 0 || !Map(size_t(Info.st_size))) { Close(); return; }
+        #endif
+
+        Contentsize = Mappedsize;
+        Advise(Hint);
+    }
+
+    // Writable mapping, truncates the file. Reserve is only the initial size, writes grow it as needed.
+    [[nodiscard]] static Mappedfile_t Create(const std::filesystem::path &Path, size_t Reserve = 0)
+    {
+        Mappedfile_t Result{};
+        if (!Result.Openfile(Path, true, Access_t::Sequential)) return Result;
+        if (Reserve && !Result.Grow(Reserve)) Result.Close();
+        return Result;
+    }
+
+    Mappedfile_t(const Mappedfile_t &) = delete;
+    Mappedfile_t &operator=(const Mappedfile_t &) = delete;
+    Mappedfile_t(Mappedfile_t &&Other) noexcept { *this = std::move(Other); }
+    Mappedfile_t &operator=(Mappedfile_t &&Other) noexcept
+    {
+        if (this == &Other) return *this;
+        Close();
+
+        #if defined (_WIN32)
+        Mapping = std::exchange(Other.Mapping, {});
+        File = std::exchange(Other.File, INVALID_HANDLE_VALUE);
+        #else
+        File = std::exchange(Other.File, -1);
+        #endif
+
+        Base = std::exchange(Other.Base, nullptr);
+        Mappedsize = std::exchange(Other.Mappedsize, 0);
+        Contentsize = std::exchange(Other.Contentsize, 0);
+        isWritable = std::exchange(Other.isWritable, false);
+        return *this;
+    }
+    ~Mappedfile_t() { Close(); }
+
+    // Writable files are trimmed to the written size.
+    void Close()
+    {
+        Unmap();
+
+        #if defined (_WIN32)
+        if (File != INVALID_HANDLE_VALUE)
+        {
+            if (isWritable) Setfilesize(Contentsize);
+            CloseHandle(File);
+        }
+        File = INVALID_HANDLE_VALUE;
+        #else
+        if (File != -1)
+        {
+            if (isWritable) Setfilesize(Contentsize);
+            close(File);
+        }
+        File = -1;
+        #endif
+
+        Contentsize = 0;
+        isWritable = false;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept
+    {
+        #if defined (_WIN32)
+        return File != INVALID_HANDLE_VALUE;
+        #else
+        return File != -1;
+        #endif
+    }
+    explicit operator bool() const noexcept { return isOpen(); }
+
+    [[nodiscard]] size_t size() const noexcept { return Contentsize; }
+    [[nodiscard]] bool empty() const noexcept { return Contentsize == 0; }
+    [[nodiscard]] const uint8_t *data() const noexcept { return Base; }
+
+    // Only writable mappings may be written through, read-only pages fault.
+    [[nodiscard]] uint8_t *data() noexcept { return Base; }
+
+    // Non-owning views, valid until the file is closed or grown.
+    [[nodiscard]] std::span<const uint8_t> as_span() const noexcept { return { Base, Contentsize }; }
+    [[nodiscard]] std::basic_string_view<uint8_t> as_blob() const noexcept { return { Base, Contentsize }; }
+
+    // The buffers have 32-bit sizes, so mappings of 4 GiB or more give an empty buffer rather than a truncated one.
+    [[nodiscard]] Bytebuffer_t as_buffer() const noexcept
+    {
+        if (Contentsize > UINT32_MAX) [[unlikely]] return {};
+        return Bytebuffer_t(Base, Contentsize);
+    }
+    [[nodiscard]] Protobuffer_t as_protobuffer() const noexcept
+    {
+        if (Contentsize > UINT32_MAX) [[unlikely]] return {};
+        return Protobuffer_t(Base, Contentsize);
+    }
+
+    // Hints for the whole mapping or a range of it, the OS is free to ignore them.
+    void Advise(Access_t Hint, size_t Offset = 0, size_t Length = SIZE_MAX) const
+    {
+        if (!Base || Offset >= Mappedsize) return;
+        const auto Aligned = Offset & ~(Pagesize() - 1);
+        Length = std::min(Length, Mappedsize - Offset) + (Offset - Aligned);
+
+        #if defined (_WIN32)
+        // Windows only takes access hints when opening the file.
+        (void)Hint; (void)Aligned; (void)Length;
+        #else
+        const auto Advice = Hint == Access_t::Sequential ? MADV_SEQUENTIAL : Hint == Access_t::Random ? MADV_RANDOM : MADV_NORMAL;
+        madvise(Base + Aligned, Length, Advice);
+        #endif
+    }
+    void Prefetch(size_t Offset = 0, size_t Length = SIZE_MAX) const
+    {
+        if (!Base || Offset >= Mappedsize) return;
+        const auto Aligned = Offset & ~(Pagesize() - 1);
+        Length = std::min(Length, Mappedsize - Offset) + (Offset - Aligned);
+
+        #if defined (_WIN32)
+        WIN32_MEMORY_RANGE_ENTRY Range{ Base + Aligned, Length };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &Range, 0);
+        #else
+        madvise(Base + Aligned, Length, MADV_WILLNEED);
+        #endif
+    }
+
+    // Writable mappings only, views taken before growing are invalidated.
+    bool Grow(size_t Minimum)
+    {
+        if (!isWritable) return false;
+        if (Minimum <= Mappedsize) return true;
+
+        // Geometric growth in whole pages to keep remapping rare.
+        const auto Granularity = Pagesize();
+        const auto Newsize = (std::max(Minimum, Mappedsize + Mappedsize / 2) + Granularity - 1) & ~(Granularity - 1);
+
+        Unmap();
+        return Setfilesize(Newsize) && Map(Newsize);
+    }
+    bool Write(const void *Buffer, size_t Size)
+    {
+        if (!Grow(Contentsize + Size)) return false;
+        if (Size) std::memcpy(Base + Contentsize, Buffer, Size);
+        Contentsize += Size;
+        return true;
+    }
+    bool Write(std::span<const uint8_t> Buffer) { return Write(Buffer.data(), Buffer.size()); }
+
+    // Buffers convert from any range, so only take them when passed as such.
+    template <std::derived_from<Bytebuffer_t> T> bool Write(const T &Buffer) { return Write(Buffer.data(), Buffer.size()); }
+
+    // Sets the logical size directly, for callers that fill data() themselves.
+    bool Resize(size_t Size)
+    {
+        if (!Grow(Size)) return false;
+        Contentsize = Size;
+        return true;
+    }
+
+    // Push dirty pages to disk, mostly useful before handing the file to another process.
+    bool Flush() const
+    {
+        if (!Base || !isWritable) return true;
+
+        #if defined (_WIN32)
+        return FlushViewOfFile(Base, Contentsize) && FlushFileBuffers(File);
+        #else
+        return msync(Base, Mappedsize, MS_SYNC) == 0;
+        #endif
+    }
+};
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Mappedfiletest()
+    {
+        const auto Path = std::filesystem::temp_directory_path() / "Mappedfiletest.bin";
+        size_t Headersize{};
+
+        {
+            auto Output = Mappedfile_t::Create(Path);
+            if (!Output) { std::printf("BROKEN: Mappedfile_t::Create\n"); return; }
+
+            Bytebuffer_t Header{};
+            Header.Write(uint32_t(0xDEADC0DE));
+            Header.Write(std::string("Mapped"));
+            Output.Write(Header);
+            Headersize = Header.size();
+
+            // Enough chunks to force several remaps.
+            std::vector<uint8_t> Chunk(10000);
+            for (size_t i = 0; i < 100; ++i)
+            {
+                std::ranges::fill(Chunk, uint8_t(i));
+                if (!Output.Write(Chunk)) { std::printf("BROKEN: Mappedfile_t::Write\n"); return; }
+            }
+        }
+
+        if (std::filesystem::file_size(Path) != 1000000 + Headersize) std::printf("BROKEN: Mappedfile_t trimming\n");
+
+        {
+            const Mappedfile_t Input(Path, Mappedfile_t::Access_t::Sequential);
+            if (!Input || Input.size() != 1000000 + Headersize) { std::printf("BROKEN: Mappedfile_t open\n"); return; }
+            Input.Prefetch(0, 4096);
+
+            auto Buffer = Input.as_buffer();
+            if (Buffer.isOwning() || Buffer.Read<uint32_t>() != 0xDEADC0DE || Buffer.Read<std::string>() != "Mapped")
+                std::printf("BROKEN: Mappedfile_t buffer\n");
+
+            const auto Blob = Input.as_blob();
+            if (Blob[Headersize] != 0 || Blob[Headersize + 55 * 10000 + 1] != 55 || Blob.back() != 99) std::printf("BROKEN: Mappedfile_t content\n");
+        }
+
+        {
+            // Empty files are valid, just with nothing mapped.
+            auto Truncated = Mappedfile_t::Create(Path);
+            Truncated.Close();
+
+            const Mappedfile_t Empty(Path);
+            if (!Empty || !Empty.empty() || Empty.as_buffer().size() != 0) std::printf("BROKEN: Mappedfile_t empty\n");
+        }
+
+        if (Mappedfile_t(Path.string() + ".missing")) std::printf("BROKEN: Mappedfile_t missing file\n");
+        std::filesystem::remove(Path);
+    }
+}
+#endif
@@ -7,13 +7,187 @@
 */
 
 #pragma once
+#include "../CPUID.hpp"
 #include "Bytebuffer.hpp"
 
+// Branchless LEB128, whole varints are assembled from 8-byte words rather than byte by byte.
+namespace Varint
+{
+    // Bytes needed for the value, 1 - 10.
+    constexpr size_t Size(uint64_t Value) noexcept
+    {
+        const size_t Bits = 64 - std::countl_zero(Value | 1);
+        return (Bits * 9 + 64) / 64;
+    }
+
+    // Negative values are sign-extended to 64 bits, as protobuf does.
+    template <std::integral T> constexpr uint64_t Widen(T Value) noexcept
+    {
+        if constexpr (std::is_signed_v<T>) return uint64_t(int64_t(Value));
+        else return uint64_t(Value);
+    }
+
+    // Spread 56 bits over the low 7 bits of each byte, and back.
+    constexpr uint64_t Spread(uint64_t Value) noexcept
+    {
+        Value = ((Value & 0x00FFFFFFF0000000ULL) << 4) | (Value & 0x000000000FFFFFFFULL);
+        Value = ((Value & 0x0FFFC0000FFFC000ULL) << 2) | (Value & 0x00003FFF00003FFFULL);
+        Value = ((Value & 0x3F803F803F803F80ULL) << 1) | (Value & 0x007F007F007F007FULL);
+        return Value;
+    }
+    constexpr uint64_t Compact(uint64_t Word) noexcept
+    {
+        Word = ((Word & 0x7F007F007F007F00ULL) >> 1) | (Word & 0x007F007F007F007FULL);
+        Word = ((Word & 0x3FFF00003FFF0000ULL) >> 2) | (Word & 0x00003FFF00003FFFULL);
+        Word = ((Word & 0x0FFFFFFF00000000ULL) >> 4) | (Word & 0x000000000FFFFFFFULL);
+        return Word;
+    }
+
+    // Output needs Size(Value) bytes, returns the same.
+    inline size_t Encode(uint64_t Value, uint8_t *Output) noexcept
+    {
+        const auto Length = Size(Value);
+
+        if (Length <= 8) [[likely]]
+        {
+            const auto Continuation = 0x8080808080808080ULL & ((1ULL << ((Length - 1) * 8)) - 1);
+            const auto Word = cmp::toLittle(Spread(Value) | Continuation);
+            std::memcpy(Output, &Word, Length);
+            return Length;
+        }
+
+        for (size_t i = 0; i < Length - 1; ++i) Output[i] = uint8_t(Value >> (i * 7)) | 0x80;
+        Output[Length - 1] = uint8_t(Value >> ((Length - 1) * 7));
+        return Length;
+    }
+
+    // As above, but stores a whole word so Output needs 10 writable bytes.
+    inline size_t Encodewide(uint64_t Value, uint8_t *Output) noexcept
+    {
+        const auto Length = Size(Value);
+        if (Length > 8) [[unlikely]] return Encode(Value, Output);
+
+        const auto Continuation = 0x8080808080808080ULL & ((1ULL << ((Length - 1) * 8)) - 1);
+        const auto Word = cmp::toLittle(Spread(Value) | Continuation);
+        std::memcpy(Output, &Word, sizeof(Word));
+        return Length;
+    }
+
+    // Returns the end of the varint, or nullptr if truncated.
+    inline const uint8_t *Decode(const uint8_t *Input, const uint8_t *End, uint64_t &Value) noexcept
+    {
+        if (End - Input >= 8) [[likely]]
+        {
+            uint64_t Word;
+            std::memcpy(&Word, Input, sizeof(Word));
+            Word = cmp::fromLittle(Word);
+
+            // Terminators have the MSB cleared.
+            if (const auto Stops = ~Word & 0x8080808080808080ULL) [[likely]]
+            {
+                const auto Length = (std::countr_zero(Stops) >> 3) + 1;
+                Value = Compact(Word & (~0ULL >> (64 - Length * 8)));
+                return Input + Length;
+            }
+        }
+
+        Value = 0;
+        for (size_t i = 0; i < 10 && Input < End; ++i)
+        {
+            const auto Byte = *Input++;
+            Value |= uint64_t(Byte & 0x7F) << (i * 7);
+            if (!(Byte & 0x80)) return Input;
+        }
+
+        return nullptr;
+    }
+
+    // Packed arrays, Masked-VByte style: one movemask gives the terminators for 16 bytes.
+    template <std::integral T> bool Decodeall(std::span<const uint8_t> Input, std::vector<T> &Output)
+    {
+        auto Data = Input.data();
+        const auto End = Data + Input.size();
+
+        // Every varint is at least a byte, so size for the worst case and trim after.
+        const auto Start = Output.size();
+        Output.resize(Start + Input.size());
+        auto Write = Output.data() + Start;
+        const auto Finish = [&](bool Result) { Output.resize(Result ? size_t(Write - Output.data()) : Start); return Result; };
+
+        #if defined(HAS_CPUID)
+        // Varints are read as whole words, so keep a word of slack past the block.
+        while (End - Data >= 24)
+        {
+            const auto Continuation = uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Data))));
+
+            // Common case of small values.
+            if (Continuation == 0)
+            {
+                for (size_t i = 0; i < 16; ++i) *Write++ = T(Data[i]);
+                Data += 16;
+                continue;
+            }
+
+            // Longer than any varint.
+            auto Stops = ~Continuation & 0xFFFF;
+            if (!Stops) [[unlikely]] return Finish(false);
+
+            // Every varint that terminates in this block, the last partial one carries over.
+            size_t Consumed = 0;
+            for (; Stops; Stops &= Stops - 1)
+            {
+                const size_t Next = std::countr_zero(Stops) + 1;
+                const auto Length = Next - Consumed;
+                if (Length > 8) [[unlikely]] break;
+
+                uint64_t Word;
+                std::memcpy(&Word, Data + Consumed, sizeof(Word));
+                *Write++ = T(Compact(cmp::fromLittle(Word) & (~0ULL >> (64 - Length * 8))));
+                Consumed = Next;
+            }
+            Data += Consumed;
+
+            // 9 and 10 byte varints go through the scalar path.
+            if (Stops)
+            {
+                uint64_t Value;
+                Data = Decode(Data, End, Value);
+                if (!Data) [[unlikely]] return Finish(false);
+                *Write++ = T(Value);
+            }
+        }
+        #endif
+
+        while (Data < End)
+        {
+            uint64_t Value;
+            Data = Decode(Data, End, Value);
+            if (!Data) return Finish(false);
+            *Write++ = T(Value);
+        }
+
+        return Finish(true);
+    }
+}
+
 // Might as well reuse some plumbing for basic protobuffer support.
 struct Protobuffer_t : Bytebuffer_t
 {
     enum class Wiretype_t : uint8_t { VARINT, I64, STRING /* LEN */, I32 = 5, INVALID = 255 };
     uint32_t CurrentID{}; Wiretype_t Currenttype{};
+    uint32_t Valueoffset{};
+
+    // One-pass index of the message, built lazily on the first out-of-order Seek.
+    // Sorted by ID and then position, so repeated fields keep their order.
+    struct Field_t { uint32_t ID; uint32_t Offset; Wiretype_t Type; };
+    static constexpr uint32_t Maxdirect = 1024;
+    std::vector<Field_t> Fieldindex{};
+    std::vector<uint32_t> Directindex{};
+    bool Indexed{};
+
+    // Tags before Scanoffset have been decoded and their IDs were strictly ascending, the last being ScanID.
+    // So the first match past it is also the first occurrence, which is what the index would return.
+    uint32_t Scanoffset{}, ScanID{};
 
     // Inherit constructors.
     using Bytebuffer_t::Bytebuffer_t;
@@ -22,12 +196,52 @@ struct Protobuffer_t : Bytebuffer_t
     explicit Protobuffer_t(const Protobuffer_t &Other) noexcept : Bytebuffer_t(Other)
     {
         Currenttype = Other.Currenttype;
+        Valueoffset = Other.Valueoffset;
         CurrentID = Other.CurrentID;
     }
-    Protobuffer_t(Protobuffer_t &&Other) noexcept : Bytebuffer_t(Other)
+    Protobuffer_t(Protobuffer_t &&Other) noexcept : Bytebuffer_t(std::move(Other))
     {
         Currenttype = Other.Currenttype;
+        Valueoffset = Other.Valueoffset;
         CurrentID = Other.CurrentID;
+
+        Fieldindex = std::move(Other.Fieldindex);
+        Directindex = std::move(Other.Directindex);
+        Indexed = std::exchange(Other.Indexed, false);
+        Scanoffset = std::exchange(Other.Scanoffset, 0);
+        ScanID = std::exchange(Other.ScanID, 0);
+    }
+
+    // Rewinding starts over from a clean state, and anything that touches the contents has to drop the index and the scan.
+    void Invalidate() noexcept
+    {
+        Indexed = false;
+        Scanoffset = ScanID = 0;
+    }
+    void Rewind() noexcept
+    {
+        Invalidate();
+        Bytebuffer_t::Rewind();
+    }
+    void rawWrite(size_t Size, const void *Buffer = nullptr)
+    {
+        Invalidate();
+        Bytebuffer_t::rawWrite(Size, Buffer);
+    }
+    [[nodiscard]] uint8_t *rawReserve(size_t Size)
+    {
+        Invalidate();
+        return Bytebuffer_t::rawReserve(Size);
+    }
+    void Expandbuffer(size_t Extracapacity)
+    {
+        Invalidate();
+        Bytebuffer_t::Expandbuffer(Extracapacity);
+    }
+    void Shrink(size_t Unused) noexcept
+    {
+        Invalidate();
+        Bytebuffer_t::Shrink(Unused);
     }
 
     // Encode as little endian.
@@ -41,28 +255,8 @@ struct Protobuffer_t : Bytebuffer_t
     }
     template <std::integral T> void EncodeVARINT(T Input)
     {
-        std::array<uint8_t, 10> Buffer{};
-        uint8_t Size = 0;
-
-        // Little endian needed.
-        Input = cmp::toLittle(Input);
-
-        for (; Size < 10; Size++)
-        {
-            if (!Input) break;
-
-            // MSB = continuation.
-            Buffer[Size] = (Input & 0x7F) | 0x80;
-            Input >>= 7;
-        }
-
-        // Need at least 1 byte.
-        if (Size == 0) Size = 1;
-
-        // Clear MSB.
-        Buffer[Size - 1] &= 0x7F;
-
-        rawWrite(Size, Buffer.data());
+        const auto Value = Varint::Widen(Input);
+        (void)Varint::Encode(Value, rawReserve(Varint::Size(Value)));
     }
     void EncodeSTRING(const std::u8string &Input)
     {
@@ -84,20 +278,19 @@ struct Protobuffer_t : Bytebuffer_t
     uint64_t DecodeVARINT()
     {
         uint64_t Value{};
+        if (!size(true)) [[unlikely]] return Value;
 
-        for (uint8_t i = 0; i < 10; ++i)
-        {
-            Value <<= 7;
-
-            const auto Byte = Bytebuffer_t::Read<uint8_t>(false);
-            Value |= (Byte & 0x7F);
-
-            // No continuation bit.
-            if (!(Byte & 0x80))
-                break;
-        }
+        const auto Data = data() + Internaliterator;
+        const auto Next = Varint::Decode(Data, data() + size(), Value);
 
-        return cmp::fromLittle(Value);
+        // Truncated varints consume the rest of the buffer.
+        Internaliterator = Next ? uint32_t(Internaliterator + (Next - Data)) : Internalsize;
+        return Value;
+    }
+    void SkipSTRING()
+    {
+        const auto Length = DecodeVARINT();
+        rawRead(size_t(std::min<uint64_t>(Length, size(true))));
     }
     std::u8string DecodeSTRING()
     {
@@ -140,39 +333,120 @@ struct Protobuffer_t : Bytebuffer_t
         return { uint32_t(Tag >> 3), Wiretype_t(Tag & 7) };
     }
 
-    // Seek tags.
-    bool Seek(uint32_t ID)
+    // Skip the data of the current field.
+    void Skipvalue(Wiretype_t Type)
     {
-        // Early exit.
-        if (ID == CurrentID && ID != 0)
-            return true;
+        switch (Type)
+        {
+            case Wiretype_t::VARINT: { (void)DecodeVARINT(); break; }
+            case Wiretype_t::STRING: { SkipSTRING(); break; }
+            case Wiretype_t::I64:    { rawRead(sizeof(uint64_t)); break; }
+            case Wiretype_t::I32:    { rawRead(sizeof(uint32_t)); break; }
+            default: break;
+        }
+    }
+
+    // Decode every tag once, then lookups are O(1) for small IDs or O(log n) otherwise.
+    void Buildindex()
+    {
+        const auto Savediterator = Internaliterator;
+        Fieldindex.clear();
+        Directindex.clear();
 
-        // Seek from begining.
-        if (ID < CurrentID)
+        Bytebuffer_t::Seek(0, SEEK_SET);
+        while (size(true))
         {
-            CurrentID = 0;
+            const auto [ID, Type] = DecodeTAG();
+            if (Wiretype_t::INVALID == Type) [[unlikely]] break;
 
-            Bytebuffer_t::Seek(0, SEEK_SET);
-            return Seek(ID);
+            Fieldindex.push_back({ ID, uint32_t(Internaliterator), Type });
+            Skipvalue(Type);
         }
 
-        // Seek forward.
-        while(true)
+        std::ranges::stable_sort(Fieldindex, {}, &Field_t::ID);
+
+        if (!Fieldindex.empty() && Fieldindex.back().ID < Maxdirect)
+        {
+            Directindex.resize(Fieldindex.back().ID + 1, UINT32_MAX);
+            for (size_t i = Fieldindex.size(); i-- > 0;) Directindex[Fieldindex[i].ID] = uint32_t(i);
+        }
+
+        Internaliterator = Savediterator;
+        Indexed = true;
+    }
+    [[nodiscard]] const Field_t *Findfield(uint32_t ID, size_t Occurrence = 0)
+    {
+        if (!Indexed) Buildindex();
+
+        size_t First;
+        if (!Directindex.empty())
+        {
+            if (ID >= Directindex.size() || Directindex[ID] == UINT32_MAX) return nullptr;
+            First = Directindex[ID];
+        }
+        else
         {
-            std::tie(CurrentID, Currenttype) = DecodeTAG();
+            First = std::ranges::lower_bound(Fieldindex, ID, {}, &Field_t::ID) - Fieldindex.begin();
+        }
 
-            if (Wiretype_t::INVALID == Currenttype) [[unlikely]] return false;
-            if (ID == CurrentID) [[unlikely]] return true;
+        const auto Index = First + Occurrence;
+        if (Index >= Fieldindex.size() || Fieldindex[Index].ID != ID) return nullptr;
+        return &Fieldindex[Index];
+    }
 
-            // Skip the data.
-            switch (Currenttype)
+    // How many times a (repeated) field occurs.
+    [[nodiscard]] size_t Count(uint32_t ID)
+    {
+        size_t Result = 0;
+        while (Findfield(ID, Result)) ++Result;
+        return Result;
+    }
+
+    // Seek tags, positions the iterator at the value.
+    bool Seek(uint32_t ID, size_t Occurrence = 0)
+    {
+        // Ascending reads of an ascending message can just scan forward, anything else goes through the index.
+        if (!Indexed && Occurrence == 0 && ID > ScanID)
+        {
+            Internaliterator = Scanoffset;
+            while (size(true))
             {
-                case Wiretype_t::VARINT: { (void)DecodeVARINT(); break; }
-                case Wiretype_t::STRING: { (void)DecodeSTRING(); break; }
-                case Wiretype_t::I64:    { (void)DecodeI64(); break; }
-                case Wiretype_t::I32:    { (void)DecodeI32(); break; }
+                const auto Tagoffset = uint32_t(Internaliterator);
+                const auto [TagID, Type] = DecodeTAG();
+
+                // Out of order or repeated, so earlier occurrences may exist.
+                if (Wiretype_t::INVALID == Type || TagID <= ScanID) [[unlikely]] break;
+
+                // Stay on the tag so that re-reading it is a single decode.
+                if (ID == TagID)
+                {
+                    Scanoffset = Tagoffset;
+                    CurrentID = TagID;
+                    Currenttype = Type;
+                    Valueoffset = uint32_t(Internaliterator);
+                    return true;
+                }
+
+                // Passed where it would have been.
+                if (TagID > ID) break;
+
+                ScanID = TagID;
+                Skipvalue(Type);
+                Scanoffset = uint32_t(Internaliterator);
             }
         }
+
+        const auto Field = Findfield(ID, Occurrence);
+        if (!Field) [[unlikely]]
+        {
+            CurrentID = 0;
+            return false;
+        }
+
+        CurrentID = Field->ID;
+        Currenttype = Field->Type;
+        Valueoffset = Internaliterator = Field->Offset;
+        return true;
     }
 
     // Typed IO, need explicit type when writing, tries to convert when reading.
@@ -191,18 +465,21 @@ struct Protobuffer_t : Bytebuffer_t
             return;
         }
 
+        // Appending invalidates the index.
+        Invalidate();
+
         EncodeTAG(ID, Type);
-        if (Type == Wiretype_t::VARINT) EncodeVARINT(Value);
-        if (Type == Wiretype_t::STRING) EncodeSTRING(Value);
-        if (Type == Wiretype_t::I64) EncodeI64(Value);
-        if (Type == Wiretype_t::I32) EncodeI32(Value);
+        if constexpr (requires { EncodeVARINT(Value); }) if (Type == Wiretype_t::VARINT) EncodeVARINT(Value);
+        if constexpr (requires { EncodeSTRING(Value); }) if (Type == Wiretype_t::STRING) EncodeSTRING(Value);
+        if constexpr (requires { EncodeI64(Value); }) if (Type == Wiretype_t::I64) EncodeI64(Value);
+        if constexpr (requires { EncodeI32(Value); }) if (Type == Wiretype_t::I32) EncodeI32(Value);
     }
-    template <typename Type> bool Read(Type &Buffer, uint32_t ID)
+    template <typename Type> bool Read(Type &Buffer, uint32_t ID, size_t Occurrence = 0)
     {
         // Lookup ID.
-        if (!Seek(ID))
+        if (!Seek(ID, Occurrence))
         {
-            Errorprint(va("Protobuf tag %u not found", ID));
+            Errorprint(va_view("Protobuf tag %u not found", ID));
             return false;
         }
 
@@ -212,7 +489,7 @@ struct Protobuffer_t : Bytebuffer_t
             else if constexpr (std::is_floating_point_v<Type>) Buffer = (Type)DecodeVARINT();
             else
             {
-                Debugprint(va("Error: Protobuf tag %u type is VARINT", ID));
+                Debugprint(va_view("Error: Protobuf tag %u type is VARINT", ID));
                 return false;
             }
 
@@ -228,7 +505,7 @@ struct Protobuffer_t : Bytebuffer_t
             }
             else
             {
-                Debugprint(va("Error: Protobuf tag %u type is I64", ID));
+                Debugprint(va_view("Error: Protobuf tag %u type is I64", ID));
                 return false;
             }
         }
@@ -242,7 +519,7 @@ struct Protobuffer_t : Bytebuffer_t
             }
             else
             {
-                Debugprint(va("Error: Protobuf tag %u type is I32", ID));
+                Debugprint(va_view("Error: Protobuf tag %u type is I32", ID));
                 return false;
             }
         }
@@ -258,7 +535,7 @@ struct Protobuffer_t : Bytebuffer_t
                 else if constexpr (std::is_same_v<Type, Blob_t>) Buffer = { String.begin(), String.end() };
                 else
                 {
-                    Debugprint(va("Error: Protobuf tag %u type is LEN, but could not convert it?", ID));
+                    Debugprint(va_view("Error: Protobuf tag %u type is LEN, but could not convert it?", ID));
                     return false;
                 }
 
@@ -266,7 +543,7 @@ struct Protobuffer_t : Bytebuffer_t
             }
             else
             {
-                Debugprint(va("Error: Protobuf tag %u type is LEN", ID));
+                Debugprint(va_view("Error: Protobuf tag %u type is LEN", ID));
                 return false;
             }
         }
@@ -285,4 +562,176 @@ struct Protobuffer_t : Bytebuffer_t
         Read(Result, ID);
         return Result;
     }
+
+    // All occurrences of a repeated field.
+    template <typename Type> std::vector<Type> Readrepeated(uint32_t ID)
+    {
+        std::vector<Type> Result(Count(ID));
+        for (size_t i = 0; i < Result.size(); ++i) Read(Result[i], ID, i);
+        return Result;
+    }
+
+    // Packed repeated fields, one LEN field holding the concatenated varints.
+    template <std::ranges::contiguous_range Range> requires std::integral<std::ranges::range_value_t<Range>>
+    void WritePacked(const Range &Values, uint32_t ID)
+    {
+        // Appending invalidates the index.
+        Invalidate();
+
+        size_t Total{};
+        for (const auto &Item : Values) Total += Varint::Size(Varint::Widen(Item));
+
+        EncodeTAG(ID, Wiretype_t::STRING);
+        EncodeVARINT(Total);
+
+        // Slack for the last word-sized store.
+        const auto Needed = Internaliterator + Total + 10;
+        if (Needed > capacity()) reserve(std::max<size_t>(Needed, capacity() * 2));
+
+        auto Output = rawReserve(Total);
+        for (const auto &Item : Values) Output += Varint::Encodewide(Varint::Widen(Item), Output);
+    }
+
+    // Accepts both packed and unpacked encodings, the field may also be split over multiple occurrences.
+    template <std::integral Type> bool ReadPacked(std::vector<Type> &Buffer, uint32_t ID)
+    {
+        Buffer.clear();
+
+        size_t Occurrence = 0;
+        for (; Seek(ID, Occurrence); ++Occurrence)
+        {
+            if (Currenttype == Wiretype_t::VARINT)
+            {
+                Buffer.push_back(Type(DecodeVARINT()));
+                continue;
+            }
+
+            if (Currenttype != Wiretype_t::STRING) [[unlikely]]
+            {
+                Debugprint(va_view("Error: Protobuf tag %u is not a packed field", ID));
+                return false;
+            }
+
+            const auto Length = DecodeVARINT();
+            if (Length > size(true)) [[unlikely]] return false;
+
+            if (!Varint::Decodeall(std::span(data() + Internaliterator, size_t(Length)), Buffer)) [[unlikely]]
+            {
+                Debugprint(va_view("Error: Protobuf tag %u has a malformed varint", ID));
+                return false;
+            }
+
+            Internaliterator += uint32_t(Length);
+        }
+
+        if (Occurrence == 0) { Errorprint(va_view("Protobuf tag %u not found", ID)); }
+        return Occurrence != 0;
+    }
+    template <std::integral Type> std::vector<Type> ReadPacked(uint32_t ID)
+    {
+        std::vector<Type> Result{};
+        ReadPacked(Result, ID);
+        return Result;
+    }
 };
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    static_assert(Varint::Size(0) == 1 && Varint::Size(127) == 1 && Varint::Size(128) == 2 && Varint::Size(UINT64_MAX) == 10, "BROKEN: Varint sizing");
+    static_assert(Varint::Compact(Varint::Spread(0x00DEADBEEFCAFE42ULL)) == 0x00DEADBEEFCAFE42ULL, "BROKEN: Varint packing");
+
+    inline void Protobuffertest()
+    {
+        Protobuffer_t Buffer{};
+
+        // Enough fields for two-byte tags, with a repeated one in the middle.
+        for (uint32_t ID = 1; ID <= 40; ++ID)
+        {
+            Buffer.Write(uint64_t(ID * 1000), Protobuffer_t::Wiretype_t::VARINT, ID);
+            if (ID == 20) Buffer.Write(uint64_t(7), Protobuffer_t::Wiretype_t::VARINT, 20);
+        }
+
+        Buffer.Rewind();
+        if (40000 != Buffer.Read<uint64_t>(40)) std::printf("BROKEN: Protobuffer reading\n");
+        if (3000 != Buffer.Read<uint64_t>(3)) std::printf("BROKEN: Protobuffer out-of-order reading\n");
+        if (3000 != Buffer.Read<uint64_t>(3)) std::printf("BROKEN: Protobuffer re-reading\n");
+        if (Buffer.Readrepeated<uint64_t>(20) != std::vector<uint64_t>{ 20000, 7 }) std::printf("BROKEN: Protobuffer repeated fields\n");
+        if (Buffer.Seek(41)) std::printf("BROKEN: Protobuffer missing field\n");
+
+        // The forward scan has to agree with the index on which occurrence comes first.
+        Protobuffer_t Unordered{};
+        Unordered.Write(uint64_t(1), Protobuffer_t::Wiretype_t::VARINT, 5);
+        Unordered.Write(uint64_t(2), Protobuffer_t::Wiretype_t::VARINT, 3);
+        Unordered.Write(uint64_t(3), Protobuffer_t::Wiretype_t::VARINT, 5);
+        Unordered.Rewind();
+        if (Unordered.Read<uint64_t>(3) != 2 || Unordered.Read<uint64_t>(5) != 1) std::printf("BROKEN: Protobuffer scan occurrence\n");
+
+        // Appending after a read is seen by the next one.
+        Unordered.Bytebuffer_t::Seek(0, SEEK_END);
+        Unordered.Write(uint64_t(4), Protobuffer_t::Wiretype_t::VARINT, 9);
+        Unordered.Rewind();
+        if (Unordered.Read<uint64_t>(9) != 4 || Unordered.Readrepeated<uint64_t>(5) != std::vector<uint64_t>{ 1, 3 }) std::printf("BROKEN: Protobuffer index invalidation\n");
+
+        // Every length, including the 10 byte negatives.
+        std::vector<int64_t> Values{};
+        for (int64_t i = 0; i < 4096; ++i) Values.push_back((i % 3) ? (i * 0x9E3779B97F4A7C15LL) >> (i % 64) : i % 200);
+
+        Protobuffer_t Packed{};
+        Packed.Write(uint64_t(300), Protobuffer_t::Wiretype_t::VARINT, 1);
+        Packed.WritePacked(std::span(Values), 2);
+        Packed.WritePacked(std::span(Values).first(7), 2);
+
+        // Canonical encoding of 300.
+        if (Packed.data()[1] != 0xAC || Packed.data()[2] != 0x02) std::printf("BROKEN: Protobuffer varint encoding\n");
+
+        Packed.Rewind();
+        auto Decoded = Packed.ReadPacked<int64_t>(2);
+        if (Decoded.size() != Values.size() + 7 || !std::equal(Values.begin(), Values.end(), Decoded.begin()))
+            std::printf("BROKEN: Protobuffer packed fields\n");
+
+        // Unpacked repeated fields are accepted too.
+        if (Buffer.ReadPacked<uint64_t>(20) != std::vector<uint64_t>{ 20000, 7 }) std::printf("BROKEN: Protobuffer packed fallback\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void Protobufferbenchmark()
+    {
+        const auto Encode = []()
+        {
+            Protobuffer_t Buffer{};
+            for (uint32_t ID = 1; ID <= 64; ++ID)
+            {
+                Buffer.Write(uint64_t(ID * 0x9E3779B97F4A7C15ULL >> (ID % 64)), Protobuffer_t::Wiretype_t::VARINT, ID);
+                if (ID % 4 == 0) Buffer.Write("Some string payload"s, Protobuffer_t::Wiretype_t::STRING, ID + 100);
+            }
+            return Buffer;
+        };
+
+        // Descending field order, so every read after the first is behind the forward scan and goes through the index.
+        const auto Encoded = Encode();
+        const auto Decode = [&]()
+        {
+            Protobuffer_t Buffer(Encoded);
+            uint64_t Sum{};
+            for (uint32_t ID = 64; ID >= 1; --ID) Sum += Buffer.Read<uint64_t>(ID);
+            return Sum;
+        };
+
+        Measure("Protobuffer_t encode (64 fields)", Encoded.size(), [&]() { Keep(Encode()); });
+        Measure("Protobuffer_t decode (64 fields)", Encoded.size(), [&]() { Keep(Decode()); });
+
+        std::vector<uint32_t> Values(4096);
+        for (size_t i = 0; i < Values.size(); ++i) Values[i] = uint32_t(i * 2654435761U) >> (i % 32);
+
+        Protobuffer_t Packed{};
+        Packed.WritePacked(std::span(Values), 1);
+        Measure("Protobuffer_t WritePacked (4096 varints)", Packed.size(), [&]() { Protobuffer_t Buffer{}; Buffer.WritePacked(std::span(Values), 1); Keep(Buffer); });
+        Measure("Protobuffer_t ReadPacked (4096 varints)", Packed.size(), [&]() { Packed.Rewind(); Keep(Packed.ReadPacked<uint32_t>(1)); });
+    }
+}
+#endif
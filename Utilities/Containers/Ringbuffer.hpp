@@ -4,11 +4,16 @@
     License: MIT
 
     Fixed capacity container that overwrites the last element as needed.
+    Spscring_t / Mpmcring_t are the thread-safe variants for passing data between threads.
 */
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <cstdint>
 
 #include "Python.hpp"
@@ -105,6 +110,215 @@ struct Ringbuffer_t
     }
 };
 
+// Separate the producer and consumer indices to avoid false sharing.
+namespace Internal { constexpr size_t Cacheline = 64; }
+
+// Wait-free single producer, single consumer queue. Each side caches the others index to avoid touching its line.
+template <typename T, size_t N> requires (N > 1 && std::has_single_bit(N))
+struct Spscring_t
+{
+    static constexpr size_t Mask = N - 1;
+
+    alignas(Internal::Cacheline) std::atomic<size_t> Head{};
+    size_t Cachedtail{};
+
+    alignas(Internal::Cacheline) std::atomic<size_t> Tail{};
+    size_t Cachedhead{};
+
+    alignas(Internal::Cacheline) std::array<T, N> Storage{};
+
+    // Approximate if called while the other side is active, Head goes first so that Tail can't be behind it.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        const auto Dequeued = Head.load(std::memory_order_acquire);
+        const auto Enqueued = Tail.load(std::memory_order_acquire);
+        return std::min(Enqueued - Dequeued, N);
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    // Producer side.
+    template <typename... Args> bool try_emplace(Args&&... args) noexcept
+    {
+        const auto Current = Tail.load(std::memory_order_relaxed);
+        if (Current - Cachedhead == N)
+        {
+            Cachedhead = Head.load(std::memory_order_acquire);
+            if (Current - Cachedhead == N) return false;
+        }
+
+        Storage[Current & Mask] = T{ std::forward<Args>(args)... };
+        Tail.store(Current + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(const T &Value) noexcept { return try_emplace(Value); }
+    bool try_push(T &&Value) noexcept { return try_emplace(std::move(Value)); }
+
+    // Publishes the whole batch at once, returns how many fit.
+    size_t push_batch(std::span<const T> Values) noexcept
+    {
+        const auto Current = Tail.load(std::memory_order_relaxed);
+        if (N - (Current - Cachedhead) < Values.size()) Cachedhead = Head.load(std::memory_order_acquire);
+
+        const auto Count = std::min(Values.size(), N - (Current - Cachedhead));
+        for (size_t i = 0; i < Count; ++i) Storage[(Current + i) & Mask] = Values[i];
+
+        Tail.store(Current + Count, std::memory_order_release);
+        return Count;
+    }
+
+    // Consumer side.
+    bool try_pop(T &Value) noexcept
+    {
+        const auto Current = Head.load(std::memory_order_relaxed);
+        if (Current == Cachedtail)
+        {
+            Cachedtail = Tail.load(std::memory_order_acquire);
+            if (Current == Cachedtail) return false;
+        }
+
+        Value = std::move(Storage[Current & Mask]);
+        Head.store(Current + 1, std::memory_order_release);
+        return true;
+    }
+    [[nodiscard]] std::optional<T> try_pop() noexcept
+    {
+        T Value;
+        if (!try_pop(Value)) return std::nullopt;
+        return Value;
+    }
+    size_t pop_batch(std::span<T> Values) noexcept
+    {
+        const auto Current = Head.load(std::memory_order_relaxed);
+        if (Cachedtail - Current < Values.size()) Cachedtail = Tail.load(std::memory_order_acquire);
+
+        const auto Count = std::min(Values.size(), Cachedtail - Current);
+        for (size_t i = 0; i < Count; ++i) Values[i] = std::move(Storage[(Current + i) & Mask]);
+
+        Head.store(Current + Count, std::memory_order_release);
+        return Count;
+    }
+
+    // Overwriting would need the producer to consume, use Mpmcring_t::push_overwrite for that.
+};
+
+// Bounded multi producer, multi consumer queue (Vyukov) where each slot carries a sequence number.
+template <typename T, size_t N> requires (N > 1 && std::has_single_bit(N))
+struct Mpmcring_t
+{
+    static constexpr size_t Mask = N - 1;
+
+    // Sequence == Index when free for the producer of that lap, Index + 1 once readable.
+    struct Cell_t
+    {
+        std::atomic<size_t> Sequence;
+        T Value;
+    };
+
+    alignas(Internal::Cacheline) std::atomic<size_t> Enqueue{};
+    alignas(Internal::Cacheline) std::atomic<size_t> Dequeue{};
+    alignas(Internal::Cacheline) std::array<Cell_t, N> Cells;
+
+    Mpmcring_t() noexcept
+    {
+        for (size_t i = 0; i < N; ++i) Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Approximate if called while others are active.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        const auto Tail = Enqueue.load(std::memory_order_acquire), Head = Dequeue.load(std::memory_order_acquire);
+        return Tail > Head ? std::min(Tail - Head, N) : 0;
+    }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    template <typename... Args> bool try_emplace(Args&&... args) noexcept
+    {
+        auto Position = Enqueue.load(std::memory_order_relaxed);
+        Cell_t *Cell;
+
+        while (true)
+        {
+            Cell = &Cells[Position & Mask];
+            const auto Sequence = Cell->Sequence.load(std::memory_order_acquire);
+            const auto Delta = intptr_t(Sequence) - intptr_t(Position);
+
+            // Free slot, try to claim it.
+            if (Delta == 0)
+            {
+                if (Enqueue.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed)) break;
+            }
+
+            // Still holds the previous laps value, so we are full.
+            else if (Delta < 0) return false;
+
+            // Someone else claimed it.
+            else Position = Enqueue.load(std::memory_order_relaxed);
+        }
+
+        Cell->Value = T{ std::forward<Args>(args)... };
+        Cell->Sequence.store(Position + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(const T &Value) noexcept { return try_emplace(Value); }
+    bool try_push(T &&Value) noexcept { return try_emplace(std::move(Value)); }
+
+    bool try_pop(T &Value) noexcept
+    {
+        auto Position = Dequeue.load(std::memory_order_relaxed);
+        Cell_t *Cell;
+
+        while (true)
+        {
+            Cell = &Cells[Position & Mask];
+            const auto Sequence = Cell->Sequence.load(std::memory_order_acquire);
+            const auto Delta = intptr_t(Sequence) - intptr_t(Position + 1);
+
+            if (Delta == 0)
+            {
+                if (Dequeue.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed)) break;
+            }
+            else if (Delta < 0) return false;
+            else Position = Dequeue.load(std::memory_order_relaxed);
+        }
+
+        Value = std::move(Cell->Value);
+        Cell->Sequence.store(Position + N, std::memory_order_release);
+        return true;
+    }
+    [[nodiscard]] std::optional<T> try_pop() noexcept
+    {
+        T Value;
+        if (!try_pop(Value)) return std::nullopt;
+        return Value;
+    }
+
+    // Slots are claimed one at a time, so batches may interleave with other producers.
+    size_t push_batch(std::span<const T> Values) noexcept
+    {
+        size_t Count{};
+        while (Count < Values.size() && try_push(Values[Count])) ++Count;
+        return Count;
+    }
+    size_t pop_batch(std::span<T> Values) noexcept
+    {
+        size_t Count{};
+        while (Count < Values.size() && try_pop(Values[Count])) ++Count;
+        return Count;
+    }
+
+    // Same semantics as Ringbuffer_t::push_back, the oldest element is dropped when full.
+    void push_overwrite(const T &Value) noexcept
+    {
+        while (!try_push(Value))
+        {
+            T Discarded;
+            (void)try_pop(Discarded);
+        }
+    }
+};
+
 #if defined(ENABLE_UNITTESTS)
 namespace Unittests
 {
@@ -129,6 +343,42 @@ namespace Unittests
 
         if (Rangetest != std::array{ 2, 3, 4, 4, 3, 2 })
             std::printf("BROKEN: Ringbuffer ranges\n");
+
+        // Concurrent producers and consumers, every value has to arrive exactly once.
+        {
+            constexpr size_t Count = 20000;
+            auto SPSC = std::make_unique<Spscring_t<size_t, 64>>();
+            auto MPMC = std::make_unique<Mpmcring_t<size_t, 64>>();
+            std::atomic<size_t> Sum{}, Received{};
+
+            std::thread Producer([&]() { for (size_t i = 1; i <= Count; ++i) while (!SPSC->try_push(i)) std::this_thread::yield(); });
+            size_t Last{}, Value{};
+            while (Last != Count)
+            {
+                if (!SPSC->try_pop(Value)) { std::this_thread::yield(); continue; }
+                if (Value != Last + 1) break;
+                Last = Value;
+            }
+            Producer.join();
+
+            if (Last != Count) std::printf("BROKEN: Spscring ordering\n");
+
+            std::vector<std::jthread> Threads;
+            for (size_t t = 0; t < 2; ++t)
+            {
+                Threads.emplace_back([&, t]() { for (size_t i = t; i < Count; i += 2) while (!MPMC->try_push(i)) std::this_thread::yield(); });
+                Threads.emplace_back([&]() { size_t Item; while (Received < Count) if (MPMC->try_pop(Item)) { Sum += Item; ++Received; } else std::this_thread::yield(); });
+            }
+            Threads.clear();
+
+            if (Sum != Count * (Count - 1) / 2) std::printf("BROKEN: Mpmcring delivery\n");
+
+            // Overwrite keeps the newest elements.
+            Mpmcring_t<int, 4> Small;
+            for (int i = 0; i < 6; ++i) Small.push_overwrite(i);
+            std::array<int, 8> Output{};
+            if (4 != Small.pop_batch(Output) || Output[0] != 2 || Output[3] != 5) std::printf("BROKEN: Mpmcring overwrite\n");
+        }
     }
 }
 #endif
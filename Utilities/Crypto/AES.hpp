@@ -33,12 +33,19 @@ namespace AES
         AES_CTR_128BE,
         AES_CTR_128LE,
 
+        // Authenticated, 96-bit IV and 32-bit big-endian counter.
+        AES_GCM,
+
         // Last unique mode.
         AES_MAX,
 
         // Aliases for default modes.
         AES_CTR = AES_CTR_32BE
     };
+
+    // Counter layout for the CTR modes.
+    template <Mode_t Mode> constexpr size_t Countersize_v = (Mode == AES_CTR_32BE || Mode == AES_CTR_32LE) ? 32 : (Mode == AES_CTR_64BE || Mode == AES_CTR_64LE) ? 64 : 128;
+    template <Mode_t Mode> constexpr bool Bigendian_v = (Mode == AES_CTR_32BE || Mode == AES_CTR_64BE || Mode == AES_CTR_128BE);
 }
 
 namespace AES::Implementation
@@ -489,6 +496,36 @@ namespace AES::Implementation
         {
             return _mm_xor_si128(A, B);
         }
+        inline Block_t Byteswap(const Block_t &Value)
+        {
+            return _mm_shuffle_epi8(Value, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        }
+
+        // Increment the counter for the next round, 32/64 bit counters wrap within their lane.
+        template <size_t Countersize, bool Bigendian> inline Block_t Increment(const Block_t &Input)
+        {
+            if constexpr (Countersize == 32 || Countersize == 64)
+            {
+                const auto Add = [](const Block_t &Value)
+                {
+                    if constexpr (Countersize == 32) return _mm_add_epi32(Value, _mm_setr_epi32(1, 0, 0, 0));
+                    else return _mm_add_epi64(Value, _mm_set_epi64x(0, 1));
+                };
+
+                if constexpr (Bigendian) return Byteswap(Add(Byteswap(Input)));
+                else return Add(Input);
+            }
+            else
+            {
+                auto NC = std::bit_cast<std::array<uint8_t, 16>>(Input);
+
+                // Only carry while the byte wraps.
+                for (uint8_t i = 0; i < 16; ++i)
+                    if (++NC[Bigendian ? 15 - i : i] != 0) break;
+
+                return std::bit_cast<Block_t>(NC);
+            }
+        }
         inline Block_t Mul128(const Block_t &Value)
         {
             Block_t Result{ Value };
@@ -550,29 +587,13 @@ namespace AES::Implementation
         template <uint8_t Rounds, size_t Countersize, bool Bigendian> constexpr Block_t Encryptblock_CTR(Block_t &State, const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
         {
             const auto Temp = XOR(Input, Encryptblock<Rounds>(State, Keys));
-            auto NC = std::bit_cast<std::array<uint8_t, 16>>(State);
-
-            // Increment the counter for the nex round.
-            if constexpr (Bigendian)
-            {
-                NC[15] += 1;
-                for (uint8_t i = 0; i < (Countersize / 8); ++i)
-                    if (NC[15 - i] == 0) NC[14 - i] += 1;
-            }
-            else
-            {
-                NC[0] += 1;
-                for (uint8_t i = 0; i < (Countersize / 8); ++i)
-                    if (NC[i] == 0) NC[i + 1] += 1;
-            }
-
-            State = std::bit_cast<Block_t>(NC);
+            State = Increment<Countersize, Bigendian>(State);
             return Temp;
         }
-        template <uint8_t Rounds> constexpr Block_t Decryptblock_CTR(Block_t &State, const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
+        template <uint8_t Rounds, size_t Countersize, bool Bigendian> constexpr Block_t Decryptblock_CTR(Block_t &State, const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
         {
             // CTR just runs the same operation again to decrypt.
-            return Encryptblock_CTR<Rounds>(State, Input, Keys);
+            return Encryptblock_CTR<Rounds, Countersize, Bigendian>(State, Input, Keys);
         }
 
         // State = Block
@@ -614,6 +635,18 @@ namespace AES::Implementation
             return Result;
         }
 
+        // Increment the counter for the next round.
+        template <size_t Countersize, bool Bigendian> constexpr Block_t Increment(const Block_t &Input)
+        {
+            auto NC = std::bit_cast<std::array<uint8_t, 16>>(Input);
+
+            // Only carry while the byte wraps.
+            for (uint8_t i = 0; i < (Countersize / 8); ++i)
+                if (++NC[Bigendian ? 15 - i : i] != 0) break;
+
+            return std::bit_cast<Block_t>(NC);
+        }
+
         // No initial vector, unsafe.
         template <uint8_t Rounds> constexpr Block_t Encryptblock_ECB(const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
         {
@@ -656,23 +689,7 @@ namespace AES::Implementation
         template <uint8_t Rounds, size_t Countersize, bool Bigendian> constexpr Block_t Encryptblock_CTR(Block_t &State, const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
         {
             const auto Temp = XOR(Input, Encryptblock<Rounds>(State, Keys));
-            auto NC = std::bit_cast<std::array<uint8_t, 16>>(State);
-
-            // Increment the counter for the nex round.
-            if constexpr (Bigendian)
-            {
-                NC[15] += 1;
-                for (uint8_t i = 0; i < (Countersize / 8); ++i)
-                    if (NC[15 - i] == 0) NC[14 - i] += 1;
-            }
-            else
-            {
-                NC[0] += 1;
-                for (uint8_t i = 0; i < (Countersize / 8); ++i)
-                    if (NC[i] == 0) NC[i + 1] += 1;
-            }
-
-            State = std::bit_cast<Block_t>(NC);
+            State = Increment<Countersize, Bigendian>(State);
             return Temp;
         }
         template <uint8_t Rounds, size_t Countersize, bool Bigendian> constexpr Block_t Decryptblock_CTR(Block_t &State, const Block_t &Input, const std::array<Block_t, Rounds + 1> &Keys)
@@ -698,20 +715,418 @@ namespace AES::Implementation
         }
     }
 
-    // Select implementation at runtime.
-    inline bool hasIntrinsics()
+    // Multi-block pipelines, AESENC has a latency of ~4 cycles but can issue every cycle.
+    namespace HW
+    {
+        // Independent blocks in flight, enough to fill the pipeline on current cores.
+        constexpr size_t Pipelinewidth = 8;
+
+        // Process N independent blocks, round by round so the instructions interleave.
+        template <uint8_t Rounds, size_t N> inline void Encryptblocks(std::array<Block_t, N> &Blocks, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            // Expanded via the index-pack so that the blocks stay in registers regardless of unrolling heuristics.
+            [&]<size_t... Index>(std::index_sequence<Index...>)
+            {
+                ((Blocks[Index] = _mm_xor_si128(Blocks[Index], Keys[0])), ...);
+
+                for (uint8_t i = 1; i < Rounds; ++i)
+                    ((Blocks[Index] = _mm_aesenc_si128(Blocks[Index], Keys[i])), ...);
+
+                ((Blocks[Index] = _mm_aesenclast_si128(Blocks[Index], Keys[Rounds])), ...);
+            }(std::make_index_sequence<N>{});
+        }
+        template <uint8_t Rounds, size_t N> inline void Decryptblocks(std::array<Block_t, N> &Blocks, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            [&]<size_t... Index>(std::index_sequence<Index...>)
+            {
+                ((Blocks[Index] = _mm_xor_si128(Blocks[Index], Keys[0])), ...);
+
+                for (uint8_t i = 1; i < Rounds; ++i)
+                    ((Blocks[Index] = _mm_aesdec_si128(Blocks[Index], Keys[i])), ...);
+
+                ((Blocks[Index] = _mm_aesdeclast_si128(Blocks[Index], Keys[Rounds])), ...);
+            }(std::make_index_sequence<N>{});
+        }
+
+        // Unaligned IO.
+        inline Block_t Loadblock(const uint8_t *Input)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const Block_t *>(Input));
+        }
+        inline void Storeblock(uint8_t *Output, const Block_t &Block)
+        {
+            _mm_storeu_si128(reinterpret_cast<Block_t *>(Output), Block);
+        }
+        template <size_t N> inline std::array<Block_t, N> Loadblocks(const uint8_t *Input)
+        {
+            std::array<Block_t, N> Blocks;
+            for (size_t b = 0; b < N; ++b) Blocks[b] = Loadblock(Input + b * 16);
+            return Blocks;
+        }
+        template <size_t N> inline void Storeblocks(uint8_t *Output, const std::array<Block_t, N> &Blocks)
+        {
+            for (size_t b = 0; b < N; ++b) Storeblock(Output + b * 16, Blocks[b]);
+        }
+
+        // GF(2^128) multiplication by alpha, same layout as Modes::MUL128 (byte 0 is the least significant).
+        inline Block_t Mulalpha(const Block_t &Value)
+        {
+            // Sign of each 64-bit half, moved to where the carry needs to go.
+            const auto Carry = _mm_shuffle_epi32(_mm_srai_epi32(Value, 31), _MM_SHUFFLE(0, 1, 0, 3));
+            return _mm_xor_si128(_mm_add_epi64(Value, Value), _mm_and_si128(Carry, _mm_setr_epi32(0x87, 0, 1, 0)));
+        }
+
+        // Input.size() must be a multiple of 16 and Output at least as large, may alias Input.
+        template <uint8_t Rounds> inline void Encrypt_ECB(std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                Encryptblocks<Rounds>(Blocks, Keys);
+                Storeblocks(Output + Offset, Blocks);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+                Storeblock(Output + Offset, Encryptblock_ECB<Rounds>(Loadblock(Input.data() + Offset), Keys));
+        }
+        template <uint8_t Rounds> inline void Decrypt_ECB(std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                Decryptblocks<Rounds>(Blocks, Keys);
+                Storeblocks(Output + Offset, Blocks);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+                Storeblock(Output + Offset, Decryptblock_ECB<Rounds>(Loadblock(Input.data() + Offset), Keys));
+        }
+
+        // State = Initialvector, CBC encryption is inherently serial so only decryption is pipelined.
+        template <uint8_t Rounds> inline void Decrypt_CBC(Block_t &State, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                const auto Ciphertext = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                auto Blocks = Ciphertext;
+
+                Decryptblocks<Rounds>(Blocks, Keys);
+
+                Blocks[0] = XOR(Blocks[0], State);
+                for (size_t b = 1; b < Pipelinewidth; ++b) Blocks[b] = XOR(Blocks[b], Ciphertext[b - 1]);
+                State = Ciphertext[Pipelinewidth - 1];
+
+                Storeblocks(Output + Offset, Blocks);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+                Storeblock(Output + Offset, Decryptblock_CBC<Rounds>(State, Loadblock(Input.data() + Offset), Keys));
+        }
+
+        // State = Counter, decryption is the same operation.
+        template <uint8_t Rounds, size_t Countersize, bool Bigendian> inline void Encrypt_CTR(Block_t &State, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                std::array<Block_t, Pipelinewidth> Keystream;
+                for (size_t b = 0; b < Pipelinewidth; ++b)
+                {
+                    Keystream[b] = State;
+                    State = Increment<Countersize, Bigendian>(State);
+                }
+
+                Encryptblocks<Rounds>(Keystream, Keys);
+
+                const auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                for (size_t b = 0; b < Pipelinewidth; ++b) Keystream[b] = XOR(Blocks[b], Keystream[b]);
+
+                Storeblocks(Output + Offset, Keystream);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+                Storeblock(Output + Offset, Encryptblock_CTR<Rounds, Countersize, Bigendian>(State, Loadblock(Input.data() + Offset), Keys));
+        }
+        template <uint8_t Rounds, size_t Countersize, bool Bigendian> inline void Decrypt_CTR(Block_t &State, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            Encrypt_CTR<Rounds, Countersize, Bigendian>(State, Input, Output, Keys);
+        }
+
+        // State = Encrypted tweak, the tweak chain is cheap so it's computed ahead of the blocks.
+        template <uint8_t Rounds> inline void Encrypt_XEX(Block_t &State, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                std::array<Block_t, Pipelinewidth> Tweaks;
+                for (size_t b = 0; b < Pipelinewidth; ++b)
+                {
+                    Tweaks[b] = State;
+                    State = Mulalpha(State);
+                }
+
+                auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                for (size_t b = 0; b < Pipelinewidth; ++b) Blocks[b] = XOR(Blocks[b], Tweaks[b]);
+
+                Encryptblocks<Rounds>(Blocks, Keys);
+
+                for (size_t b = 0; b < Pipelinewidth; ++b) Blocks[b] = XOR(Blocks[b], Tweaks[b]);
+                Storeblocks(Output + Offset, Blocks);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+            {
+                const auto Temp = Encryptblock<Rounds>(XOR(Loadblock(Input.data() + Offset), State), Keys);
+                Storeblock(Output + Offset, XOR(Temp, State));
+                State = Mulalpha(State);
+            }
+        }
+        template <uint8_t Rounds> inline void Decrypt_XEX(Block_t &State, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            size_t Offset = 0;
+
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                std::array<Block_t, Pipelinewidth> Tweaks;
+                for (size_t b = 0; b < Pipelinewidth; ++b)
+                {
+                    Tweaks[b] = State;
+                    State = Mulalpha(State);
+                }
+
+                auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                for (size_t b = 0; b < Pipelinewidth; ++b) Blocks[b] = XOR(Blocks[b], Tweaks[b]);
+
+                Decryptblocks<Rounds>(Blocks, Keys);
+
+                for (size_t b = 0; b < Pipelinewidth; ++b) Blocks[b] = XOR(Blocks[b], Tweaks[b]);
+                Storeblocks(Output + Offset, Blocks);
+            }
+
+            // Whatever is left is done serially.
+            for (; Offset < Input.size(); Offset += 16)
+            {
+                const auto Temp = Decryptblock<Rounds>(XOR(Loadblock(Input.data() + Offset), State), Keys);
+                Storeblock(Output + Offset, XOR(Temp, State));
+                State = Mulalpha(State);
+            }
+        }
+    }
+
+    // Galois/counter mode, the GHASH is computed in the same pass as the keystream.
+    namespace HW
     {
-        #if defined(_MSC_VER)
-        std::array<int, 4> CPUID{};
-        __cpuid(CPUID.data(), 1);
-        return (CPUID[2] & (1 << 25)) != 0;
+        // Carry-less multiplication of byte-reflected values, accumulated so several products can share one reduction.
+        inline void GFAccumulate(const Block_t &A, const Block_t &B, Block_t &Low, Block_t &High)
+        {
+            const auto Middle = _mm_xor_si128(_mm_clmulepi64_si128(A, B, 0x10), _mm_clmulepi64_si128(A, B, 0x01));
+            Low = _mm_xor_si128(Low, _mm_xor_si128(_mm_clmulepi64_si128(A, B, 0x00), _mm_slli_si128(Middle, 8)));
+            High = _mm_xor_si128(High, _mm_xor_si128(_mm_clmulepi64_si128(A, B, 0x11), _mm_srli_si128(Middle, 8)));
+        }
+        inline Block_t GFReduce(Block_t Low, Block_t High)
+        {
+            // Shift the 256-bit product left by one to account for the reflection.
+            auto A = _mm_srli_epi32(Low, 31), B = _mm_srli_epi32(High, 31);
+            const auto C = _mm_srli_si128(A, 12);
+            Low = _mm_or_si128(_mm_slli_epi32(Low, 1), _mm_slli_si128(A, 4));
+            High = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(High, 1), _mm_slli_si128(B, 4)), C);
+
+            // Reduce modulo x^128 + x^7 + x^2 + x + 1.
+            A = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(Low, 31), _mm_slli_epi32(Low, 30)), _mm_slli_epi32(Low, 25));
+            B = _mm_srli_si128(A, 4);
+            Low = _mm_xor_si128(Low, _mm_slli_si128(A, 12));
+
+            A = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(Low, 1), _mm_srli_epi32(Low, 2)), _mm_srli_epi32(Low, 7));
+            Low = _mm_xor_si128(Low, _mm_xor_si128(A, B));
+            return _mm_xor_si128(High, Low);
+        }
+        inline Block_t GFMultiply(const Block_t &A, const Block_t &B)
+        {
+            Block_t Low = _mm_setzero_si128(), High = _mm_setzero_si128();
+            GFAccumulate(A, B, Low, High);
+            return GFReduce(Low, High);
+        }
+
+        // Zero-padded load for the trailing bytes.
+        inline Block_t Loadpartial(const uint8_t *Input, size_t Size)
+        {
+            std::array<uint8_t, 16> Temp{};
+            cmp::memcpy(Temp.data(), Input, Size);
+            return Loadblock(Temp.data());
+        }
+
+        // Output may alias Input, returns the tag computed over AAD and the ciphertext.
+        template <uint8_t Rounds, bool Encrypt> inline std::array<uint8_t, 16> GCM(const std::array<uint8_t, 12> &IV, std::span<const uint8_t> AAD, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            // Powers of the hash-key so that a full pipeline is reduced once.
+            std::array<Block_t, Pipelinewidth> Powers;
+            Powers[0] = Byteswap(Encryptblock<Rounds>(_mm_setzero_si128(), Keys));
+            for (size_t i = 1; i < Pipelinewidth; ++i) Powers[i] = GFMultiply(Powers[i - 1], Powers[0]);
+
+            // J0 = IV || 1, reserved for the tag.
+            std::array<uint8_t, 16> Counter{};
+            cmp::memcpy(Counter.data(), IV.data(), IV.size());
+            Counter[15] = 1;
+
+            const auto J0 = Loadblock(Counter.data());
+            auto State = Increment<32, true>(J0);
+            auto Hash = _mm_setzero_si128();
+
+            // Additional data is only authenticated.
+            for (size_t Offset = 0; Offset < AAD.size(); Offset += 16)
+            {
+                const auto Block = Loadpartial(AAD.data() + Offset, std::min<size_t>(16, AAD.size() - Offset));
+                Hash = GFMultiply(XOR(Hash, Byteswap(Block)), Powers[0]);
+            }
+
+            size_t Offset = 0;
+            for (; Offset + 16 * Pipelinewidth <= Input.size(); Offset += 16 * Pipelinewidth)
+            {
+                std::array<Block_t, Pipelinewidth> Keystream;
+                for (size_t b = 0; b < Pipelinewidth; ++b)
+                {
+                    Keystream[b] = State;
+                    State = Increment<32, true>(State);
+                }
+
+                Encryptblocks<Rounds>(Keystream, Keys);
+
+                const auto Blocks = Loadblocks<Pipelinewidth>(Input.data() + Offset);
+                for (size_t b = 0; b < Pipelinewidth; ++b) Keystream[b] = XOR(Blocks[b], Keystream[b]);
+                Storeblocks(Output + Offset, Keystream);
+
+                // Hash the ciphertext, highest power first.
+                const auto &Ciphertext = Encrypt ? Keystream : Blocks;
+                Block_t Low = _mm_setzero_si128(), High = _mm_setzero_si128();
+
+                GFAccumulate(XOR(Hash, Byteswap(Ciphertext[0])), Powers[Pipelinewidth - 1], Low, High);
+                for (size_t b = 1; b < Pipelinewidth; ++b)
+                    GFAccumulate(Byteswap(Ciphertext[b]), Powers[Pipelinewidth - 1 - b], Low, High);
+
+                Hash = GFReduce(Low, High);
+            }
+
+            // Whatever is left is done serially, the last block may be partial.
+            for (; Offset < Input.size(); Offset += 16)
+            {
+                const auto Size = std::min<size_t>(16, Input.size() - Offset);
+                const auto Block = Loadpartial(Input.data() + Offset, Size);
+
+                std::array<uint8_t, 16> Temp{};
+                Storeblock(Temp.data(), XOR(Block, Encryptblock<Rounds>(State, Keys)));
+                State = Increment<32, true>(State);
+
+                std::memset(Temp.data() + Size, 0, 16 - Size);
+                cmp::memcpy(Output + Offset, Temp.data(), Size);
+
+                Hash = GFMultiply(XOR(Hash, Byteswap(Encrypt ? Loadblock(Temp.data()) : Block)), Powers[0]);
+            }
+
+            // Lengths in bits, already in reflected order.
+            Hash = GFMultiply(XOR(Hash, _mm_set_epi64x(int64_t(AAD.size() * 8), int64_t(Input.size() * 8))), Powers[0]);
+
+            std::array<uint8_t, 16> Tag;
+            Storeblock(Tag.data(), XOR(Encryptblock<Rounds>(J0, Keys), Byteswap(Hash)));
+            return Tag;
+        }
+    }
+    namespace Portable
+    {
+        // GF(2^128) multiplication as specified for GHASH, values are big-endian halves.
+        constexpr std::array<uint64_t, 2> GFMultiply(const std::array<uint64_t, 2> &X, const std::array<uint64_t, 2> &Y)
+        {
+            std::array<uint64_t, 2> Z{}, V{ Y };
+
+            for (uint8_t i = 0; i < 128; ++i)
+            {
+                if ((X[i / 64] >> (63 - (i % 64))) & 1)
+                {
+                    Z[0] ^= V[0];
+                    Z[1] ^= V[1];
+                }
+
+                const bool Carry = V[1] & 1;
+                V[1] = (V[1] >> 1) | (V[0] << 63);
+                V[0] = (V[0] >> 1) ^ (Carry ? 0xE100000000000000ULL : 0);
+            }
+
+            return Z;
+        }
+        constexpr std::array<uint64_t, 2> toGF(std::span<const uint8_t> Input)
+        {
+            std::array<uint64_t, 2> Result{};
 
-        #else
+            for (size_t i = 0; i < Input.size(); ++i)
+                Result[i / 8] |= uint64_t(Input[i]) << (56 - 8 * (i % 8));
 
-        std::array<unsigned int, 4> CPUID{};
-        __get_cpuid(1, &CPUID[0], &CPUID[1], &CPUID[2], &CPUID[3]);
-        return (CPUID[2] & (1 << 25)) != 0;
-        #endif
+            return Result;
+        }
+
+        // Output may alias Input, returns the tag computed over AAD and the ciphertext.
+        template <uint8_t Rounds, bool Encrypt> constexpr std::array<uint8_t, 16> GCM(const std::array<uint8_t, 12> &IV, std::span<const uint8_t> AAD, std::span<const uint8_t> Input, uint8_t *Output, const std::array<Block_t, Rounds + 1> &Keys)
+        {
+            const auto H = toGF(std::bit_cast<std::array<uint8_t, 16>>(Encryptblock<Rounds>(Block_t{}, Keys)));
+            std::array<uint64_t, 2> Hash{};
+
+            const auto Absorb = [&](std::span<const uint8_t> Data)
+            {
+                const auto X = toGF(Data);
+                Hash = GFMultiply({ Hash[0] ^ X[0], Hash[1] ^ X[1] }, H);
+            };
+
+            // J0 = IV || 1, reserved for the tag.
+            std::array<uint8_t, 16> Counter{};
+            for (size_t i = 0; i < IV.size(); ++i) Counter[i] = IV[i];
+            Counter[15] = 1;
+
+            const auto J0 = std::bit_cast<Block_t>(Counter);
+            auto State = Increment<32, true>(J0);
+
+            // Additional data is only authenticated.
+            for (size_t Offset = 0; Offset < AAD.size(); Offset += 16)
+                Absorb(AAD.subspan(Offset, std::min<size_t>(16, AAD.size() - Offset)));
+
+            for (size_t Offset = 0; Offset < Input.size(); Offset += 16)
+            {
+                const auto Size = std::min<size_t>(16, Input.size() - Offset);
+                const auto Keystream = std::bit_cast<std::array<uint8_t, 16>>(Encryptblock<Rounds>(State, Keys));
+                State = Increment<32, true>(State);
+
+                if constexpr (!Encrypt) Absorb(Input.subspan(Offset, Size));
+                for (size_t i = 0; i < Size; ++i) Output[Offset + i] = Input[Offset + i] ^ Keystream[i];
+                if constexpr (Encrypt) Absorb(std::span<const uint8_t>(Output + Offset, Size));
+            }
+
+            // Lengths in bits.
+            Hash = GFMultiply({ Hash[0] ^ uint64_t(AAD.size() * 8), Hash[1] ^ uint64_t(Input.size() * 8) }, H);
+
+            auto Tag = std::bit_cast<std::array<uint8_t, 16>>(Encryptblock<Rounds>(J0, Keys));
+            for (size_t i = 0; i < 16; ++i) Tag[i] ^= uint8_t(Hash[i / 8] >> (56 - 8 * (i % 8)));
+            return Tag;
+        }
+    }
+
+    // Select implementation at runtime.
+    inline bool hasIntrinsics()
+    {
+        return CPUID::hasAESNI();
+    }
+    inline bool hasCarrylessmul()
+    {
+        return CPUID::hasAESNI() && CPUID::hasPCLMUL() && CPUID::hasSSSE3();
     }
 }
 
@@ -744,6 +1159,434 @@ namespace AES::Modes
     }
 }
 
+namespace AES
+{
+    // Expanded once and reused, the chaining state carries over between calls so a message can be streamed.
+    template <Mode_t Mode, uint8_t Keysize> struct Context_t
+    {
+        static constexpr uint8_t Rounds = Keysize + 6;
+        using Schedule_t = std::array<Implementation::Portable::Block_t, Rounds + 1>;
+
+        // The HW schedule shares the layout, so the same storage is used for both implementations.
+        alignas(16) Schedule_t Encryptkeys{}, Decryptkeys{};
+        [[no_unique_address]] std::conditional_t<Mode == AES_XTS, Schedule_t, std::monostate> Tweakkeys{};
+        alignas(16) std::array<uint8_t, 16> State{};
+        bool Hardware{};
+
+        // IV, counter or data-unit tweak depending on mode.
+        constexpr void Reset(const std::array<uint8_t, 16> &IV)
+        {
+            State = IV;
+
+            // The tweak is encrypted once per data-unit.
+            if constexpr (Mode == AES_XEX || Mode == AES_XTS)
+            {
+                using namespace Implementation::Portable;
+
+                if constexpr (Mode == AES_XTS) State = std::bit_cast<std::array<uint8_t, 16>>(Encryptblock<Rounds>(std::bit_cast<Block_t>(IV), Tweakkeys));
+                else State = std::bit_cast<std::array<uint8_t, 16>>(Encryptblock<Rounds>(std::bit_cast<Block_t>(IV), Encryptkeys));
+            }
+        }
+
+        // Input.size() must be a multiple of 16, CTR modes accept a partial block at the end of the message.
+        constexpr void Encrypt(std::span<const uint8_t> Input, uint8_t *Output) requires (Mode != AES_GCM)
+        {
+            ASSERT(Mode >= AES_CTR_32BE || (Input.size() & 15) == 0);
+
+            if (std::is_constant_evaluated() || !Hardware) Portableprocess<true>(Input, Output);
+            else Hardwareprocess<true>(Input, Output);
+        }
+        constexpr void Decrypt(std::span<const uint8_t> Input, uint8_t *Output) requires (Mode != AES_GCM)
+        {
+            ASSERT(Mode >= AES_CTR_32BE || (Input.size() & 15) == 0);
+
+            if (std::is_constant_evaluated() || !Hardware) Portableprocess<false>(Input, Output);
+            else Hardwareprocess<false>(Input, Output);
+        }
+
+        // GCM takes a new IV per message, Output needs room for Input.size() bytes.
+        constexpr std::array<uint8_t, 16> Encrypt(const std::array<uint8_t, 12> &IV, std::span<const uint8_t> Input, uint8_t *Output, std::span<const uint8_t> AAD = {}) const requires (Mode == AES_GCM)
+        {
+            if (std::is_constant_evaluated() || !Hardware) return Implementation::Portable::GCM<Rounds, true>(IV, AAD, Input, Output, Encryptkeys);
+            else return Implementation::HW::GCM<Rounds, true>(IV, AAD, Input, Output, Hardwarekeys());
+        }
+
+        // Clears the output and returns false if the tag does not match.
+        constexpr bool Decrypt(const std::array<uint8_t, 12> &IV, std::span<const uint8_t> Input, uint8_t *Output, const std::array<uint8_t, 16> &Tag, std::span<const uint8_t> AAD = {}) const requires (Mode == AES_GCM)
+        {
+            std::array<uint8_t, 16> Computed{};
+
+            if (std::is_constant_evaluated() || !Hardware) Computed = Implementation::Portable::GCM<Rounds, false>(IV, AAD, Input, Output, Encryptkeys);
+            else Computed = Implementation::HW::GCM<Rounds, false>(IV, AAD, Input, Output, Hardwarekeys());
+
+            // Constant time comparison.
+            uint8_t Difference{};
+            for (size_t i = 0; i < 16; ++i) Difference |= Computed[i] ^ Tag[i];
+
+            if (Difference != 0) [[unlikely]]
+            {
+                for (size_t i = 0; i < Input.size(); ++i) Output[i] = 0;
+                return false;
+            }
+
+            return true;
+        }
+
+        constexpr Context_t(const std::array<uint8_t, Keysize * 4> &Key, const std::array<uint8_t, 16> &IV = {}) requires (Mode != AES_XTS)
+        {
+            Expand(Key);
+            Reset(IV);
+        }
+        constexpr Context_t(const std::array<uint8_t, Keysize * 4> &Key, const std::array<uint8_t, Keysize * 4> &Tweakkey, const std::array<uint8_t, 16> &IV = {}) requires (Mode == AES_XTS)
+        {
+            Tweakkeys = Implementation::Portable::Keyexpansion<Keysize, Rounds>(Tweakkey);
+            Expand(Key);
+            Reset(IV);
+        }
+
+        private:
+        constexpr void Expand(const std::array<uint8_t, Keysize * 4> &Key)
+        {
+            if (!std::is_constant_evaluated())
+                Hardware = (Mode == AES_GCM) ? Implementation::hasCarrylessmul() : Implementation::hasIntrinsics();
+
+            if (std::is_constant_evaluated() || !Hardware)
+            {
+                Encryptkeys = Implementation::Portable::Keyexpansion<Keysize, Rounds>(Key);
+                Decryptkeys = Implementation::Portable::INVKeyexpansion<Keysize, Rounds>(Key);
+            }
+            else
+            {
+                const auto Keys = Implementation::HW::Keyexpansion<Keysize, Rounds>(Key);
+                const auto INVKeys = Implementation::HW::INVKeyexpansion<Keysize, Rounds>(Key);
+                cmp::memcpy(Encryptkeys.data(), Keys.data(), sizeof(Keys));
+                cmp::memcpy(Decryptkeys.data(), INVKeys.data(), sizeof(INVKeys));
+            }
+        }
+
+        const std::array<Implementation::HW::Block_t, Rounds + 1> &Hardwarekeys(bool Inverse = false) const
+        {
+            return *reinterpret_cast<const std::array<Implementation::HW::Block_t, Rounds + 1> *>(Inverse ? Decryptkeys.data() : Encryptkeys.data());
+        }
+
+        template <bool Encrypt> constexpr void Portableprocess(std::span<const uint8_t> Input, uint8_t *Output)
+        {
+            using namespace Implementation::Portable;
+            auto Chain = std::bit_cast<Block_t>(State);
+
+            for (size_t Offset = 0; Offset < Input.size(); Offset += 16)
+            {
+                const auto Size = std::min<size_t>(16, Input.size() - Offset);
+                Block_t Block{}, Result{};
+                cmp::memcpy(&Block, &Input[Offset], Size);
+
+                if constexpr (Mode == AES_ECB) Result = Encrypt ? Encryptblock_ECB<Rounds>(Block, Encryptkeys) : Decryptblock_ECB<Rounds>(Block, Decryptkeys);
+                if constexpr (Mode == AES_CBC) Result = Encrypt ? Encryptblock_CBC<Rounds>(Chain, Block, Encryptkeys) : Decryptblock_CBC<Rounds>(Chain, Block, Decryptkeys);
+                if constexpr (Mode == AES_CFB) Result = Encrypt ? Encryptblock_CFB<Rounds>(Chain, Block, Encryptkeys) : Decryptblock_CFB<Rounds>(Chain, Block, Encryptkeys);
+                if constexpr (Mode >= AES_CTR_32BE && Mode <= AES_CTR_128LE) Result = Encryptblock_CTR<Rounds, Countersize_v<Mode>, Bigendian_v<Mode>>(Chain, Block, Encryptkeys);
+                if constexpr (Mode == AES_XEX || Mode == AES_XTS)
+                {
+                    const auto Temp = Encrypt ? Encryptblock<Rounds>(XOR(Block, Chain), Encryptkeys) : Decryptblock<Rounds>(XOR(Block, Chain), Decryptkeys);
+                    Result = XOR(Temp, Chain);
+                    Chain = Modes::MUL128(Chain);
+                }
+
+                const auto Bytes = std::bit_cast<std::array<uint8_t, 16>>(Result);
+                for (size_t i = 0; i < Size; ++i) Output[Offset + i] = Bytes[i];
+            }
+
+            State = std::bit_cast<std::array<uint8_t, 16>>(Chain);
+        }
+        template <bool Encrypt> void Hardwareprocess(std::span<const uint8_t> Input, uint8_t *Output)
+        {
+            using namespace Implementation::HW;
+            const auto Full = Input.first(Input.size() & ~size_t(15));
+            auto Chain = Loadblock(State.data());
+
+            if constexpr (Mode == AES_ECB)
+            {
+                if constexpr (Encrypt) Encrypt_ECB<Rounds>(Full, Output, Hardwarekeys());
+                else Decrypt_ECB<Rounds>(Full, Output, Hardwarekeys(true));
+            }
+            if constexpr (Mode == AES_CBC || Mode == AES_CFB)
+            {
+                if constexpr (Mode == AES_CBC && !Encrypt) Decrypt_CBC<Rounds>(Chain, Full, Output, Hardwarekeys(true));
+                else
+                {
+                    // Serial by design.
+                    for (size_t Offset = 0; Offset < Full.size(); Offset += 16)
+                    {
+                        const auto Block = Loadblock(Full.data() + Offset);
+                        if constexpr (Mode == AES_CBC) Storeblock(Output + Offset, Encryptblock_CBC<Rounds>(Chain, Block, Hardwarekeys()));
+                        else if constexpr (Encrypt) Storeblock(Output + Offset, Encryptblock_CFB<Rounds>(Chain, Block, Hardwarekeys()));
+                        else Storeblock(Output + Offset, Decryptblock_CFB<Rounds>(Chain, Block, Hardwarekeys()));
+                    }
+                }
+            }
+            if constexpr (Mode >= AES_CTR_32BE && Mode <= AES_CTR_128LE)
+            {
+                Encrypt_CTR<Rounds, Countersize_v<Mode>, Bigendian_v<Mode>>(Chain, Full, Output, Hardwarekeys());
+
+                // Partial block at the end of the message.
+                if (const auto Size = Input.size() - Full.size())
+                {
+                    std::array<uint8_t, 16> Temp{};
+                    cmp::memcpy(Temp.data(), Input.data() + Full.size(), Size);
+                    Storeblock(Temp.data(), Encryptblock_CTR<Rounds, Countersize_v<Mode>, Bigendian_v<Mode>>(Chain, Loadblock(Temp.data()), Hardwarekeys()));
+                    cmp::memcpy(Output + Full.size(), Temp.data(), Size);
+                }
+            }
+            if constexpr (Mode == AES_XEX || Mode == AES_XTS)
+            {
+                if constexpr (Encrypt) Encrypt_XEX<Rounds>(Chain, Full, Output, Hardwarekeys());
+                else Decrypt_XEX<Rounds>(Chain, Full, Output, Hardwarekeys(true));
+            }
+
+            Storeblock(State.data(), Chain);
+        }
+    };
+}
+
+namespace AES::Modes
+{
+    // Authenticated encryption, Output needs room for Input.size() bytes. Returns the tag.
+    template <uint8_t Keysize, uint8_t Rounds> constexpr std::array<uint8_t, 16> Encrypt_GCM(std::span<const uint8_t> Input, uint8_t *Output, const std::array<uint8_t, Keysize * 4> &Key, const std::array<uint8_t, 12> &IV, std::span<const uint8_t> AAD = {})
+    {
+        static_assert(Rounds == Keysize + 6, "Invalid AES configuration");
+        return Context_t<AES_GCM, Keysize>(Key).Encrypt(IV, Input, Output, AAD);
+    }
+
+    // Clears the output and returns false if the tag does not match.
+    template <uint8_t Keysize, uint8_t Rounds> constexpr bool Decrypt_GCM(std::span<const uint8_t> Input, uint8_t *Output, const std::array<uint8_t, Keysize * 4> &Key, const std::array<uint8_t, 12> &IV, const std::array<uint8_t, 16> &Tag, std::span<const uint8_t> AAD = {})
+    {
+        static_assert(Rounds == Keysize + 6, "Invalid AES configuration");
+        return Context_t<AES_GCM, Keysize>(Key).Decrypt(IV, Input, Output, Tag, AAD);
+    }
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    // Test cases 2 and 4 from the GCM specification.
+    static_assert([]()
+    {
+        constexpr std::array<uint8_t, 16> Ciphertext{ 0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92, 0xf3, 0x28, 0xc2, 0xb9, 0x71, 0xb2, 0xfe, 0x78 };
+        constexpr std::array<uint8_t, 16> Tag{ 0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
+        constexpr std::array<uint8_t, 16> Plaintext{}, Key{};
+        constexpr std::array<uint8_t, 12> IV{};
+
+        std::array<uint8_t, 16> Buffer{};
+        if (Tag != AES::Modes::Encrypt_GCM<4, 10>(Plaintext, Buffer.data(), Key, IV) || Buffer != Ciphertext) return false;
+        return AES::Modes::Decrypt_GCM<4, 10>(Ciphertext, Buffer.data(), Key, IV, Tag) && Buffer == Plaintext;
+    }(), "BROKEN: AES-GCM (no AAD)");
+    static_assert([]()
+    {
+        constexpr std::array<uint8_t, 16> Key{ 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08 };
+        constexpr std::array<uint8_t, 12> IV{ 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+        constexpr std::array<uint8_t, 20> AAD{ 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xab, 0xad, 0xda, 0xd2 };
+        constexpr std::array<uint8_t, 60> Plaintext
+        {
+            0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+            0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda, 0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+            0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+            0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39
+        };
+        constexpr std::array<uint8_t, 60> Ciphertext
+        {
+            0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+            0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0, 0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+            0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+            0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91
+        };
+        constexpr std::array<uint8_t, 16> Tag{ 0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47 };
+
+        std::array<uint8_t, 60> Buffer{};
+        if (Tag != AES::Modes::Encrypt_GCM<4, 10>(Plaintext, Buffer.data(), Key, IV, AAD) || Buffer != Ciphertext) return false;
+        return AES::Modes::Decrypt_GCM<4, 10>(Ciphertext, Buffer.data(), Key, IV, Tag, AAD) && Buffer == Plaintext;
+    }(), "BROKEN: AES-GCM (AAD)");
+
+    // The HW path against the constexpr one.
+    inline void AESGCMtest()
+    {
+        using namespace AES::Implementation;
+        if (!hasCarrylessmul()) return;
+
+        constexpr std::array<uint8_t, 16> Key{ 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08 };
+        constexpr std::array<uint8_t, 12> IV{ 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+        std::vector<uint8_t> Input(1021), AAD(37), Portable(Input.size()), Hardware(Input.size());
+        for (size_t i = 0; i < Input.size(); ++i) Input[i] = uint8_t(i * 13 + 5);
+        for (size_t i = 0; i < AAD.size(); ++i) AAD[i] = uint8_t(i * 7 + 3);
+
+        const auto Portabletag = Portable::GCM<10, true>(IV, AAD, Input, Portable.data(), Portable::Keyexpansion<4, 10>(Key));
+        const auto Hardwaretag = HW::GCM<10, true>(IV, AAD, Input, Hardware.data(), HW::Keyexpansion<4, 10>(Key));
+        if (Portabletag != Hardwaretag || Portable != Hardware) printf("BROKEN: AES-GCM (HW encrypt)\n");
+
+        if (!AES::Modes::Decrypt_GCM<4, 10>(Hardware, Hardware.data(), Key, IV, Hardwaretag, AAD) || Hardware != Input)
+            printf("BROKEN: AES-GCM (HW decrypt)\n");
+    }
+
+    // Streaming through a context should match a single call, on both implementations.
+    template <AES::Mode_t Mode> inline void AESContexttest(const char *Name)
+    {
+        constexpr std::array<uint8_t, 16> Key{ 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+        constexpr std::array<uint8_t, 16> IV{ 0x16, 0x15, 0x7e, 0x2b, 0xa6, 0xd2, 0xae, 0x28, 0x88, 0x15, 0xf7, 0xab, 0x3c, 0x4f, 0xcf, 0xff };
+        const auto Make = [&]()
+        {
+            if constexpr (Mode == AES::AES_XTS) return AES::Context_t<Mode, 4>(Key, IV, IV);
+            else return AES::Context_t<Mode, 4>(Key, IV);
+        };
+
+        std::vector<uint8_t> Input(16 * 37), Whole(Input.size()), Streamed(Input.size()), Portable(Input.size());
+        for (size_t i = 0; i < Input.size(); ++i) Input[i] = uint8_t(i * 31 + 7);
+
+        auto A = Make(), B = Make(), C = Make();
+        C.Hardware = false;
+
+        A.Encrypt(Input, Whole.data());
+        C.Encrypt(Input, Portable.data());
+        B.Encrypt(std::span(Input).first(16 * 3), Streamed.data());
+        B.Encrypt(std::span(Input).subspan(16 * 3, 16 * 20), Streamed.data() + 16 * 3);
+        B.Encrypt(std::span(Input).subspan(16 * 23), Streamed.data() + 16 * 23);
+
+        if (Whole != Streamed || Whole != Portable) printf("BROKEN: AES %s (context encrypt)\n", Name);
+
+        auto D = Make();
+        D.Decrypt(Whole, Whole.data());
+        if (Whole != Input) printf("BROKEN: AES %s (context decrypt)\n", Name);
+    }
+    inline void AESContexttest()
+    {
+        AESContexttest<AES::AES_ECB>("ECB");
+        AESContexttest<AES::AES_CBC>("CBC");
+        AESContexttest<AES::AES_CFB>("CFB");
+        AESContexttest<AES::AES_XEX>("XEX");
+        AESContexttest<AES::AES_XTS>("XTS");
+        AESContexttest<AES::AES_CTR_32BE>("CTR_32BE");
+        AESContexttest<AES::AES_CTR_64LE>("CTR_64LE");
+        AESContexttest<AES::AES_CTR_128BE>("CTR_128BE");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // Cycles/byte for the serial and pipelined AES-NI paths.
+    inline void AESbenchmark()
+    {
+        using namespace AES::Implementation;
+        if (!hasIntrinsics()) return;
+
+        constexpr size_t Size = 1024 * 1024;
+        constexpr std::array<uint8_t, 16> Key{ 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+        const auto Keys = HW::Keyexpansion<4, 10>(Key);
+        const auto INVKeys = HW::INVKeyexpansion<4, 10>(Key);
+        const auto IV = _mm_setr_epi32(0x2b7e1516, 0x28aed2a6, 0xabf71588, 0x09cf4f3c);
+
+        std::vector<uint8_t> Input(Size), Serial(Size), Pipelined(Size);
+        for (size_t i = 0; i < Size; ++i) Input[i] = uint8_t(i * 31 + 7);
+
+        const auto Measure = [&](const char *Name, std::vector<uint8_t> &Output, auto &&Callback)
+        {
+            Benchmarks::Measure(Name, Size, [&]() { Callback(Output); Keep(Output.data()); });
+        };
+        const auto Compare = [&](const char *Name)
+        {
+            if (Serial != Pipelined) printf("BROKEN: %s (pipelined)\n", Name);
+        };
+
+        Measure("AES128 ECB encrypt (serial)", Serial, [&](std::vector<uint8_t> &Output)
+        {
+            for (size_t i = 0; i < Size; i += 16)
+                HW::Storeblock(&Output[i], HW::Encryptblock_ECB<10>(HW::Loadblock(&Input[i]), Keys));
+        });
+        Measure("AES128 ECB encrypt (pipelined)", Pipelined, [&](std::vector<uint8_t> &Output)
+        {
+            HW::Encrypt_ECB<10>(Input, Output.data(), Keys);
+        });
+        Compare("AES128 ECB encrypt");
+
+        Measure("AES128 ECB decrypt (serial)", Serial, [&](std::vector<uint8_t> &Output)
+        {
+            for (size_t i = 0; i < Size; i += 16)
+                HW::Storeblock(&Output[i], HW::Decryptblock_ECB<10>(HW::Loadblock(&Input[i]), INVKeys));
+        });
+        Measure("AES128 ECB decrypt (pipelined)", Pipelined, [&](std::vector<uint8_t> &Output)
+        {
+            HW::Decrypt_ECB<10>(Input, Output.data(), INVKeys);
+        });
+        Compare("AES128 ECB decrypt");
+
+        Measure("AES128 CBC decrypt (serial)", Serial, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            for (size_t i = 0; i < Size; i += 16)
+                HW::Storeblock(&Output[i], HW::Decryptblock_CBC<10>(State, HW::Loadblock(&Input[i]), INVKeys));
+        });
+        Measure("AES128 CBC decrypt (pipelined)", Pipelined, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            HW::Decrypt_CBC<10>(State, Input, Output.data(), INVKeys);
+        });
+        Compare("AES128 CBC decrypt");
+
+        Measure("AES128 CTR (serial)", Serial, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            for (size_t i = 0; i < Size; i += 16)
+                HW::Storeblock(&Output[i], HW::Encryptblock_CTR<10, 32, true>(State, HW::Loadblock(&Input[i]), Keys));
+        });
+        Measure("AES128 CTR (pipelined)", Pipelined, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            HW::Encrypt_CTR<10, 32, true>(State, Input, Output.data(), Keys);
+        });
+        Compare("AES128 CTR");
+
+        Measure("AES128 XTS encrypt (serial)", Serial, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            for (size_t i = 0; i < Size; i += 16)
+            {
+                const auto Temp = HW::Encryptblock<10>(HW::XOR(HW::Loadblock(&Input[i]), State), Keys);
+                HW::Storeblock(&Output[i], HW::XOR(Temp, State));
+                State = HW::Mulalpha(State);
+            }
+        });
+        Measure("AES128 XTS encrypt (pipelined)", Pipelined, [&](std::vector<uint8_t> &Output)
+        {
+            auto State = IV;
+            HW::Encrypt_XEX<10>(State, Input, Output.data(), Keys);
+        });
+        Compare("AES128 XTS encrypt");
+
+        if (hasCarrylessmul())
+        {
+            constexpr std::array<uint8_t, 12> Nonce{ 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+            Measure("AES128 GCM encrypt (fused)", Pipelined, [&](std::vector<uint8_t> &Output)
+            {
+                HW::GCM<10, true>(Nonce, {}, Input, Output.data(), Keys);
+            });
+        }
+
+        // The public contexts, with their runtime dispatch and state handling.
+        const auto Modes = [&]<AES::Mode_t Mode>(const char *Name)
+        {
+            auto Context = [&]()
+            {
+                if constexpr (Mode == AES::AES_XTS) return AES::Context_t<Mode, 4>(Key, Key, Key);
+                else return AES::Context_t<Mode, 4>(Key, Key);
+            }();
+            Measure(Name, Serial, [&](std::vector<uint8_t> &Output) { Context.Encrypt(Input, Output.data()); });
+        };
+        Modes.template operator()<AES::AES_CBC>("AES::Context_t CBC encrypt");
+        Modes.template operator()<AES::AES_CFB>("AES::Context_t CFB encrypt");
+        Modes.template operator()<AES::AES_XTS>("AES::Context_t XTS encrypt");
+        Modes.template operator()<AES::AES_CTR>("AES::Context_t CTR encrypt");
+    }
+}
+#endif
+
 // WIP
 #if 0
 namespace AES::Modes
@@ -55,10 +55,8 @@ namespace Hash
 
             return Hash;
         }
-        constexpr uint64_t FNV1a_64(std::span<const uint8_t> Input)
+        constexpr uint64_t FNV1a_64(std::span<const uint8_t> Input, uint64_t Hash = FNV1_Offset_64)
         {
-            auto Hash = FNV1_Offset_64;
-
             for (const auto Item : Input)
             {
                 Hash ^= uint8_t(Item);
@@ -136,13 +134,12 @@ namespace Hash
             Hash = (Hash ^ (Hash << 16)) * (uint64_t(Input.size()) ^ _waterp0);
             return (uint32_t)(Hash - (Hash >> 32));
         }
-        constexpr uint64_t WW64(std::span<const uint8_t> Input)
+        // Split in two so that the batched version can hand over after the shared blocks.
+        constexpr uint64_t WW64Blocks(uint64_t Hash, std::span<const uint8_t> Input, size_t First = 0)
         {
-            const auto Remainder = Input.size() & 15;
             const auto Count = Input.size() / 16;
-            uint64_t Hash = _wheatp0;
 
-            for (size_t i = 0; i < Count; ++i)
+            for (size_t i = First; i < Count; ++i)
             {
                 const auto Offset = Input.data() + i * 16;
                 const auto P1 = WWProcess(toINT64<32>(Offset) ^ _wheatp1, toINT64<32>(Offset + 4) ^ _wheatp2);
@@ -150,6 +147,13 @@ namespace Hash
 
                 Hash = WWProcess(P1 + Hash, P2);
             }
+
+            return Hash;
+        }
+        constexpr uint64_t WW64Final(uint64_t Hash, std::span<const uint8_t> Input)
+        {
+            const auto Remainder = Input.size() & 15;
+            const auto Count = Input.size() / 16;
             Hash += _wheatp5;
 
             const auto Offset = Input.data() + Count * 16;
@@ -176,12 +180,17 @@ namespace Hash
             Hash = (Hash ^ Hash << 16) * (uint64_t(Input.size()) ^ _wheatp0);
             return Hash - (Hash >> 31) + (Hash << 33);
         }
+        constexpr uint64_t WW64(std::span<const uint8_t> Input)
+        {
+            return WW64Final(WW64Blocks(_wheatp0, Input), Input);
+        }
 
         #pragma endregion
 
         #pragma region CRC
+        // Reference implementation, one bit at a time. Used at compile-time.
         template <uint32_t Polynomial, bool Shiftright>
-        constexpr uint32_t CRC32(std::span<const uint8_t> Input, uint32_t IV)
+        constexpr uint32_t CRC32Bitwise(std::span<const uint8_t> Input, uint32_t IV)
         {
             uint32_t CRC = IV;
 
@@ -208,6 +217,258 @@ namespace Hash
             return ~CRC;
         }
 
+        namespace CRCInternal
+        {
+            constexpr uint32_t Reflect(uint32_t Value)
+            {
+                uint32_t Result{};
+                for (size_t i = 0; i < 32; ++i) Result |= ((Value >> i) & 1) << (31 - i);
+                return Result;
+            }
+
+            // A * B mod P, in the same bit-order as the CRC.
+            template <uint32_t Polynomial, bool Shiftright> constexpr uint32_t Multiply(uint32_t A, uint32_t B)
+            {
+                uint32_t Product{};
+
+                for (size_t i = 0; i < 32; ++i)
+                {
+                    if constexpr (Shiftright)
+                    {
+                        if (A & (1UL << (31 - i))) Product ^= B;
+                        B = (B & 1) ? (B >> 1) ^ Polynomial : B >> 1;
+                    }
+                    else
+                    {
+                        Product = (Product & (1UL << 31)) ? (Product << 1) ^ Polynomial : Product << 1;
+                        if (A & (1UL << (31 - i))) Product ^= B;
+                    }
+                }
+
+                return Product;
+            }
+
+            // x^N mod P, in the same bit-order as the CRC.
+            template <uint32_t Polynomial, bool Shiftright> constexpr uint32_t Power(uint64_t N)
+            {
+                uint32_t Result = Shiftright ? (1UL << 31) : 1;
+                uint32_t Base = Shiftright ? (1UL << 30) : 2;
+
+                while (N)
+                {
+                    if (N & 1) Result = Multiply<Polynomial, Shiftright>(Result, Base);
+                    Base = Multiply<Polynomial, Shiftright>(Base, Base);
+                    N >>= 1;
+                }
+
+                return Result;
+            }
+
+            // Eight tables so that each iteration consumes a 64-bit word.
+            template <uint32_t Polynomial, bool Shiftright> constexpr auto Slicetables = []()
+            {
+                std::array<std::array<uint32_t, 256>, 8> Tables{};
+
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    const uint8_t Byte = uint8_t(i);
+                    Tables[0][i] = ~CRC32Bitwise<Polynomial, Shiftright>({ &Byte, 1 }, 0);
+                }
+
+                for (size_t k = 1; k < 8; ++k)
+                {
+                    for (size_t i = 0; i < 256; ++i)
+                    {
+                        const auto Previous = Tables[k - 1][i];
+                        if constexpr (Shiftright) Tables[k][i] = (Previous >> 8) ^ Tables[0][Previous & 0xFF];
+                        else Tables[k][i] = (Previous << 8) ^ Tables[0][Previous >> 24];
+                    }
+                }
+
+                return Tables;
+            }();
+
+            // Works on the raw state, neither inverted on input nor output.
+            template <uint32_t Polynomial, bool Shiftright> uint32_t Slice8(std::span<const uint8_t> Input, uint32_t State)
+            {
+                const auto &Tables = Slicetables<Polynomial, Shiftright>;
+                auto Data = Input.data();
+                auto Size = Input.size();
+
+                for (; Size >= 8; Size -= 8, Data += 8)
+                {
+                    uint32_t One, Two;
+                    std::memcpy(&One, Data, sizeof(One));
+                    std::memcpy(&Two, Data + 4, sizeof(Two));
+
+                    if constexpr (Shiftright)
+                    {
+                        One = cmp::toLittle(One) ^ State;
+                        Two = cmp::toLittle(Two);
+                        State = Tables[7][One & 0xFF] ^ Tables[6][(One >> 8) & 0xFF] ^ Tables[5][(One >> 16) & 0xFF] ^ Tables[4][One >> 24] ^
+                                Tables[3][Two & 0xFF] ^ Tables[2][(Two >> 8) & 0xFF] ^ Tables[1][(Two >> 16) & 0xFF] ^ Tables[0][Two >> 24];
+                    }
+                    else
+                    {
+                        One = cmp::toBig(One) ^ State;
+                        Two = cmp::toBig(Two);
+                        State = Tables[7][One >> 24] ^ Tables[6][(One >> 16) & 0xFF] ^ Tables[5][(One >> 8) & 0xFF] ^ Tables[4][One & 0xFF] ^
+                                Tables[3][Two >> 24] ^ Tables[2][(Two >> 16) & 0xFF] ^ Tables[1][(Two >> 8) & 0xFF] ^ Tables[0][Two & 0xFF];
+                    }
+                }
+
+                for (; Size; --Size, ++Data)
+                {
+                    if constexpr (Shiftright) State = (State >> 8) ^ Tables[0][(State ^ *Data) & 0xFF];
+                    else State = (State << 8) ^ Tables[0][(State >> 24) ^ *Data];
+                }
+
+                return State;
+            }
+
+            #if defined(HAS_CPUID)
+            // SSE4.2 only implements the Castagnoli polynomial.
+            inline uint32_t Hardware32C(std::span<const uint8_t> Input, uint32_t State)
+            {
+                auto Data = Input.data();
+                auto Size = Input.size();
+                uint64_t CRC = State;
+
+                for (; Size >= 8; Size -= 8, Data += 8)
+                {
+                    uint64_t Word;
+                    std::memcpy(&Word, Data, sizeof(Word));
+                    CRC = _mm_crc32_u64(CRC, Word);
+                }
+                for (; Size; --Size, ++Data) CRC = _mm_crc32_u8(uint32_t(CRC), *Data);
+
+                return uint32_t(CRC);
+            }
+
+            // Carry-less products of polynomials in MSB-first order, as (Low, High).
+            inline std::pair<uint64_t, uint64_t> Clmul(uint64_t A, uint64_t B)
+            {
+                const auto Product = _mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(A)), _mm_cvtsi64_si128(int64_t(B)), 0x00);
+                return { uint64_t(_mm_cvtsi128_si64(Product)), uint64_t(_mm_extract_epi64(Product, 1)) };
+            }
+
+            // floor(x^64 / P) for the Barrett reduction, 33 bits.
+            constexpr uint64_t Barrett(uint32_t Polynomial)
+            {
+                const uint64_t Full = (1ULL << 32) | Polynomial;
+                uint64_t Remainder = 1ULL << 32, Quotient{};
+
+                // Long division of x^64, one quotient bit per step.
+                for (int i = 32; i >= 0; --i)
+                {
+                    if (Remainder & (1ULL << 32)) { Quotient |= 1ULL << i; Remainder ^= Full; }
+                    Remainder <<= 1;
+                }
+
+                return Quotient;
+            }
+
+            // Folds 16-byte chunks with PCLMULQDQ. Reflected CRCs reverse the bits of each byte and take the same path.
+            // Input.size() must be a multiple of 16 and at least 64, the state is the raw one.
+            template <uint32_t Polynomial, bool Shiftright> uint32_t Fold(std::span<const uint8_t> Input, uint32_t State)
+            {
+                constexpr uint32_t Normal = Shiftright ? Reflect(Polynomial) : Polynomial;
+                constexpr uint64_t K576 = Power<Normal, false>(512 + 64), K512 = Power<Normal, false>(512);
+                constexpr uint64_t K192 = Power<Normal, false>(128 + 64), K128 = Power<Normal, false>(128);
+                constexpr uint64_t K96 = Power<Normal, false>(96), K64 = Power<Normal, false>(64);
+                constexpr uint64_t Mu = Barrett(Normal);
+
+                const auto Byteswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+                const auto Bitswaplow = _mm_set_epi64x(0x0F070B030D050901LL, 0x0E060A020C040800LL);
+                const auto Bitswaphigh = _mm_set_epi64x(int64_t(0xF070B030D0509010ULL), int64_t(0xE060A020C0408000ULL));
+                const auto Nibble = _mm_set1_epi8(0x0F);
+
+                const auto Load = [&](const uint8_t *Data)
+                {
+                    auto Chunk = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Data)), Byteswap);
+                    if constexpr (Shiftright)
+                    {
+                        const auto Low = _mm_shuffle_epi8(Bitswaphigh, _mm_and_si128(Chunk, Nibble));
+                        const auto High = _mm_shuffle_epi8(Bitswaplow, _mm_and_si128(_mm_srli_epi16(Chunk, 4), Nibble));
+                        Chunk = _mm_or_si128(Low, High);
+                    }
+                    return Chunk;
+                };
+
+                // X * x^Distance, reduced to 96 bits.
+                const auto Foldby = [](__m128i X, __m128i Constants)
+                {
+                    return _mm_xor_si128(_mm_clmulepi64_si128(X, Constants, 0x11), _mm_clmulepi64_si128(X, Constants, 0x00));
+                };
+
+                const auto By512 = _mm_set_epi64x(int64_t(K576), int64_t(K512));
+                const auto By128 = _mm_set_epi64x(int64_t(K192), int64_t(K128));
+
+                auto Data = Input.data();
+                auto Size = Input.size();
+
+                std::array<__m128i, 4> X;
+                for (size_t i = 0; i < 4; ++i) X[i] = Load(Data + i * 16);
+                X[0] = _mm_xor_si128(X[0], _mm_set_epi32(int(Shiftright ? Reflect(State) : State), 0, 0, 0));
+                Data += 64; Size -= 64;
+
+                for (; Size >= 64; Size -= 64, Data += 64)
+                {
+                    for (size_t i = 0; i < 4; ++i) X[i] = _mm_xor_si128(Foldby(X[i], By512), Load(Data + i * 16));
+                }
+
+                auto Y = X[0];
+                for (size_t i = 1; i < 4; ++i) Y = _mm_xor_si128(Foldby(Y, By128), X[i]);
+                for (; Size >= 16; Size -= 16, Data += 16) Y = _mm_xor_si128(Foldby(Y, By128), Load(Data));
+
+                // CRC = Y * x^32 mod P.
+                const auto High = uint64_t(_mm_extract_epi64(Y, 1)), Low = uint64_t(_mm_cvtsi128_si64(Y));
+                auto [T0, T1] = Clmul(High, K96);
+                T0 ^= Low << 32; T1 ^= Low >> 32;
+
+                const auto S = Clmul(T1, K64).first ^ T0;
+                const auto Quotient = Clmul(S >> 32, Mu);
+                const auto Q = (Quotient.first >> 32) | (Quotient.second << 32);
+                const auto Result = uint32_t(S ^ Clmul(Q, (1ULL << 32) | Normal).first);
+
+                return Shiftright ? Reflect(Result) : Result;
+            }
+            #endif
+
+            template <uint32_t Polynomial, bool Shiftright> uint32_t Runtime(std::span<const uint8_t> Input, uint32_t State)
+            {
+                #if defined(HAS_CPUID)
+                if constexpr (Polynomial == 0x82F63B78 && Shiftright)
+                {
+                    if (CPUID::hasSSE42()) return Hardware32C(Input, State);
+                }
+
+                // Setup cost is a few hundred cycles, so only for larger buffers.
+                if (Input.size() >= 256 && CPUID::hasPCLMUL() && CPUID::hasSSSE3() && CPUID::hasSSE41())
+                {
+                    const auto Folded = Input.size() & ~size_t(15);
+                    State = Fold<Polynomial, Shiftright>(Input.first(Folded), State);
+                    return Slice8<Polynomial, Shiftright>(Input.subspan(Folded), State);
+                }
+                #endif
+
+                return Slice8<Polynomial, Shiftright>(Input, State);
+            }
+        }
+
+        template <uint32_t Polynomial, bool Shiftright>
+        constexpr uint32_t CRC32(std::span<const uint8_t> Input, uint32_t IV)
+        {
+            if (std::is_constant_evaluated()) return CRC32Bitwise<Polynomial, Shiftright>(Input, IV);
+            else return ~CRCInternal::Runtime<Polynomial, Shiftright>(Input, IV);
+        }
+
+        // CRC of A + B from CRC(A), CRC(B) and size(B), for checksumming chunks in parallel.
+        template <uint32_t Polynomial, bool Shiftright>
+        constexpr uint32_t CRC32Combine(uint32_t CRC1, uint32_t CRC2, size_t Length2)
+        {
+            return CRCInternal::Multiply<Polynomial, Shiftright>(CRC1, CRCInternal::Power<Polynomial, Shiftright>(uint64_t(Length2) * 8)) ^ CRC2;
+        }
 
         // IEEE CRC32
         constexpr uint32_t CRC32A(std::span<const uint8_t> Input)
@@ -221,12 +482,23 @@ namespace Hash
             return CRC32<0x04C11DB7, false>(Input, 0xFFFFFFFF);
         }
 
+        // Castagnoli CRC32, iSCSI / SSE4.2
+        constexpr uint32_t CRC32C(std::span<const uint8_t> Input)
+        {
+            return CRC32<0x82F63B78, true>(Input, 0xFFFFFFFF);
+        }
+
         // Tencent CRC32
         constexpr uint32_t CRC32T(std::span<const uint8_t> Input)
         {
             return CRC32<0xEDB88320, true>(Input, ~uint32_t(Input.size()));
         }
 
+        // Same IV for both parts, so not usable for CRC32T.
+        constexpr uint32_t CRC32ACombine(uint32_t CRC1, uint32_t CRC2, size_t Length2) { return CRC32Combine<0xEDB88320, true>(CRC1, CRC2, Length2); }
+        constexpr uint32_t CRC32BCombine(uint32_t CRC1, uint32_t CRC2, size_t Length2) { return CRC32Combine<0x04C11DB7, false>(CRC1, CRC2, Length2); }
+        constexpr uint32_t CRC32CCombine(uint32_t CRC1, uint32_t CRC2, size_t Length2) { return CRC32Combine<0x82F63B78, true>(CRC1, CRC2, Length2); }
+
         #pragma endregion
 
         // Forward to the internal hashes.
@@ -254,7 +526,195 @@ namespace Hash
     Impl(FNV1_32); Impl(FNV1_64);
     Impl(FNV1a_32); Impl(FNV1a_64);
     Impl(WW32); Impl(WW64);
-    Impl(CRC32A); Impl(CRC32B); Impl(CRC32T);
+    Impl(CRC32A); Impl(CRC32B); Impl(CRC32C); Impl(CRC32T);
+    using Checksums::CRC32ACombine; using Checksums::CRC32BCombine; using Checksums::CRC32CCombine;
+
+    // Hash many short messages at once, one per SIMD lane, digests are written in input order.
+    namespace Batch
+    {
+        template <typename T> concept Inputs_t = std::ranges::random_access_range<T> && std::ranges::contiguous_range<std::ranges::range_value_t<T>>;
+
+        template <typename T> std::span<const uint8_t> asBytes(const T &Item)
+        {
+            return { reinterpret_cast<const uint8_t *>(std::ranges::data(Item)), std::ranges::size(Item) * sizeof(std::ranges::range_value_t<T>) };
+        }
+
+        namespace Internal
+        {
+            // Full groups go to the kernel, the tail is done one at a time.
+            template <size_t Width, typename T, typename R, typename K, typename S>
+            void Forgroups(const T &Inputs, R *Output, K &&Kernel, S &&Scalar)
+            {
+                const size_t Count = std::ranges::size(Inputs);
+                std::array<std::span<const uint8_t>, Width> Group{};
+                const auto Begin = std::ranges::begin(Inputs);
+                size_t i = 0;
+
+                for (; i + Width <= Count; i += Width)
+                {
+                    for (size_t Lane = 0; Lane < Width; ++Lane) Group[Lane] = asBytes(Begin[i + Lane]);
+                    Kernel(Group.data(), Output + i);
+                }
+
+                for (; i < Count; ++i) Output[i] = Scalar(asBytes(Begin[i]));
+            }
+        }
+
+        #if defined(HAS_CPUID)
+        namespace Lanes64
+        {
+            struct AVX2_t
+            {
+                using Vector = __m256i;
+                static constexpr size_t Width = 4;
+
+                static Vector Set1(uint64_t X) { return _mm256_set1_epi64x(int64_t(X)); }
+                static Vector Load(const std::array<uint64_t, Width> &X) { return _mm256_loadu_si256((const __m256i *)X.data()); }
+                static void Store(std::array<uint64_t, Width> &X, Vector V) { _mm256_storeu_si256((__m256i *)X.data(), V); }
+                static Vector Add(Vector A, Vector B) { return _mm256_add_epi64(A, B); }
+                static Vector Sub(Vector A, Vector B) { return _mm256_sub_epi64(A, B); }
+                static Vector Xor(Vector A, Vector B) { return _mm256_xor_si256(A, B); }
+                static Vector And(Vector A, Vector B) { return _mm256_and_si256(A, B); }
+                static Vector Shl(Vector A, int N) { return _mm256_slli_epi64(A, N); }
+                static Vector Shr(Vector A, int N) { return _mm256_srli_epi64(A, N); }
+
+                // No 64-bit multiply before AVX512DQ, so build it from 32x32 products.
+                static Vector Mul(Vector A, Vector B)
+                {
+                    const auto Cross = _mm256_add_epi64(_mm256_mul_epu32(Shr(A, 32), B), _mm256_mul_epu32(A, Shr(B, 32)));
+                    return _mm256_add_epi64(_mm256_mul_epu32(A, B), Shl(Cross, 32));
+                }
+            };
+            struct AVX512_t
+            {
+                using Vector = __m512i;
+                static constexpr size_t Width = 8;
+
+                static Vector Set1(uint64_t X) { return _mm512_set1_epi64(int64_t(X)); }
+                static Vector Load(const std::array<uint64_t, Width> &X) { return _mm512_loadu_si512(X.data()); }
+                static void Store(std::array<uint64_t, Width> &X, Vector V) { _mm512_storeu_si512(X.data(), V); }
+                static Vector Add(Vector A, Vector B) { return _mm512_add_epi64(A, B); }
+                static Vector Sub(Vector A, Vector B) { return _mm512_sub_epi64(A, B); }
+                static Vector Xor(Vector A, Vector B) { return _mm512_xor_si512(A, B); }
+                static Vector And(Vector A, Vector B) { return _mm512_and_si512(A, B); }
+                static Vector Shl(Vector A, int N) { return _mm512_slli_epi64(A, N); }
+                static Vector Shr(Vector A, int N) { return _mm512_srli_epi64(A, N); }
+
+                // Only AVX512F is required, so same trick as above.
+                static Vector Mul(Vector A, Vector B)
+                {
+                    const auto Cross = _mm512_add_epi64(_mm512_mul_epu32(Shr(A, 32), B), _mm512_mul_epu32(A, Shr(B, 32)));
+                    return _mm512_add_epi64(_mm512_mul_epu32(A, B), Shl(Cross, 32));
+                }
+            };
+
+            // Lanes run in lockstep over the shortest message, the scalar code finishes each tail.
+            template <typename SIMD> void FNV1a_64(const std::span<const uint8_t> *Inputs, uint64_t *Output)
+            {
+                constexpr auto Width = SIMD::Width;
+                std::array<uint64_t, Width> Words{};
+
+                size_t Shared = Inputs[0].size();
+                for (size_t Lane = 1; Lane < Width; ++Lane) Shared = std::min(Shared, Inputs[Lane].size());
+                Shared &= ~size_t(7);
+
+                const auto Prime = SIMD::Set1(Checksums::FNV1_Prime_64);
+                const auto Mask = SIMD::Set1(0xFF);
+                auto Hash = SIMD::Set1(Checksums::FNV1_Offset_64);
+
+                for (size_t Offset = 0; Offset < Shared; Offset += 8)
+                {
+                    for (size_t Lane = 0; Lane < Width; ++Lane) std::memcpy(&Words[Lane], Inputs[Lane].data() + Offset, 8);
+                    auto Bytes = SIMD::Load(Words);
+
+                    for (size_t i = 0; i < 8; ++i)
+                    {
+                        Hash = SIMD::Mul(SIMD::Xor(Hash, SIMD::And(Bytes, Mask)), Prime);
+                        Bytes = SIMD::Shr(Bytes, 8);
+                    }
+                }
+
+                SIMD::Store(Words, Hash);
+                for (size_t Lane = 0; Lane < Width; ++Lane)
+                    Output[Lane] = Checksums::FNV1a_64(Inputs[Lane].subspan(Shared), Words[Lane]);
+            }
+            template <typename SIMD> void WW64(const std::span<const uint8_t> *Inputs, uint64_t *Output)
+            {
+                constexpr auto Width = SIMD::Width;
+                std::array<std::array<uint64_t, Width>, 4> Words{};
+
+                size_t Shared = Inputs[0].size();
+                for (size_t Lane = 1; Lane < Width; ++Lane) Shared = std::min(Shared, Inputs[Lane].size());
+                Shared /= 16;
+
+                const auto Process = [](auto A, auto B)
+                {
+                    const auto Tmp = SIMD::Mul(A, B);
+                    return SIMD::Sub(Tmp, SIMD::Shr(Tmp, 32));
+                };
+
+                const auto P1 = SIMD::Set1(Checksums::_wheatp1), P2 = SIMD::Set1(Checksums::_wheatp2);
+                const auto P3 = SIMD::Set1(Checksums::_wheatp3), P4 = SIMD::Set1(Checksums::_wheatp4);
+                auto Hash = SIMD::Set1(Checksums::_wheatp0);
+
+                for (size_t i = 0; i < Shared; ++i)
+                {
+                    for (size_t Lane = 0; Lane < Width; ++Lane)
+                    {
+                        const auto Offset = Inputs[Lane].data() + i * 16;
+                        for (size_t k = 0; k < 4; ++k) Words[k][Lane] = Checksums::toINT64<32>(Offset + k * 4);
+                    }
+
+                    const auto A = Process(SIMD::Xor(SIMD::Load(Words[0]), P1), SIMD::Xor(SIMD::Load(Words[1]), P2));
+                    const auto B = Process(SIMD::Xor(SIMD::Load(Words[2]), P3), SIMD::Xor(SIMD::Load(Words[3]), P4));
+                    Hash = Process(SIMD::Add(A, Hash), B);
+                }
+
+                SIMD::Store(Words[0], Hash);
+                for (size_t Lane = 0; Lane < Width; ++Lane)
+                    Output[Lane] = Checksums::WW64Final(Checksums::WW64Blocks(Words[0][Lane], Inputs[Lane], Shared), Inputs[Lane]);
+            }
+        }
+        #endif
+
+        template <Inputs_t T> void FNV1a_64(const T &Inputs, std::span<uint64_t> Output)
+        {
+            ASSERT(Output.size() >= std::ranges::size(Inputs));
+            constexpr auto Scalar = [](std::span<const uint8_t> Input) { return Checksums::FNV1a_64(Input); };
+
+            #if defined(HAS_CPUID)
+            if (CPUID::hasAVX512F()) return Internal::Forgroups<8>(Inputs, Output.data(), Lanes64::FNV1a_64<Lanes64::AVX512_t>, Scalar);
+            if (CPUID::hasAVX2()) return Internal::Forgroups<4>(Inputs, Output.data(), Lanes64::FNV1a_64<Lanes64::AVX2_t>, Scalar);
+            #endif
+
+            Internal::Forgroups<1>(Inputs, Output.data(), [&](const std::span<const uint8_t> *Input, uint64_t *Result) { *Result = Scalar(*Input); }, Scalar);
+        }
+        template <Inputs_t T> void WW64(const T &Inputs, std::span<uint64_t> Output)
+        {
+            ASSERT(Output.size() >= std::ranges::size(Inputs));
+            constexpr auto Scalar = [](std::span<const uint8_t> Input) { return Checksums::WW64(Input); };
+
+            #if defined(HAS_CPUID)
+            if (CPUID::hasAVX512F()) return Internal::Forgroups<8>(Inputs, Output.data(), Lanes64::WW64<Lanes64::AVX512_t>, Scalar);
+            if (CPUID::hasAVX2()) return Internal::Forgroups<4>(Inputs, Output.data(), Lanes64::WW64<Lanes64::AVX2_t>, Scalar);
+            #endif
+
+            Internal::Forgroups<1>(Inputs, Output.data(), [&](const std::span<const uint8_t> *Input, uint64_t *Result) { *Result = Scalar(*Input); }, Scalar);
+        }
+
+        template <Inputs_t T> [[nodiscard]] std::vector<uint64_t> FNV1a_64(const T &Inputs)
+        {
+            std::vector<uint64_t> Output(std::ranges::size(Inputs));
+            FNV1a_64(Inputs, Output);
+            return Output;
+        }
+        template <Inputs_t T> [[nodiscard]] std::vector<uint64_t> WW64(const T &Inputs)
+        {
+            std::vector<uint64_t> Output(std::ranges::size(Inputs));
+            WW64(Inputs, Output);
+            return Output;
+        }
+    }
 }
 
 // Drop-in generic functions for std:: algorithms, containers, and such.
@@ -288,9 +748,78 @@ namespace Unittests
     static_assert(Hash::CRC32A("12345") == 0xCBF53A1CUL, "BROKEN: CRC32-B checksum");
     static_assert(Hash::CRC32B("12345") == 0x426548B8UL, "BROKEN: CRC32-A checksum");
     static_assert(Hash::CRC32T("12345") == 0x0315B56CUL, "BROKEN: CRC32-T checksum");
+    static_assert(Hash::CRC32C("123456789") == 0xE3069283UL, "BROKEN: CRC32-C checksum");
+    static_assert(Hash::CRC32ACombine(Hash::CRC32A("123"), Hash::CRC32A("45"), 2) == 0xCBF53A1CUL, "BROKEN: CRC32-A combine");
+    static_assert(Hash::CRC32BCombine(Hash::CRC32B("123"), Hash::CRC32B("45"), 2) == 0x426548B8UL, "BROKEN: CRC32-B combine");
     static_assert(Hash::FNV1a_32("12345") == 0x43C2C0D8UL, "BROKEN: FNV32a checksum");
     static_assert(Hash::WW64("12345") == 0x3C570C468027DB01ULL, "BROKEN: WW64 checksum");
     static_assert(Hash::FNV1_64("12345") == 0xA92F4455DA95A77AULL, "BROKEN: FNV64 checksum");
     static_assert(Hash::FNV1a_64("12345") == 0xE575E8883C0F89F8ULL, "BROKEN: FNV64a checksum");
+
+    inline void Checksumtest()
+    {
+        // Uneven lengths so that lanes diverge and groups have tails.
+        std::vector<std::string> Messages;
+        for (size_t i = 0; i < 37; ++i) Messages.emplace_back(i * 7 % 113, char('a' + i % 26));
+
+        const auto FNV = Hash::Batch::FNV1a_64(Messages);
+        const auto WW = Hash::Batch::WW64(Messages);
+
+        for (size_t i = 0; i < Messages.size(); ++i)
+        {
+            if (FNV[i] != Hash::FNV1a_64(Messages[i])) { printf("BROKEN: Batched FNV1a_64\n"); return; }
+            if (WW[i] != Hash::WW64(Messages[i])) { printf("BROKEN: Batched WW64\n"); return; }
+        }
+
+        // Runtime CRC engines against the bitwise reference, the sizes cover both sides of the folding threshold.
+        std::vector<uint8_t> Buffer(4099);
+        for (size_t i = 0; i < Buffer.size(); ++i) Buffer[i] = uint8_t(i * 131 + 17);
+
+        for (const size_t Size : { 0, 1, 7, 8, 15, 63, 64, 255, 256, 257, 1024, 4099 })
+        {
+            const auto Span = std::span<const uint8_t>(Buffer).first(Size);
+            const auto Split = Size / 3;
+
+            if (Hash::Checksums::CRC32A(Span) != Hash::Checksums::CRC32Bitwise<0xEDB88320, true>(Span, 0xFFFFFFFF)) printf("BROKEN: CRC32-A runtime (%zu bytes)\n", Size);
+            if (Hash::Checksums::CRC32B(Span) != Hash::Checksums::CRC32Bitwise<0x04C11DB7, false>(Span, 0xFFFFFFFF)) printf("BROKEN: CRC32-B runtime (%zu bytes)\n", Size);
+            if (Hash::Checksums::CRC32C(Span) != Hash::Checksums::CRC32Bitwise<0x82F63B78, true>(Span, 0xFFFFFFFF)) printf("BROKEN: CRC32-C runtime (%zu bytes)\n", Size);
+            if (Hash::Checksums::CRC32T(Span) != Hash::Checksums::CRC32Bitwise<0xEDB88320, true>(Span, ~uint32_t(Size))) printf("BROKEN: CRC32-T runtime (%zu bytes)\n", Size);
+
+            if (Hash::CRC32CCombine(Hash::Checksums::CRC32C(Span.first(Split)), Hash::Checksums::CRC32C(Span.subspan(Split)), Size - Split) != Hash::Checksums::CRC32C(Span))
+                printf("BROKEN: CRC32-C combine (%zu bytes)\n", Size);
+        }
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // Bulk throughput and the short-key latency that matters for hashmaps.
+    inline void Checksumbenchmark()
+    {
+        const auto Bulk = Randombytes(1024 * 1024);
+        const auto Short = std::span(Bulk).first(16);
+
+        Measure("Hash::CRC32A (1 MiB)", Bulk.size(), [&]() { Keep(Hash::CRC32A(Bulk)); });
+        Measure("Hash::CRC32B (1 MiB)", Bulk.size(), [&]() { Keep(Hash::CRC32B(Bulk)); });
+        Measure("Hash::CRC32C (1 MiB)", Bulk.size(), [&]() { Keep(Hash::CRC32C(Bulk)); });
+        Measure("Hash::WW32 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::WW32(Bulk)); });
+        Measure("Hash::WW64 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::WW64(Bulk)); });
+        Measure("Hash::FNV1a_32 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::FNV1a_32(Bulk)); });
+        Measure("Hash::FNV1a_64 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::FNV1a_64(Bulk)); });
+
+        Measure("Hash::CRC32C (16 bytes)", Short.size(), [&]() { Keep(Hash::CRC32C(Short)); });
+        Measure("Hash::WW64 (16 bytes)", Short.size(), [&]() { Keep(Hash::WW64(Short)); });
+        Measure("Hash::FNV1a_64 (16 bytes)", Short.size(), [&]() { Keep(Hash::FNV1a_64(Short)); });
+
+        std::vector<std::string> Keys{};
+        for (size_t i = 0; i < 256; ++i) Keys.emplace_back(8 + i % 24, char('a' + i % 26));
+        size_t Keybytes{};
+        for (const auto &Key : Keys) Keybytes += Key.size();
+
+        Measure("Hash::Batch::WW64 (256 keys)", Keybytes, [&]() { Keep(Hash::Batch::WW64(Keys)); });
+        Measure("Hash::Batch::FNV1a_64 (256 keys)", Keybytes, [&]() { Keep(Hash::Batch::FNV1a_64(Keys)); });
+    }
 }
 #endif
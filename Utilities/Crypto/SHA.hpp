@@ -8,6 +8,7 @@
 
 #pragma once
 #include <Utilities.hpp>
+#include <intrin.h>
 
 #if __has_include(<openssl/evp.h>)
 #include <openssl/evp.h>
@@ -205,35 +206,361 @@ namespace Hash
             return std::bit_cast<std::array<uint8_t, 64>>(State);
         }
     }
+    namespace Hardware
+    {
+        using namespace SHAData;
+
+        // SHA-NI, Input.size() must be a multiple of 64.
+        inline void Transform256(std::array<uint32_t, 8> &State, std::span<const uint8_t> Input)
+        {
+            const auto Mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+            // The instructions want the state as ABEF and CDGH.
+            auto Temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&State[0])), 0xB1);
+            auto State1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&State[4])), 0x1B);
+            auto State0 = _mm_alignr_epi8(Temp, State1, 8);
+            State1 = _mm_blend_epi16(State1, Temp, 0xF0);
+
+            for (size_t Offset = 0; Offset + 64 <= Input.size(); Offset += 64)
+            {
+                const auto Save0 = State0, Save1 = State1;
+                std::array<__m128i, 4> Message;
+
+                // Four rounds per group, the schedule is computed three groups ahead.
+                for (size_t Group = 0; Group < 16; ++Group)
+                {
+                    auto &Current = Message[Group % 4];
+                    if (Group < 4) Current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Input.data() + Offset + Group * 16)), Mask);
+
+                    auto Words = _mm_add_epi32(Current, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&kSHA256[Group * 4])));
+                    State1 = _mm_sha256rnds2_epu32(State1, State0, Words);
+
+                    if (Group >= 3 && Group < 15)
+                    {
+                        auto &Next = Message[(Group + 1) % 4];
+                        Next = _mm_add_epi32(Next, _mm_alignr_epi8(Current, Message[(Group + 3) % 4], 4));
+                        Next = _mm_sha256msg2_epu32(Next, Current);
+                    }
+
+                    Words = _mm_shuffle_epi32(Words, 0x0E);
+                    State0 = _mm_sha256rnds2_epu32(State0, State1, Words);
+
+                    if (Group >= 1 && Group < 13)
+                    {
+                        auto &Previous = Message[(Group + 3) % 4];
+                        Previous = _mm_sha256msg1_epu32(Previous, Current);
+                    }
+                }
+
+                State0 = _mm_add_epi32(State0, Save0);
+                State1 = _mm_add_epi32(State1, Save1);
+            }
+
+            // Back to ABCD and EFGH.
+            Temp = _mm_shuffle_epi32(State0, 0x1B);
+            State1 = _mm_shuffle_epi32(State1, 0xB1);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&State[0]), _mm_blend_epi16(Temp, State1, 0xF0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(&State[4]), _mm_alignr_epi8(State1, Temp, 8));
+        }
+
+        inline bool hasIntrinsics()
+        {
+            return CPUID::hasSHA() && CPUID::hasSSE41();
+        }
+
+        // Multi-buffer SHA256, one independent message per 32-bit lane.
+        namespace Lanes32
+        {
+            struct AVX2_t
+            {
+                using Vector = __m256i;
+                static constexpr size_t Width = 8;
+
+                static Vector Set1(uint32_t X) { return _mm256_set1_epi32(int(X)); }
+                static Vector Load(const std::array<uint32_t, Width> &X) { return _mm256_loadu_si256((const __m256i *)X.data()); }
+                static void Store(std::array<uint32_t, Width> &X, Vector V) { _mm256_storeu_si256((__m256i *)X.data(), V); }
+                static Vector Add(Vector A, Vector B) { return _mm256_add_epi32(A, B); }
+                static Vector Xor(Vector A, Vector B) { return _mm256_xor_si256(A, B); }
+                static Vector And(Vector A, Vector B) { return _mm256_and_si256(A, B); }
+                static Vector Andnot(Vector A, Vector B) { return _mm256_andnot_si256(A, B); }
+                static Vector Shr(Vector A, int N) { return _mm256_srli_epi32(A, N); }
+                static Vector Ror(Vector A, int N) { return _mm256_or_si256(_mm256_srli_epi32(A, N), _mm256_slli_epi32(A, 32 - N)); }
+
+                // Active lanes take the new value.
+                static Vector Select(Vector Old, Vector New, const std::array<uint32_t, Width> &Active)
+                {
+                    return _mm256_blendv_epi8(Old, New, Load(Active));
+                }
+            };
+            struct AVX512_t
+            {
+                using Vector = __m512i;
+                static constexpr size_t Width = 16;
+
+                static Vector Set1(uint32_t X) { return _mm512_set1_epi32(int(X)); }
+                static Vector Load(const std::array<uint32_t, Width> &X) { return _mm512_loadu_si512(X.data()); }
+                static void Store(std::array<uint32_t, Width> &X, Vector V) { _mm512_storeu_si512(X.data(), V); }
+                static Vector Add(Vector A, Vector B) { return _mm512_add_epi32(A, B); }
+                static Vector Xor(Vector A, Vector B) { return _mm512_xor_si512(A, B); }
+                static Vector And(Vector A, Vector B) { return _mm512_and_si512(A, B); }
+                static Vector Andnot(Vector A, Vector B) { return _mm512_andnot_si512(A, B); }
+                static Vector Shr(Vector A, int N) { return _mm512_srli_epi32(A, N); }
+                static Vector Ror(Vector A, int N) { return _mm512_rorv_epi32(A, Set1(N)); }
+
+                static Vector Select(Vector Old, Vector New, const std::array<uint32_t, Width> &Active)
+                {
+                    return _mm512_mask_blend_epi32(_mm512_test_epi32_mask(Load(Active), Load(Active)), Old, New);
+                }
+            };
+
+            // Block Index of the padded message.
+            inline void Padblock(uint8_t *Block, std::span<const uint8_t> Input, size_t Index, size_t Blockcount)
+            {
+                const size_t Offset = Index * 64;
+                const size_t Available = Offset < Input.size() ? std::min<size_t>(64, Input.size() - Offset) : 0;
+
+                if (Available) std::memcpy(Block, Input.data() + Offset, Available);
+                std::memset(Block + Available, 0, 64 - Available);
+
+                if (Input.size() >= Offset && Input.size() < Offset + 64) Block[Input.size() - Offset] = 0x80;
+                if (Index + 1 == Blockcount)
+                {
+                    const auto Bits = cmp::toBig(uint64_t(Input.size()) * 8);
+                    std::memcpy(Block + 56, &Bits, sizeof(Bits));
+                }
+            }
+
+            // Lanes that run out of blocks are masked off until the longest message is done.
+            template <typename SIMD> void SHA256(const std::span<const uint8_t> *Inputs, std::array<uint8_t, 32> *Output)
+            {
+                using Vector = typename SIMD::Vector;
+                constexpr auto Width = SIMD::Width;
+
+                std::array<std::array<uint32_t, Width>, 16> Words{};
+                std::array<uint32_t, Width> Active{};
+                std::array<size_t, Width> Blockcount{};
+                std::array<uint8_t, 64> Block{};
+                size_t Maxblocks = 0;
+
+                for (size_t Lane = 0; Lane < Width; ++Lane)
+                {
+                    Blockcount[Lane] = (Inputs[Lane].size() + 8) / 64 + 1;
+                    Maxblocks = std::max(Maxblocks, Blockcount[Lane]);
+                }
+
+                std::array<Vector, 8> State;
+                for (size_t i = 0; i < 8; ++i) State[i] = SIMD::Set1(sSHA256[i]);
+
+                for (size_t Index = 0; Index < Maxblocks; ++Index)
+                {
+                    // Transpose so that each vector holds the same word from every lane.
+                    for (size_t Lane = 0; Lane < Width; ++Lane)
+                    {
+                        Active[Lane] = Index < Blockcount[Lane] ? ~0U : 0U;
+                        if (!Active[Lane]) continue;
+
+                        Padblock(Block.data(), Inputs[Lane], Index, Blockcount[Lane]);
+                        for (size_t i = 0; i < 16; ++i)
+                        {
+                            uint32_t Word;
+                            std::memcpy(&Word, Block.data() + i * 4, sizeof(Word));
+                            Words[i][Lane] = cmp::toBig(Word);
+                        }
+                    }
+
+                    std::array<Vector, 16> Scratch;
+                    for (size_t i = 0; i < 16; ++i) Scratch[i] = SIMD::Load(Words[i]);
+
+                    auto Copy = State;
+                    for (size_t i = 0; i < 64; ++i)
+                    {
+                        if (i >= 16)
+                        {
+                            const auto &W15 = Scratch[(i - 15) % 16], &W2 = Scratch[(i - 2) % 16];
+                            const auto Sigma0 = SIMD::Xor(SIMD::Xor(SIMD::Ror(W15, 7), SIMD::Ror(W15, 18)), SIMD::Shr(W15, 3));
+                            const auto Sigma1 = SIMD::Xor(SIMD::Xor(SIMD::Ror(W2, 17), SIMD::Ror(W2, 19)), SIMD::Shr(W2, 10));
+                            Scratch[i % 16] = SIMD::Add(SIMD::Add(Scratch[i % 16], Sigma0), SIMD::Add(Scratch[(i - 7) % 16], Sigma1));
+                        }
+
+                        const auto Sigma0 = SIMD::Xor(SIMD::Xor(SIMD::Ror(Copy[0], 2), SIMD::Ror(Copy[0], 13)), SIMD::Ror(Copy[0], 22));
+                        const auto Sigma1 = SIMD::Xor(SIMD::Xor(SIMD::Ror(Copy[4], 6), SIMD::Ror(Copy[4], 11)), SIMD::Ror(Copy[4], 25));
+                        const auto Maj = SIMD::Xor(SIMD::And(Copy[0], Copy[1]), SIMD::And(SIMD::Xor(Copy[0], Copy[1]), Copy[2]));
+                        const auto Ch = SIMD::Xor(SIMD::And(Copy[4], Copy[5]), SIMD::Andnot(Copy[4], Copy[6]));
+                        const auto t1 = SIMD::Add(SIMD::Add(Copy[7], Sigma1), SIMD::Add(SIMD::Add(Ch, SIMD::Set1(kSHA256[i])), Scratch[i % 16]));
+                        const auto t2 = SIMD::Add(Sigma0, Maj);
+
+                        Copy[7] = Copy[6];
+                        Copy[6] = Copy[5];
+                        Copy[5] = Copy[4];
+                        Copy[4] = SIMD::Add(Copy[3], t1);
+                        Copy[3] = Copy[2];
+                        Copy[2] = Copy[1];
+                        Copy[1] = Copy[0];
+                        Copy[0] = SIMD::Add(t1, t2);
+                    }
+
+                    for (size_t i = 0; i < 8; ++i) State[i] = SIMD::Select(State[i], SIMD::Add(State[i], Copy[i]), Active);
+                }
+
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    SIMD::Store(Active, State[i]);
+                    for (size_t Lane = 0; Lane < Width; ++Lane)
+                    {
+                        const auto Word = cmp::toBig(Active[Lane]);
+                        std::memcpy(Output[Lane].data() + i * 4, &Word, sizeof(Word));
+                    }
+                }
+            }
+        }
+    }
+
+    // Incremental hashing for when the input isn't available all at once.
+    template <size_t Bits> requires (Bits == 256 || Bits == 512) struct SHAState_t
+    {
+        using Word_t = std::conditional_t<Bits == 256, uint32_t, uint64_t>;
+        static constexpr size_t Blocksize = Bits == 256 ? 64 : 128;
+
+        std::array<Word_t, 8> State{};
+        std::array<uint8_t, Blocksize> Block{};
+        uint64_t Messagelength{};
+        uint8_t Fillcount{};
+
+        constexpr void Init()
+        {
+            if constexpr (Bits == 256) State = SHAData::sSHA256;
+            else State = SHAData::sSHA512;
+
+            Messagelength = 0;
+            Fillcount = 0;
+        }
+        constexpr void Update(std::span<const uint8_t> Input)
+        {
+            Messagelength += Input.size();
+
+            // Top up the partial block first.
+            if (Fillcount != 0)
+            {
+                const auto Count = std::min(Blocksize - Fillcount, Input.size());
+                for (size_t i = 0; i < Count; ++i) Block[Fillcount + i] = Input[i];
+
+                Fillcount += uint8_t(Count);
+                Input = Input.subspan(Count);
+
+                if (Fillcount < Blocksize) return;
+                Transform(Block);
+                Fillcount = 0;
+            }
+
+            // Whole blocks straight from the input.
+            if (const auto Count = Input.size() - (Input.size() % Blocksize))
+            {
+                Transform(Input.first(Count));
+                Input = Input.subspan(Count);
+            }
+
+            for (size_t i = 0; i < Input.size(); ++i) Block[i] = Input[i];
+            Fillcount = uint8_t(Input.size());
+        }
+        template <typename T> constexpr void Update(const T &Input)
+        {
+            // No need to copy contiguous ranges at runtime.
+            if constexpr (std::ranges::contiguous_range<T>)
+            {
+                if (!std::is_constant_evaluated())
+                    return Update(std::span<const uint8_t>(reinterpret_cast<const uint8_t *>(std::ranges::data(Input)), std::ranges::size(Input) * sizeof(std::ranges::range_value_t<T>)));
+            }
+
+            const auto Bytes = cmp::getBytes(Input);
+            Update(std::span<const uint8_t>(Bytes));
+        }
+        template <cmp::Char_t T, size_t N> constexpr void Update(const T(&Input)[N])
+        {
+            Update(cmp::stripNullchar(Input));
+        }
+
+        // The state needs to be re-initialized before being reused.
+        constexpr std::array<uint8_t, Bits / 8> Final()
+        {
+            constexpr size_t Lengthoffset = Blocksize - 8;
+
+            Block[Fillcount++] = 0x80;
+            for (size_t i = Fillcount; i < Blocksize; ++i) Block[i] = 0;
+
+            // Need another block for the length.
+            if (Fillcount > Blocksize - (Bits == 256 ? 8 : 16))
+            {
+                Transform(Block);
+                Block = {};
+            }
+
+            const auto Length = std::bit_cast<std::array<uint8_t, 8>>(cmp::toBig<uint64_t>(Messagelength << 3));
+            for (size_t i = 0; i < 8; ++i) Block[Lengthoffset + i] = Length[i];
+            Transform(Block);
+
+            for (size_t i = 0; i < 8; ++i) State[i] = cmp::toBig(State[i]);
+            return std::bit_cast<std::array<uint8_t, Bits / 8>>(State);
+        }
+
+        constexpr SHAState_t() { Init(); }
+
+        private:
+        constexpr void Transform(std::span<const uint8_t> Input)
+        {
+            if constexpr (Bits == 256)
+            {
+                if (!std::is_constant_evaluated() && Hardware::hasIntrinsics())
+                    return Hardware::Transform256(State, Input);
+            }
+
+            for (size_t Offset = 0; Offset < Input.size(); Offset += Blocksize)
+            {
+                if constexpr (Bits == 256) Compiletime::Transform256(State, Input.subspan(Offset, Blocksize));
+                else Compiletime::Transform512(State, Input.subspan(Offset, Blocksize));
+            }
+        }
+    };
+    using SHA256_t = SHAState_t<256>;
+    using SHA512_t = SHAState_t<512>;
+
     namespace Runtime
     {
+        #if __has_include(<openssl/evp.h>)
+        // One context per thread, re-initialized rather than re-allocated per digest.
+        inline EVP_MD_CTX *getContext()
+        {
+            thread_local const std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> Context{ EVP_MD_CTX_new(), &EVP_MD_CTX_free };
+            return Context.get();
+        }
+        #endif
+
         // If built with OpenSSL, use the (possibly) hardware accelerated engine.
         inline std::array<uint8_t, 32> SHA256(std::span<const uint8_t> Input)
         {
             #if __has_include(<openssl/evp.h>)
-            const auto Context = EVP_MD_CTX_create();
+            const auto Context = getContext();
             std::array<uint8_t, 32> Result{};
 
             EVP_DigestInit_ex(Context, EVP_sha256(), nullptr);
             EVP_DigestUpdate(Context, Input.data(), Input.size());
             EVP_DigestFinal_ex(Context, (unsigned char *)Result.data(), nullptr);
-            EVP_MD_CTX_destroy(Context);
 
             return Result;
             #else
-            return Compiletime::SHA256(Input);
+            SHA256_t State{};
+            State.Update(Input);
+            return State.Final();
             #endif
         }
         inline std::array<uint8_t, 64> SHA512(std::span<const uint8_t> Input)
         {
             #if __has_include(<openssl/evp.h>)
-            const auto Context = EVP_MD_CTX_create();
+            const auto Context = getContext();
             std::array<uint8_t, 64> Result{};
 
             EVP_DigestInit_ex(Context, EVP_sha512(), nullptr);
             EVP_DigestUpdate(Context, Input.data(), Input.size());
             EVP_DigestFinal_ex(Context, (unsigned char *)Result.data(), nullptr);
-            EVP_MD_CTX_destroy(Context);
 
             return Result;
             #else
@@ -273,6 +600,27 @@ namespace Hash
     {
         return SHA512(cmp::getBytes(cmp::stripNullchar(Input)));
     }
+
+    namespace Batch
+    {
+        // SHA-NI beats eight AVX2 lanes, sixteen AVX-512 lanes beat SHA-NI.
+        template <Inputs_t T> void SHA256(const T &Inputs, std::span<std::array<uint8_t, 32>> Output)
+        {
+            ASSERT(Output.size() >= std::ranges::size(Inputs));
+            constexpr auto Scalar = [](std::span<const uint8_t> Input) { return Runtime::SHA256(Input); };
+
+            if (CPUID::hasAVX512F()) return Internal::Forgroups<16>(Inputs, Output.data(), Hardware::Lanes32::SHA256<Hardware::Lanes32::AVX512_t>, Scalar);
+            if (!Hardware::hasIntrinsics() && CPUID::hasAVX2()) return Internal::Forgroups<8>(Inputs, Output.data(), Hardware::Lanes32::SHA256<Hardware::Lanes32::AVX2_t>, Scalar);
+
+            Internal::Forgroups<1>(Inputs, Output.data(), [&](const std::span<const uint8_t> *Input, std::array<uint8_t, 32> *Result) { *Result = Scalar(*Input); }, Scalar);
+        }
+        template <Inputs_t T> [[nodiscard]] std::vector<std::array<uint8_t, 32>> SHA256(const T &Inputs)
+        {
+            std::vector<std::array<uint8_t, 32>> Output(std::ranges::size(Inputs));
+            SHA256(Inputs, Output);
+            return Output;
+        }
+    }
 }
 
 #if defined(ENABLE_UNITTESTS)
@@ -280,5 +628,64 @@ namespace Unittests
 {
     static_assert("5994471abb01112afcc18159f6cc74b4f511b99806da59b3caf5a9c173cacfc5" == String::toHex(Hash::SHA256("12345")), "BROKEN: SHA256 hashing");
     static_assert("3627909a29c31381a071ec27f7c9ca97726182aed29a7ddd2e54353322cfb30abb9e3a6df2ac2c20fe23436311d678564d0c8d305930575f60e2d3d048184d79" == String::toHex(Hash::SHA512("12345")), "BROKEN: SHA512 hashing");
+
+    static_assert("5994471abb01112afcc18159f6cc74b4f511b99806da59b3caf5a9c173cacfc5" == String::toHex([]()
+    {
+        Hash::SHA256_t State{};
+        State.Update("123");
+        State.Update("45");
+        return State.Final();
+    }()), "BROKEN: SHA256 incremental hashing");
+
+    // Hardware transforms and block-boundaries against the constexpr one-shot.
+    inline void SHAtest()
+    {
+        std::vector<uint8_t> Input(1000);
+        for (size_t i = 0; i < Input.size(); ++i) Input[i] = uint8_t(i * 31 + 7);
+
+        for (const size_t Size : { 0, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129, 1000 })
+        {
+            const auto Span = std::span<const uint8_t>(Input).first(Size);
+            Hash::SHA256_t State256{};
+            Hash::SHA512_t State512{};
+
+            // Uneven chunks to cross the block boundaries.
+            for (size_t Offset = 0; Offset < Size; Offset += 37)
+            {
+                State256.Update(Span.subspan(Offset, std::min<size_t>(37, Size - Offset)));
+                State512.Update(Span.subspan(Offset, std::min<size_t>(37, Size - Offset)));
+            }
+
+            if (State256.Final() != Hash::Compiletime::SHA256(Span)) printf("BROKEN: SHA256 incremental (%zu bytes)\n", Size);
+            if (State512.Final() != Hash::Compiletime::SHA512(Span)) printf("BROKEN: SHA512 incremental (%zu bytes)\n", Size);
+            if (Hash::Runtime::SHA256(Span) != Hash::Compiletime::SHA256(Span)) printf("BROKEN: SHA256 runtime (%zu bytes)\n", Size);
+        }
+
+        // Lengths around the padding boundaries, with a short last group.
+        std::vector<std::span<const uint8_t>> Messages;
+        for (size_t i = 0; i < 53; ++i) Messages.push_back(std::span<const uint8_t>(Input).subspan(i, (i * 29) % 200));
+
+        const auto Digests = Hash::Batch::SHA256(Messages);
+        for (size_t i = 0; i < Messages.size(); ++i)
+            if (Digests[i] != Hash::Compiletime::SHA256(Messages[i])) printf("BROKEN: SHA256 batched (%zu bytes)\n", Messages[i].size());
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void SHAbenchmark()
+    {
+        const auto Bulk = Randombytes(1024 * 1024);
+        const auto Short = std::span(Bulk).first(64);
+
+        Measure("Hash::SHA256 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::SHA256(Bulk)); });
+        Measure("Hash::SHA512 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::SHA512(Bulk)); });
+        Measure("Hash::SHA256 (64 bytes)", Short.size(), [&]() { Keep(Hash::SHA256(Short)); });
+
+        std::vector<std::string> Messages(64, std::string(64, 'x'));
+        Measure("Hash::Batch::SHA256 (64 x 64 bytes)", 64 * 64, [&]() { Keep(Hash::Batch::SHA256(Messages)); });
+    }
 }
 #endif
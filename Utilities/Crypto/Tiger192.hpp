@@ -372,7 +372,7 @@ namespace Hash
             State.tryFlush();
 
             // Save how many bytes we originally had.
-            const auto Messagelength = static_cast<uint64_t>(State.Blockcount * 64ULL + State.Fillcount * 8ULL);
+            const auto Messagelength = static_cast<uint64_t>((State.Blockcount * 64ULL + State.Fillcount) * 8ULL);
 
             // Add padding as necessary.
             auto Block = std::bit_cast<std::array<uint8_t, 64>>(State.Block);
@@ -458,11 +458,190 @@ namespace Hash
     {
         return Tiger192(cmp::getBytes(cmp::stripNullchar(Input)));
     }
+
+    // Merkle tree of Tiger192 over 1 KiB leaves, compatible with THEX / TTH.
+    struct Tigertree_t
+    {
+        using Digest_t = std::array<uint8_t, 24>;
+        static constexpr size_t Leafsize = 1024;
+
+        // Levels[0] are the leaves, Levels.back() holds the root.
+        std::vector<std::vector<Digest_t>> Levels{};
+        uint64_t Inputsize{};
+
+        [[nodiscard]] Digest_t Root() const
+        {
+            return Levels.empty() ? Digest_t{} : Levels.back().front();
+        }
+
+        // Leaves get a 0x00 prefix, interior nodes 0x01, to keep them from colliding.
+        static Digest_t Hashleaf(std::span<const uint8_t> Input)
+        {
+            constexpr uint8_t Prefix = 0x00;
+            Tigerinternal::State_t State{};
+
+            Tigerinternal::Write(State, std::span(&Prefix, 1));
+            if (!Input.empty()) Tigerinternal::Write(State, Input);
+            return Tigerinternal::Finalize(State);
+        }
+        static Digest_t Hashnode(const Digest_t &Left, const Digest_t &Right)
+        {
+            std::array<uint8_t, 1 + 2 * sizeof(Digest_t)> Buffer{ 0x01 };
+            std::memcpy(Buffer.data() + 1, Left.data(), Left.size());
+            std::memcpy(Buffer.data() + 1 + Left.size(), Right.data(), Right.size());
+
+            Tigerinternal::State_t State{};
+            Tigerinternal::Write(State, std::span<const uint8_t>(Buffer));
+            return Tigerinternal::Finalize(State);
+        }
+
+        // Hash everything, leaves and wide levels are split over Threadcount workers (0 = all cores).
+        static Tigertree_t Build(std::span<const uint8_t> Input, size_t Threadcount = 0)
+        {
+            Tigertree_t Tree{};
+            Tree.Inputsize = Input.size();
+            if (Threadcount == 0) Threadcount = std::max(1U, std::thread::hardware_concurrency());
+
+            const size_t Leafcount = std::max<size_t>(1, (Input.size() + Leafsize - 1) / Leafsize);
+            Tree.Levels.emplace_back(Leafcount);
+            Parallel(Leafcount, Threadcount, [&](size_t i) { Tree.Levels[0][i] = Hashleaf(Tree.Leaf(Input, i)); });
+
+            while (Tree.Levels.back().size() > 1)
+            {
+                const auto &Below = Tree.Levels.back();
+                std::vector<Digest_t> Level((Below.size() + 1) / 2);
+
+                Parallel(Level.size(), Threadcount, [&](size_t i) { Level[i] = Tree.Combine(Below, i); });
+                Tree.Levels.emplace_back(std::move(Level));
+            }
+
+            return Tree;
+        }
+
+        // Re-hash only the leaves covering [Offset, Offset + Length) and compare against the stored tree.
+        [[nodiscard]] bool Verify(std::span<const uint8_t> Input, size_t Offset, size_t Length) const
+        {
+            if (Levels.empty() || Input.size() != Inputsize) return false;
+
+            const auto [First, Last] = Leafrange(Offset, Length);
+            for (size_t i = First; i < Last; ++i)
+            {
+                if (Hashleaf(Leaf(Input, i)) != Levels[0][i]) return false;
+            }
+
+            return true;
+        }
+
+        // Re-hash the leaves covering the modified range and the path to the root, the size must be unchanged.
+        void Update(std::span<const uint8_t> Input, size_t Offset, size_t Length)
+        {
+            ASSERT(!Levels.empty() && Input.size() == Inputsize);
+
+            auto [First, Last] = Leafrange(Offset, Length);
+            for (size_t i = First; i < Last; ++i) Levels[0][i] = Hashleaf(Leaf(Input, i));
+
+            for (size_t Level = 1; Level < Levels.size() && First < Last; ++Level)
+            {
+                First /= 2;
+                Last = (Last + 1) / 2;
+
+                for (size_t i = First; i < Last; ++i) Levels[Level][i] = Combine(Levels[Level - 1], i);
+            }
+        }
+
+    private:
+        std::span<const uint8_t> Leaf(std::span<const uint8_t> Input, size_t Index) const
+        {
+            const auto Offset = Index * Leafsize;
+            if (Offset >= Input.size()) return {};
+            return Input.subspan(Offset, std::min(Leafsize, Input.size() - Offset));
+        }
+        std::pair<size_t, size_t> Leafrange(size_t Offset, size_t Length) const
+        {
+            const auto Count = Levels[0].size();
+            const auto First = std::min(Count, Offset / Leafsize);
+            const auto Last = Length ? std::min(Count, (Offset + Length + Leafsize - 1) / Leafsize) : First;
+            return { First, Last };
+        }
+
+        // An odd node out is promoted unchanged.
+        static Digest_t Combine(const std::vector<Digest_t> &Below, size_t Index)
+        {
+            if (Index * 2 + 1 == Below.size()) return Below[Index * 2];
+            return Hashnode(Below[Index * 2], Below[Index * 2 + 1]);
+        }
+
+        // Workers pull batches from a shared counter, small jobs stay on the calling thread.
+        template <typename F> static void Parallel(size_t Count, size_t Threadcount, F &&Func)
+        {
+            constexpr size_t Batchsize = 64;
+            Threadcount = std::min(Threadcount, (Count + Batchsize - 1) / Batchsize);
+
+            if (Threadcount <= 1)
+            {
+                for (size_t i = 0; i < Count; ++i) Func(i);
+                return;
+            }
+
+            std::atomic<size_t> Next{};
+            const auto Worker = [&]()
+            {
+                for (auto First = Next.fetch_add(Batchsize); First < Count; First = Next.fetch_add(Batchsize))
+                {
+                    for (size_t i = First; i < std::min(Count, First + Batchsize); ++i) Func(i);
+                }
+            };
+
+            std::vector<std::jthread> Workers;
+            Workers.reserve(Threadcount - 1);
+            for (size_t i = 1; i < Threadcount; ++i) Workers.emplace_back(Worker);
+            Worker();
+        }
+    };
 }
 
 #if defined(ENABLE_UNITTESTS)
 namespace Unittests
 {
     static_assert("61d26192cf832c07612c541552d80027bbb3f520064f48ec" == String::toHex(Hash::Tiger192("12345")), "BROKEN: Tiger192 hashing");
+    static_assert("48ceeb6308b87d46e95d656112cdf18d97915f9765658957" == String::toHex(Hash::Tiger192("ABCDEFGHIJKLMNOPQRSTUVWXYZ=abcdefghijklmnopqrstuvwxyz+0123456789")), "BROKEN: Tiger192 multi-block hashing");
+
+    inline void Tigertest()
+    {
+        // Reference values from the THEX draft.
+        if ("5d9ed00a030e638bdb753a6a24fb900e5a63b8e73e6c25b6" != String::toHex(Hash::Tigertree_t::Build({}).Root()))
+            printf("BROKEN: Tigertree empty input\n");
+
+        std::vector<uint8_t> Input(1024, 'A');
+        if ("5fbd0e62ad016d596b77d1d28883b94fed78ecbaf4640914" != String::toHex(Hash::Tigertree_t::Build(Input).Root()))
+            printf("BROKEN: Tigertree 1024 bytes\n");
+
+        // Odd leaf counts and partial updates against a full rebuild.
+        Input.resize(300 * 1024 + 17);
+        for (size_t i = 0; i < Input.size(); ++i) Input[i] = uint8_t(i * 13 + 5);
+
+        auto Tree = Hash::Tigertree_t::Build(Input);
+        if (Tree.Root() != Hash::Tigertree_t::Build(Input, 1).Root()) printf("BROKEN: Tigertree threading\n");
+
+        Input[150 * 1024 + 3] ^= 0xFF;
+        if (Tree.Verify(Input, 150 * 1024, 1024)) printf("BROKEN: Tigertree verify\n");
+
+        Tree.Update(Input, 150 * 1024 + 3, 1);
+        if (!Tree.Verify(Input, 0, Input.size()) || Tree.Root() != Hash::Tigertree_t::Build(Input).Root()) printf("BROKEN: Tigertree update\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void Tigerbenchmark()
+    {
+        const auto Bulk = Randombytes(1024 * 1024);
+
+        Measure("Hash::Tiger192 (1 MiB)", Bulk.size(), [&]() { Keep(Hash::Tiger192(Bulk)); });
+        Measure("Hash::Tiger192 (64 bytes)", 64, [&]() { Keep(Hash::Tiger192(std::span(Bulk).first(64))); });
+        Measure("Hash::Tigertree_t::Build (1 MiB)", Bulk.size(), [&]() { Keep(Hash::Tigertree_t::Build(Bulk).Root()); });
+    }
 }
 #endif
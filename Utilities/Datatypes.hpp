@@ -12,4 +12,6 @@ using Blob_t = std::basic_string<uint8_t>;
 
 #include "Datatypes/bfloat16.hpp"
 #include "Datatypes/float16.hpp"
-#include "Datatypes/vec16.hpp"
\ No newline at end of file
+#include "Datatypes/vec16.hpp"
+#include "Datatypes/Conversion.hpp"
+#include "Datatypes/vecsoa.hpp"
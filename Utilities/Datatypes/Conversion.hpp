@@ -0,0 +1,256 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Bulk conversion between float and the 16-bit types, F16C / AVX-512 BF16 / AVX2 when available.
+    Results are bit-identical to converting one element at a time.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+#include "../CPUID.hpp"
+#include "bfloat16.hpp"
+#include "float16.hpp"
+
+namespace Datatypes::Internal
+{
+    inline void Halfscalar(const float *Input, float16_t *Output, size_t Count) noexcept
+    {
+        for (size_t i = 0; i < Count; ++i) Output[i] = float16_t(Input[i]);
+    }
+    inline void Halfscalar(const float16_t *Input, float *Output, size_t Count) noexcept
+    {
+        for (size_t i = 0; i < Count; ++i) Output[i] = float(Input[i]);
+    }
+    inline void Brainscalar(const float *Input, bfloat16_t *Output, size_t Count) noexcept
+    {
+        for (size_t i = 0; i < Count; ++i) Output[i] = bfloat16_t(Input[i]);
+    }
+    inline void Brainscalar(const bfloat16_t *Input, float *Output, size_t Count) noexcept
+    {
+        for (size_t i = 0; i < Count; ++i) Output[i] = float(Input[i]);
+    }
+
+    #if defined (HAS_CPUID)
+    // Eight elements in or out of a fp32 register, rounding exactly like the scalar constructors.
+    inline __m256 Widen8(const float *Input) noexcept { return _mm256_loadu_ps(Input); }
+    inline __m256 Widen8(const float16_t *Input) noexcept
+    {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Input)));
+    }
+    inline __m256 Widen8(const bfloat16_t *Input) noexcept
+    {
+        const auto Words = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Input)));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(Words, 16));
+    }
+
+    // Same rounding as the bfloat16_t constructor, result in the low words.
+    inline __m256i Roundbrain(const __m256i Bits) noexcept
+    {
+        const auto Absmask = _mm256_set1_epi32(0x7FFFFFFF);
+        const auto Absolute = _mm256_and_si256(Bits, Absmask);
+        const auto Odd = _mm256_and_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(1));
+        const auto Result = _mm256_srli_epi32(_mm256_add_epi32(Bits, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), Odd)), 16);
+
+        // Signed comparisons are fine as the sign has been masked off.
+        const auto isNaN = _mm256_cmpgt_epi32(Absolute, _mm256_set1_epi32(0x7F800000));
+
+        #if defined (__STDCPP_BFLOAT16_T__)
+        // std::bfloat16_t keeps denormals, NaN is made quiet but keeps its sign and upper payload.
+        return _mm256_blendv_epi8(Result, _mm256_or_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(0x0040)), isNaN);
+        #else
+        // Our bfloat16_t flushes denormals and always produces the canonical quiet NaN.
+        const auto isDenormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x00800000), Absolute);
+        const auto Flushed = _mm256_blendv_epi8(Result, _mm256_srli_epi32(_mm256_andnot_si256(Absmask, Bits), 16), isDenormal);
+        return _mm256_blendv_epi8(Flushed, _mm256_set1_epi32(0xFFC1), isNaN);
+        #endif
+    }
+
+    inline void Narrow8(float *Output, const __m256 Value) noexcept { _mm256_storeu_ps(Output, Value); }
+    inline void Narrow8(float16_t *Output, const __m256 Value) noexcept
+    {
+        auto Half = _mm256_cvtps_ph(Value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+        #if !defined (__STDCPP_FLOAT16_T__)
+        // The hardware keeps NaN payloads, float16_t always produces the canonical quiet NaN.
+        const auto Low = _mm256_castps256_ps128(Value), High = _mm256_extractf128_ps(Value, 1);
+        const auto isNaN = _mm_packs_epi32(_mm_castps_si128(_mm_cmpunord_ps(Low, Low)), _mm_castps_si128(_mm_cmpunord_ps(High, High)));
+
+        if (_mm_movemask_epi8(isNaN)) [[unlikely]]
+        {
+            const auto Upper = _mm_packus_epi32(_mm_srli_epi32(_mm_castps_si128(Low), 16), _mm_srli_epi32(_mm_castps_si128(High), 16));
+            const auto Canonical = _mm_or_si128(_mm_and_si128(Upper, _mm_set1_epi16(int16_t(0x8000))), _mm_set1_epi16(0x7E00));
+            Half = _mm_blendv_epi8(Half, Canonical, isNaN);
+        }
+        #endif
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(Output), Half);
+    }
+    inline void Narrow8(bfloat16_t *Output, const __m256 Value) noexcept
+    {
+        const auto Rounded = Roundbrain(_mm256_castps_si256(Value));
+        const auto Packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(Rounded, Rounded), 0b00001000);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(Output), _mm256_castsi256_si128(Packed));
+    }
+
+    // Returns how many elements were converted, the caller does the tail.
+    inline size_t HalfF16C(const float *Input, float16_t *Output, size_t Count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= Count; i += 8) Narrow8(Output + i, Widen8(Input + i));
+        return i;
+    }
+    inline size_t HalfF16C(const float16_t *Input, float *Output, size_t Count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= Count; i += 8) Narrow8(Output + i, Widen8(Input + i));
+        return i;
+    }
+
+    inline size_t BrainAVX2(const float *Input, bfloat16_t *Output, size_t Count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= Count; i += 16)
+        {
+            const auto A = Roundbrain(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(Input + i)));
+            const auto B = Roundbrain(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(Input + i + 8)));
+
+            // Packing works per 128-bit lane, so the quadwords need reordering.
+            const auto Packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(A, B), 0b11011000);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(Output + i), Packed);
+        }
+
+        return i;
+    }
+    inline size_t BrainAVX2(const bfloat16_t *Input, float *Output, size_t Count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= Count; i += 8) Narrow8(Output + i, Widen8(Input + i));
+        return i;
+    }
+
+    // Native rounding is the same and denormals are treated as zero, NaN still needs fixing up.
+    inline size_t BrainAVX512(const float *Input, bfloat16_t *Output, size_t Count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= Count; i += 16)
+        {
+            const auto Value = _mm512_loadu_ps(Input + i);
+            const auto Converted = _mm512_cvtneps_pbh(Value);
+
+            __m256i Result;
+            std::memcpy(&Result, &Converted, sizeof(Result));
+
+            const auto isNaN = _mm512_cmp_ps_mask(Value, Value, _CMP_UNORD_Q);
+            Result = _mm256_mask_set1_epi16(Result, isNaN, int16_t(0xFFC1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(Output + i), Result);
+        }
+
+        return i;
+    }
+    #endif
+}
+
+// Converts min(Input.size(), Output.size()) elements.
+inline void Convert(std::span<const float> Input, std::span<float16_t> Output) noexcept
+{
+    const auto Count = std::min(Input.size(), Output.size());
+    size_t Done = 0;
+
+    #if defined (HAS_CPUID)
+    if (CPUID::hasF16C() && CPUID::hasAVX()) Done = Datatypes::Internal::HalfF16C(Input.data(), Output.data(), Count);
+    #endif
+
+    Datatypes::Internal::Halfscalar(Input.data() + Done, Output.data() + Done, Count - Done);
+}
+inline void Convert(std::span<const float16_t> Input, std::span<float> Output) noexcept
+{
+    const auto Count = std::min(Input.size(), Output.size());
+    size_t Done = 0;
+
+    #if defined (HAS_CPUID)
+    if (CPUID::hasF16C() && CPUID::hasAVX()) Done = Datatypes::Internal::HalfF16C(Input.data(), Output.data(), Count);
+    #endif
+
+    Datatypes::Internal::Halfscalar(Input.data() + Done, Output.data() + Done, Count - Done);
+}
+inline void Convert(std::span<const float> Input, std::span<bfloat16_t> Output) noexcept
+{
+    const auto Count = std::min(Input.size(), Output.size());
+    size_t Done = 0;
+
+    #if defined (HAS_CPUID)
+    // The native instruction flushes denormals, which only matches our own bfloat16_t.
+    #if !defined (__STDCPP_BFLOAT16_T__)
+    if (CPUID::hasAVX512BF16() && CPUID::hasAVX512BW() && CPUID::hasAVX512VL()) Done = Datatypes::Internal::BrainAVX512(Input.data(), Output.data(), Count);
+    #endif
+    if (!Done && CPUID::hasAVX2()) Done = Datatypes::Internal::BrainAVX2(Input.data(), Output.data(), Count);
+    #endif
+
+    Datatypes::Internal::Brainscalar(Input.data() + Done, Output.data() + Done, Count - Done);
+}
+inline void Convert(std::span<const bfloat16_t> Input, std::span<float> Output) noexcept
+{
+    const auto Count = std::min(Input.size(), Output.size());
+    size_t Done = 0;
+
+    #if defined (HAS_CPUID)
+    if (CPUID::hasAVX2()) Done = Datatypes::Internal::BrainAVX2(Input.data(), Output.data(), Count);
+    #endif
+
+    Datatypes::Internal::Brainscalar(Input.data() + Done, Output.data() + Done, Count - Done);
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Conversiontest()
+    {
+        // Every half and a spread of floats including NaN, infinities and denormals.
+        std::vector<float16_t> Halfs(65536);
+        for (size_t i = 0; i < Halfs.size(); ++i) Halfs[i] = float16_t(uint16_t(i));
+
+        std::vector<float> Floats(1 << 16), Widened(Halfs.size());
+        for (size_t i = 0; i < Floats.size(); ++i) Floats[i] = std::bit_cast<float>(uint32_t(i * 0x9E3779B1U));
+        Floats[0] = std::numeric_limits<float>::quiet_NaN(); Floats[1] = -std::numeric_limits<float>::infinity(); Floats[2] = 1.0e-40f;
+
+        Convert(Halfs, Widened);
+        for (size_t i = 0; i < Halfs.size(); ++i)
+            if (std::bit_cast<uint32_t>(Widened[i]) != std::bit_cast<uint32_t>(float(Halfs[i]))) { std::printf("BROKEN: float16_t widening\n"); break; }
+
+        std::vector<float16_t> Narrowed(Floats.size());
+        Convert(Floats, Narrowed);
+        for (size_t i = 0; i < Floats.size(); ++i)
+            if (std::bit_cast<uint16_t>(Narrowed[i]) != std::bit_cast<uint16_t>(float16_t(Floats[i]))) { std::printf("BROKEN: float16_t narrowing\n"); break; }
+
+        std::vector<bfloat16_t> Brains(Floats.size());
+        Convert(Floats, Brains);
+        for (size_t i = 0; i < Floats.size(); ++i)
+            if (std::bit_cast<uint16_t>(Brains[i]) != std::bit_cast<uint16_t>(bfloat16_t(Floats[i]))) { std::printf("BROKEN: bfloat16_t narrowing\n"); break; }
+
+        Convert(Brains, Widened);
+        for (size_t i = 0; i < Brains.size(); ++i)
+            if (std::bit_cast<uint32_t>(Widened[i]) != std::bit_cast<uint32_t>(float(Brains[i]))) { std::printf("BROKEN: bfloat16_t widening\n"); break; }
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void Conversionbenchmark()
+    {
+        constexpr size_t Count = 64 * 1024;
+        std::vector<float> Floats(Count);
+        for (size_t i = 0; i < Count; ++i) Floats[i] = float(i) * 0.37f - 1000.0f;
+        std::vector<float16_t> Halfs(Count);
+        std::vector<bfloat16_t> Brains(Count);
+
+        Measure("Convert float -> float16_t", Count * sizeof(float), [&]() { Convert(Floats, Halfs); Keep(Halfs.data()); });
+        Measure("Convert float16_t -> float", Count * sizeof(float), [&]() { Convert(Halfs, Floats); Keep(Floats.data()); });
+        Measure("Convert float -> bfloat16_t", Count * sizeof(float), [&]() { Convert(Floats, Brains); Keep(Brains.data()); });
+        Measure("Convert bfloat16_t -> float", Count * sizeof(float), [&]() { Convert(Brains, Floats); Keep(Floats.data()); });
+    }
+}
+#endif
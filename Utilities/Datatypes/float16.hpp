@@ -59,6 +59,10 @@ struct float16_t
         if (Mantissa > 0xFF000000U)
             return (Sign >> 16) | 0x7E00;
 
+        // Anything from 2^16 up rounds to infinity, the folded scale below can't overflow on its own.
+        if (Mantissa >= 0x8F000000U)
+            return (Sign >> 16) | 0x7C00;
+
         const auto ABS = (Input >= 0) ? Input : -Input;
         const auto Normalized = ABS * (infScale * zeroScale);
         const auto Bias = std::max(Mantissa & 0xFF000000U, 0x71000000U);
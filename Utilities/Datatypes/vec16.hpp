@@ -21,6 +21,7 @@ template <typename T> struct vec2_t
     constexpr vec2_t() = default;
     constexpr operator bool() const { return !!(x + y); }
     constexpr vec2_t(const vec2_t &Other) { x = Other.x; y = Other.y; }
+    constexpr vec2_t &operator=(const vec2_t &) = default;
     template <typename U> constexpr operator U() const { return { x, y }; }
     template <typename A, typename B> constexpr vec2_t(A X, B Y) : x(X), y(Y) {}
 
@@ -81,6 +82,7 @@ template <typename T> struct vec3_t
     constexpr operator bool() const { return !!(x + y + z); }
     template <typename U> constexpr operator U() const { return { x, y, z }; }
     constexpr vec3_t(const vec3_t &Other) { x = Other.x; y = Other.y; z = Other.z; }
+    constexpr vec3_t &operator=(const vec3_t &) = default;
     template <typename A, typename B, typename C> constexpr vec3_t(A X, B Y, C Z) : x(X), y(Y), z(Z) {}
 
     // For handling RGBTRIPPLE and similar structs.
@@ -144,6 +146,7 @@ template <typename T> struct vec4_t
     constexpr vec4_t(vec2_t<T> X, vec2_t<T> Y) : ab(X), cd(Y) {}
     template <typename U> constexpr operator U() const { return { x, y, z, w }; }
     constexpr vec4_t(const vec4_t &Other) { x = Other.x; y = Other.y; z = Other.z; w = Other.w; }
+    constexpr vec4_t &operator=(const vec4_t &) = default;
     template <typename A, typename B, typename C, typename D> constexpr vec4_t(A X, B Y, C Z, D W) : x(X), y(Y), z(Z), w(W) {}
 
     // For handling RECT and similar structs.
@@ -0,0 +1,353 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Structure-of-arrays storage for the vectors in vec16.hpp, one contiguous lane per component.
+    Bulk math widens eight elements at a time to fp32 registers and narrows the result on store.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+#include "../CPUID.hpp"
+#include "Conversion.hpp"
+#include "vec16.hpp"
+
+template <typename T, size_t N> requires (N >= 2 && N <= 4)
+struct vecN_soa_t
+{
+    using Packed_t = std::conditional_t<N == 2, vec2_t<T>, std::conditional_t<N == 3, vec3_t<T>, vec4_t<T>>>;
+    static constexpr size_t Components = N;
+
+    std::array<std::vector<T>, N> Lanes{};
+
+    // The packed types have no usable indexing for all N, so go through the named members.
+    static constexpr std::array<T, N> Unpack(const Packed_t &Value)
+    {
+        if constexpr (N == 2) return { Value.x, Value.y };
+        else if constexpr (N == 3) return { Value.x, Value.y, Value.z };
+        else return { Value.x, Value.y, Value.z, Value.w };
+    }
+    static constexpr Packed_t Pack(const std::array<T, N> &Value)
+    {
+        if constexpr (N == 2) return Packed_t{ Value[0], Value[1] };
+        else if constexpr (N == 3) return Packed_t{ Value[0], Value[1], Value[2] };
+        else return Packed_t{ Value[0], Value[1], Value[2], Value[3] };
+    }
+
+    vecN_soa_t() = default;
+    explicit vecN_soa_t(size_t Count) { resize(Count); }
+    explicit vecN_soa_t(std::span<const Packed_t> Packed) { assign(Packed); }
+
+    [[nodiscard]] size_t size() const noexcept { return Lanes[0].size(); }
+    [[nodiscard]] bool empty() const noexcept { return Lanes[0].empty(); }
+
+    void clear() noexcept { for (auto &Lane : Lanes) Lane.clear(); }
+    void reserve(size_t Count) { for (auto &Lane : Lanes) Lane.reserve(Count); }
+    void resize(size_t Count) { for (auto &Lane : Lanes) Lane.resize(Count); }
+
+    [[nodiscard]] std::span<T> Lane(size_t Component) noexcept { return Lanes[Component]; }
+    [[nodiscard]] std::span<const T> Lane(size_t Component) const noexcept { return Lanes[Component]; }
+
+    [[nodiscard]] Packed_t get(size_t Index) const
+    {
+        std::array<T, N> Value;
+        for (size_t c = 0; c < N; ++c) Value[c] = Lanes[c][Index];
+        return Pack(Value);
+    }
+    void set(size_t Index, const Packed_t &Value)
+    {
+        const auto Unpacked = Unpack(Value);
+        for (size_t c = 0; c < N; ++c) Lanes[c][Index] = Unpacked[c];
+    }
+    void push_back(const Packed_t &Value)
+    {
+        const auto Unpacked = Unpack(Value);
+        for (size_t c = 0; c < N; ++c) Lanes[c].push_back(Unpacked[c]);
+    }
+
+    // To and from the packed AoS form.
+    void assign(std::span<const Packed_t> Packed)
+    {
+        resize(Packed.size());
+        for (size_t i = 0; i < Packed.size(); ++i) set(i, Packed[i]);
+    }
+    void toPacked(std::span<Packed_t> Output) const
+    {
+        const auto Count = std::min(Output.size(), size());
+        for (size_t i = 0; i < Count; ++i) Output[i] = get(i);
+    }
+    [[nodiscard]] std::vector<Packed_t> toPacked() const
+    {
+        std::vector<Packed_t> Result(size());
+        toPacked(Result);
+        return Result;
+    }
+};
+
+template <typename T> using vec2_soa_t = vecN_soa_t<T, 2>;
+template <typename T> using vec3_soa_t = vecN_soa_t<T, 3>;
+template <typename T> using vec4_soa_t = vecN_soa_t<T, 4>;
+
+namespace SoA
+{
+    namespace Internal
+    {
+        // The math is written once against these overloads, float for the tail and __m256 for eight elements.
+        struct Scalar_t {};
+        struct Vector_t {};
+
+        template <typename T> inline float Load(Scalar_t, const T *Input) { return float(*Input); }
+        template <typename T> inline void Store(Scalar_t, T *Output, float Value) { *Output = T(Value); }
+        inline float Broadcast(Scalar_t, float Value) { return Value; }
+
+        inline float Add(float Left, float Right) { return Left + Right; }
+        inline float Sub(float Left, float Right) { return Left - Right; }
+        inline float Mul(float Left, float Right) { return Left * Right; }
+        inline float Sqrt(float Value) { return std::sqrt(Value); }
+        inline float Inverse(float Value) { return Value > 0.0f ? 1.0f / Value : 0.0f; }
+
+        // Same operand order as minps / maxps so both paths agree on NaN.
+        inline float Min(float Left, float Right) { return Left < Right ? Left : Right; }
+        inline float Max(float Left, float Right) { return Left > Right ? Left : Right; }
+
+        #if defined (HAS_CPUID)
+        template <typename T> inline __m256 Load(Vector_t, const T *Input) { return Datatypes::Internal::Widen8(Input); }
+        template <typename T> inline void Store(Vector_t, T *Output, __m256 Value) { Datatypes::Internal::Narrow8(Output, Value); }
+        inline __m256 Broadcast(Vector_t, float Value) { return _mm256_set1_ps(Value); }
+
+        inline __m256 Add(__m256 Left, __m256 Right) { return _mm256_add_ps(Left, Right); }
+        inline __m256 Sub(__m256 Left, __m256 Right) { return _mm256_sub_ps(Left, Right); }
+        inline __m256 Mul(__m256 Left, __m256 Right) { return _mm256_mul_ps(Left, Right); }
+        inline __m256 Sqrt(__m256 Value) { return _mm256_sqrt_ps(Value); }
+        inline __m256 Min(__m256 Left, __m256 Right) { return _mm256_min_ps(Left, Right); }
+        inline __m256 Max(__m256 Left, __m256 Right) { return _mm256_max_ps(Left, Right); }
+        inline __m256 Inverse(__m256 Value)
+        {
+            const auto isPositive = _mm256_cmp_ps(Value, _mm256_setzero_ps(), _CMP_GT_OQ);
+            return _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), Value), isPositive);
+        }
+        #endif
+
+        inline bool hasVector()
+        {
+            #if defined (HAS_CPUID)
+            return CPUID::hasAVX2() && CPUID::hasF16C();
+            #else
+            return false;
+            #endif
+        }
+
+        // Body(Index, Tag) is invoked for every block of eight and then for every remaining element.
+        template <typename F> inline void Foreach(size_t Count, F &&Body)
+        {
+            size_t i = 0;
+
+            #if defined (HAS_CPUID)
+            if (hasVector()) for (; i + 8 <= Count; i += 8) Body(i, Vector_t{});
+            #endif
+
+            for (; i < Count; ++i) Body(i, Scalar_t{});
+        }
+
+        template <typename T, size_t N, typename F>
+        inline void Componentwise(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output, F &&Operation)
+        {
+            const auto Count = std::min(Left.size(), Right.size());
+            Output.resize(Count);
+
+            for (size_t c = 0; c < N; ++c)
+            {
+                const auto A = Left.Lanes[c].data(), B = Right.Lanes[c].data();
+                const auto Out = Output.Lanes[c].data();
+
+                Foreach(Count, [&](size_t i, auto Tag) { Store(Tag, Out + i, Operation(Load(Tag, A + i), Load(Tag, B + i), Tag)); });
+            }
+        }
+
+        template <typename T, size_t N, typename Tag_t>
+        inline auto Dot(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, size_t i, Tag_t Tag)
+        {
+            auto Sum = Mul(Load(Tag, Left.Lanes[0].data() + i), Load(Tag, Right.Lanes[0].data() + i));
+            for (size_t c = 1; c < N; ++c) Sum = Add(Sum, Mul(Load(Tag, Left.Lanes[c].data() + i), Load(Tag, Right.Lanes[c].data() + i)));
+            return Sum;
+        }
+    }
+
+    // Output is resized to the shorter input and may alias either of them.
+    template <typename T, size_t N> void Add(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [](auto A, auto B, auto) { return Internal::Add(A, B); });
+    }
+    template <typename T, size_t N> void Sub(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [](auto A, auto B, auto) { return Internal::Sub(A, B); });
+    }
+    template <typename T, size_t N> void Mul(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [](auto A, auto B, auto) { return Internal::Mul(A, B); });
+    }
+    template <typename T, size_t N> void Mul(const vecN_soa_t<T, N> &Input, float Scale, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Input, Input, Output, [=](auto A, auto, auto Tag) { return Internal::Mul(A, Internal::Broadcast(Tag, Scale)); });
+    }
+    template <typename T, size_t N> void Min(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [](auto A, auto B, auto) { return Internal::Min(A, B); });
+    }
+    template <typename T, size_t N> void Max(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [](auto A, auto B, auto) { return Internal::Max(A, B); });
+    }
+
+    // Left + (Right - Left) * Factor.
+    template <typename T, size_t N> void Lerp(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, float Factor, vecN_soa_t<T, N> &Output)
+    {
+        Internal::Componentwise(Left, Right, Output, [=](auto A, auto B, auto Tag)
+        {
+            return Internal::Add(A, Internal::Mul(Internal::Sub(B, A), Internal::Broadcast(Tag, Factor)));
+        });
+    }
+
+    // Per-element results in fp32, min(Left.size(), Right.size(), Output.size()) are written.
+    template <typename T, size_t N> void Dot(const vecN_soa_t<T, N> &Left, const vecN_soa_t<T, N> &Right, std::span<float> Output)
+    {
+        const auto Count = std::min({ Left.size(), Right.size(), Output.size() });
+        Internal::Foreach(Count, [&](size_t i, auto Tag) { Internal::Store(Tag, Output.data() + i, Internal::Dot(Left, Right, i, Tag)); });
+    }
+    template <typename T, size_t N> void Length(const vecN_soa_t<T, N> &Input, std::span<float> Output)
+    {
+        const auto Count = std::min(Input.size(), Output.size());
+        Internal::Foreach(Count, [&](size_t i, auto Tag) { Internal::Store(Tag, Output.data() + i, Internal::Sqrt(Internal::Dot(Input, Input, i, Tag))); });
+    }
+
+    // Zero-length vectors stay zero.
+    template <typename T, size_t N> void Normalize(const vecN_soa_t<T, N> &Input, vecN_soa_t<T, N> &Output)
+    {
+        const auto Count = Input.size();
+        Output.resize(Count);
+
+        Internal::Foreach(Count, [&](size_t i, auto Tag)
+        {
+            const auto Scale = Internal::Inverse(Internal::Sqrt(Internal::Dot(Input, Input, i, Tag)));
+            for (size_t c = 0; c < N; ++c)
+                Internal::Store(Tag, Output.Lanes[c].data() + i, Internal::Mul(Internal::Load(Tag, Input.Lanes[c].data() + i), Scale));
+        });
+    }
+
+    // Componentwise minimum and maximum over all elements, default constructed when empty.
+    template <typename T, size_t N> auto Bounds(const vecN_soa_t<T, N> &Input) -> std::pair<typename vecN_soa_t<T, N>::Packed_t, typename vecN_soa_t<T, N>::Packed_t>
+    {
+        using Packed_t = typename vecN_soa_t<T, N>::Packed_t;
+        if (Input.empty()) return { Packed_t{}, Packed_t{} };
+
+        std::array<float, N> Low, High;
+        Low.fill(std::numeric_limits<float>::infinity());
+        High.fill(-std::numeric_limits<float>::infinity());
+
+        const auto Count = Input.size();
+        size_t i = 0;
+
+        #if defined (HAS_CPUID)
+        if (Internal::hasVector() && Count >= 8)
+        {
+            for (size_t c = 0; c < N; ++c)
+            {
+                const auto Lane = Input.Lanes[c].data();
+                auto Lower = _mm256_set1_ps(Low[c]), Upper = _mm256_set1_ps(High[c]);
+
+                for (i = 0; i + 8 <= Count; i += 8)
+                {
+                    const auto Value = Internal::Load(Internal::Vector_t{}, Lane + i);
+                    Lower = _mm256_min_ps(Lower, Value);
+                    Upper = _mm256_max_ps(Upper, Value);
+                }
+
+                alignas(32) float Lows[8], Highs[8];
+                _mm256_store_ps(Lows, Lower);
+                _mm256_store_ps(Highs, Upper);
+
+                for (size_t l = 0; l < 8; ++l)
+                {
+                    Low[c] = Internal::Min(Low[c], Lows[l]);
+                    High[c] = Internal::Max(High[c], Highs[l]);
+                }
+            }
+        }
+        #endif
+
+        for (; i < Count; ++i)
+        {
+            for (size_t c = 0; c < N; ++c)
+            {
+                const auto Value = float(Input.Lanes[c][i]);
+                Low[c] = Internal::Min(Low[c], Value);
+                High[c] = Internal::Max(High[c], Value);
+            }
+        }
+
+        std::array<T, N> Lower, Upper;
+        for (size_t c = 0; c < N; ++c) { Lower[c] = T(Low[c]); Upper[c] = T(High[c]); }
+        return { vecN_soa_t<T, N>::Pack(Lower), vecN_soa_t<T, N>::Pack(Upper) };
+    }
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    template <typename T> inline void SoAtest(const char *Name)
+    {
+        std::array<vec3_t<T>, 37> Packed, Roundtrip;
+        for (int i = 0; i < 37; ++i) Packed[i] = vec3_t<T>(T(float(i) * 0.5f - 9.0f), T(float(i % 7)), T(float(36 - i) * 0.25f));
+
+        const vec3_soa_t<T> A(Packed);
+        vec3_soa_t<T> B(A.size()), Out;
+        for (size_t i = 0; i < B.size(); ++i) B.set(i, vec3_t<T>(T(1.0f), T(-2.0f), T(float(i))));
+
+        A.toPacked(Roundtrip);
+        for (size_t i = 0; i < Packed.size(); ++i)
+            if (Roundtrip[i] != Packed[i]) { std::printf("BROKEN: vec3_soa_t<%s> roundtrip\n", Name); break; }
+
+        // Sums of small integers and halves are exact in all three types.
+        SoA::Add(A, B, Out);
+        for (size_t i = 0; i < Out.size(); ++i)
+            if (float(Out.Lanes[0][i]) != float(A.Lanes[0][i]) + 1.0f || float(Out.Lanes[2][i]) != float(A.Lanes[2][i]) + float(i))
+            { std::printf("BROKEN: SoA::Add<%s>\n", Name); break; }
+
+        std::vector<float> Dots(A.size()), Lengths(A.size());
+        SoA::Dot(A, B, Dots);
+        SoA::Length(A, Lengths);
+        for (size_t i = 0; i < A.size(); ++i)
+        {
+            const auto a = A.get(i), b = B.get(i);
+            const auto Dot = float(a.x) * float(b.x) + float(a.y) * float(b.y) + float(a.z) * float(b.z);
+            const auto Length = std::sqrt(float(a.x) * float(a.x) + float(a.y) * float(a.y) + float(a.z) * float(a.z));
+
+            if (std::abs(Dots[i] - Dot) > 1e-3f || std::abs(Lengths[i] - Length) > 1e-3f) { std::printf("BROKEN: SoA::Dot<%s>\n", Name); break; }
+        }
+
+        SoA::Normalize(A, Out);
+        SoA::Length(Out, Lengths);
+        for (size_t i = 0; i < Out.size(); ++i)
+            if (std::abs(Lengths[i] - 1.0f) > 2e-2f) { std::printf("BROKEN: SoA::Normalize<%s>\n", Name); break; }
+
+        SoA::Lerp(A, B, 0.5f, Out);
+        for (size_t i = 0; i < Out.size(); ++i)
+            if (std::abs(float(Out.Lanes[1][i]) - (float(A.Lanes[1][i]) - 2.0f) * 0.5f) > 2e-2f) { std::printf("BROKEN: SoA::Lerp<%s>\n", Name); break; }
+
+        SoA::Min(A, B, Out);
+        if (float(Out.Lanes[1][3]) != -2.0f || float(Out.Lanes[0][30]) != 1.0f) std::printf("BROKEN: SoA::Min<%s>\n", Name);
+
+        const auto [Low, High] = SoA::Bounds(A);
+        if (float(Low.x) != -9.0f || float(High.x) != 9.0f || float(Low.y) != 0.0f || float(High.y) != 6.0f || float(High.z) != 9.0f)
+            std::printf("BROKEN: SoA::Bounds<%s>\n", Name);
+    }
+
+    inline void Vecsoatest()
+    {
+        SoAtest<float>("float");
+        SoAtest<float16_t>("float16_t");
+        SoAtest<bfloat16_t>("bfloat16_t");
+    }
+}
+#endif
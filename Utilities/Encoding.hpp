@@ -5,6 +5,7 @@
 */
 
 #pragma once
+#include <cstring>
 #include <span>
 #include <string_view>
 
@@ -16,16 +17,32 @@ namespace Encoding
         // Covers char and char8_t; at runtime.
         if (sizeof(T) == 1 && !std::is_constant_evaluated())
         {
-            const auto Intptr = (const uint32_t *)Input.data();
-            const auto Remaining = Input.size() & 3;
-            const auto Count32 = Input.size() / 4;
+            size_t Offset = 0;
 
+            // OR together 64 bytes per check, exit on the first set high-bit.
+            #if defined(HAS_CPUID)
+            const auto Data = (const uint8_t *)Input.data();
+            for (; Offset + 64 <= Input.size(); Offset += 64)
+            {
+                const auto A = _mm_loadu_si128((const __m128i *)(Data + Offset)), B = _mm_loadu_si128((const __m128i *)(Data + Offset + 16));
+                const auto C = _mm_loadu_si128((const __m128i *)(Data + Offset + 32)), D = _mm_loadu_si128((const __m128i *)(Data + Offset + 48));
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(A, B), _mm_or_si128(C, D)))) return false;
+            }
+            #endif
+
+            const auto Remaining = (Input.size() - Offset) & 3;
+            const auto Count32 = (Input.size() - Offset) / 4;
+
+            // Slices can start anywhere, so no aligned uint32_t loads.
             for (size_t i = 0; i < Count32; ++i)
-                if (Intptr[i] & 0x80808080)
-                    return false;
+            {
+                uint32_t Word;
+                std::memcpy(&Word, Input.data() + Offset + i * 4, sizeof(Word));
+                if (Word & 0x80808080) return false;
+            }
 
             for (size_t i = 0; i < Remaining; ++i)
-                if (Input[(Count32 * 4) + i] & 0x80)
+                if (Input[Offset + (Count32 * 4) + i] & 0x80)
                     return false;
         }
 
@@ -47,3 +64,4 @@ namespace Encoding
 
 #include "Encoding/UTF8.hpp"
 #include "Encoding/JSON.hpp"
+#include "Encoding/JSONStream.hpp"
@@ -458,36 +458,342 @@ namespace JSON
         }
     }
 
+    // Two-stage parsing, first a bitmask pass finds every structural character, then the tree is built from that index.
+    namespace Structural
+    {
+        // One bit per byte of a 64-byte block.
+        struct Block_t { uint64_t Quote, Backslash, Whitespace, Operator; };
+
+        struct Scalar_t
+        {
+            static Block_t Classify(const char8_t *Data)
+            {
+                Block_t Result{};
+
+                for (size_t i = 0; i < 64; ++i)
+                {
+                    const auto Char = Data[i];
+                    const auto Bit = 1ULL << i;
+
+                    if (Char == u8'"') Result.Quote |= Bit;
+                    if (Char == u8'\\') Result.Backslash |= Bit;
+                    if (Char == u8' ' || (Char >= 0x09 && Char <= 0x0D)) Result.Whitespace |= Bit;
+                    if (Char == u8',' || Char == u8':' || (Char | 0x20) == u8'{' || (Char | 0x20) == u8'}') Result.Operator |= Bit;
+                }
+
+                return Result;
+            }
+        };
+
+        #if defined(HAS_CPUID)
+        struct SSE_t
+        {
+            static uint64_t Mask(const char8_t *Data, auto &&Predicate)
+            {
+                uint64_t Result{};
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const auto Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data + i * 16));
+                    Result |= uint64_t(uint16_t(_mm_movemask_epi8(Predicate(Chunk)))) << (i * 16);
+                }
+                return Result;
+            }
+            static Block_t Classify(const char8_t *Data)
+            {
+                return
+                {
+                    Mask(Data, [](__m128i X) { return _mm_cmpeq_epi8(X, _mm_set1_epi8('"')); }),
+                    Mask(Data, [](__m128i X) { return _mm_cmpeq_epi8(X, _mm_set1_epi8('\\')); }),
+
+                    // Space, or \t through \r.
+                    Mask(Data, [](__m128i X)
+                    {
+                        const auto Control = _mm_sub_epi8(X, _mm_set1_epi8(0x09));
+                        return _mm_or_si128(_mm_cmpeq_epi8(X, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(_mm_min_epu8(Control, _mm_set1_epi8(4)), Control));
+                    }),
+
+                    // Brackets and braces only differ in bit 5.
+                    Mask(Data, [](__m128i X)
+                    {
+                        const auto Folded = _mm_or_si128(X, _mm_set1_epi8(0x20));
+                        const auto Brackets = _mm_or_si128(_mm_cmpeq_epi8(Folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(Folded, _mm_set1_epi8('}')));
+                        return _mm_or_si128(Brackets, _mm_or_si128(_mm_cmpeq_epi8(X, _mm_set1_epi8(',')), _mm_cmpeq_epi8(X, _mm_set1_epi8(':'))));
+                    })
+                };
+            }
+        };
+        struct AVX2_t
+        {
+            static uint64_t Mask(const char8_t *Data, auto &&Predicate)
+            {
+                const auto Low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Data));
+                const auto High = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Data + 32));
+                return uint64_t(uint32_t(_mm256_movemask_epi8(Predicate(Low)))) | (uint64_t(uint32_t(_mm256_movemask_epi8(Predicate(High)))) << 32);
+            }
+            static Block_t Classify(const char8_t *Data)
+            {
+                return
+                {
+                    Mask(Data, [](__m256i X) { return _mm256_cmpeq_epi8(X, _mm256_set1_epi8('"')); }),
+                    Mask(Data, [](__m256i X) { return _mm256_cmpeq_epi8(X, _mm256_set1_epi8('\\')); }),
+
+                    // Space, or \t through \r.
+                    Mask(Data, [](__m256i X)
+                    {
+                        const auto Control = _mm256_sub_epi8(X, _mm256_set1_epi8(0x09));
+                        return _mm256_or_si256(_mm256_cmpeq_epi8(X, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(_mm256_min_epu8(Control, _mm256_set1_epi8(4)), Control));
+                    }),
+
+                    // Brackets and braces only differ in bit 5.
+                    Mask(Data, [](__m256i X)
+                    {
+                        const auto Folded = _mm256_or_si256(X, _mm256_set1_epi8(0x20));
+                        const auto Brackets = _mm256_or_si256(_mm256_cmpeq_epi8(Folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(Folded, _mm256_set1_epi8('}')));
+                        return _mm256_or_si256(Brackets, _mm256_or_si256(_mm256_cmpeq_epi8(X, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(X, _mm256_set1_epi8(':'))));
+                    })
+                };
+            }
+        };
+        #endif
+
+        // Bit i is set if there's an odd number of quotes at or before i.
+        constexpr uint64_t Prefixxor(uint64_t Bits)
+        {
+            Bits ^= Bits << 1; Bits ^= Bits << 2; Bits ^= Bits << 4;
+            Bits ^= Bits << 8; Bits ^= Bits << 16; Bits ^= Bits << 32;
+            return Bits;
+        }
+
+        // Characters preceded by an odd-length run of backslashes, Carry is set if the block ends on an escape.
+        constexpr uint64_t Findescaped(uint64_t Backslash, uint64_t &Carry)
+        {
+            constexpr uint64_t Even = 0x5555555555555555ULL;
+
+            Backslash &= ~Carry;
+            const auto Follows = (Backslash << 1) | Carry;
+            const auto Oddstarts = Backslash & ~Even & ~Follows;
+
+            // Adding the starts to the runs clears them, overflowing into the next block if needed.
+            const auto Sequences = Oddstarts + Backslash;
+            Carry = Sequences < Oddstarts;
+
+            return (Even ^ (Sequences << 1)) & Follows;
+        }
+
+        // Positions of every operator, quote (both ends), and the first byte of every literal.
+        template <typename SIMD> bool Buildindex(std::u8string_view Input, std::vector<uint32_t> &Output)
+        {
+            Output.resize(Input.size());
+            auto Write = Output.data();
+
+            uint64_t Escapecarry{}, Stringcarry{}, Scalarcarry{};
+            for (size_t Offset = 0; Offset < Input.size(); Offset += 64)
+            {
+                Block_t Block;
+                if (Input.size() - Offset >= 64) [[likely]] Block = SIMD::Classify(Input.data() + Offset);
+                else
+                {
+                    // Pad the tail with whitespace.
+                    std::array<char8_t, 64> Tail;
+                    std::ranges::fill(Tail, u8' ');
+                    std::memcpy(Tail.data(), Input.data() + Offset, Input.size() - Offset);
+                    Block = SIMD::Classify(Tail.data());
+                }
+
+                const auto Quotes = Block.Quote & ~Findescaped(Block.Backslash, Escapecarry);
+
+                // Opening quote and contents, closing quote excluded.
+                const auto Inside = Prefixxor(Quotes) ^ Stringcarry;
+                Stringcarry = uint64_t(int64_t(Inside) >> 63);
+
+                const auto Scalar = ~(Block.Operator | Block.Whitespace | Quotes | Inside);
+                const auto Scalarstart = Scalar & ~((Scalar << 1) | Scalarcarry);
+                Scalarcarry = Scalar >> 63;
+
+                auto Bits = (Block.Operator & ~Inside) | Quotes | Scalarstart;
+                while (Bits)
+                {
+                    *Write++ = uint32_t(Offset + std::countr_zero(Bits));
+                    Bits &= Bits - 1;
+                }
+            }
+
+            Output.resize(Write - Output.data());
+            return Stringcarry == 0;
+        }
+        inline bool Buildindex(std::u8string_view Input, std::vector<uint32_t> &Output)
+        {
+            #if defined(HAS_CPUID)
+            if (CPUID::hasAVX2()) return Buildindex<AVX2_t>(Input, Output);
+            return Buildindex<SSE_t>(Input, Output);
+            #else
+            return Buildindex<Scalar_t>(Input, Output);
+            #endif
+        }
+
+        // Walks the index, same leniency as Parsing (trailing commas, escapes are kept verbatim).
+        struct Parser_t
+        {
+            std::u8string_view Input{};
+            std::vector<uint32_t> Index{};
+            size_t Cursor{};
+
+            [[nodiscard]] char8_t Peek() const
+            {
+                return Cursor < Index.size() ? Input[Index[Cursor]] : char8_t{};
+            }
+            [[nodiscard]] size_t Position() const
+            {
+                return Cursor < Index.size() ? Index[Cursor] : Input.size();
+            }
+
+            std::optional<String_t> Parsestring()
+            {
+                if (Peek() != u8'"' || Cursor + 1 >= Index.size()) return {};
+
+                const auto Start = Index[Cursor] + 1, Stop = Index[Cursor + 1];
+                const auto View = Input.substr(Start, Stop - Start);
+                Cursor += 2;
+
+                // Fast path, nothing to unescape.
+                if (View.find(u8'\\') == std::u8string_view::npos) return String_t(View);
+
+                String_t Result{};
+                Result.reserve(View.size());
+                for (size_t i = 0; i < View.size(); ++i)
+                {
+                    if (View[i] == u8'\\' && i + 1 < View.size()) ++i;
+                    Result.push_back(View[i]);
+                }
+                return Result;
+            }
+            std::optional<Value_t> Parseliteral()
+            {
+                const auto Start = Index[Cursor++];
+                auto Token = Input.substr(Start, Position() - Start);
+                while (!Token.empty() && (Token.back() == u8' ' || (Token.back() >= 0x09 && Token.back() <= 0x0D))) Token.remove_suffix(1);
+
+                Value_t Result{};
+                if (Token == u8"null") return Result;
+                if (Token == u8"true") { Result.Storage = Boolean_t{ true }; return Result; }
+                if (Token == u8"false") { Result.Storage = Boolean_t{ false }; return Result; }
+
+                const auto First = (const char *)Token.data(), Last = First + Token.size();
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Result.Storage.emplace<Unsigned_t>()); ec == std::errc() && Ptr == Last) return Result;
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Result.Storage.emplace<Signed_t>()); ec == std::errc() && Ptr == Last) return Result;
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Result.Storage.emplace<Number_t>()); ec == std::errc() && Ptr == Last) return Result;
+                return {};
+            }
+            std::optional<Array_t> Parsearray()
+            {
+                Array_t Result{};
+                ++Cursor;
+
+                while (Peek() != u8']')
+                {
+                    auto Value = Parsevalue();
+                    if (!Value) return {};
+                    Result.emplace_back(std::move(*Value));
+
+                    if (Peek() == u8',') ++Cursor;
+                    else if (Peek() != u8']') return {};
+                }
+
+                ++Cursor;
+                return Result;
+            }
+            std::optional<Object_t> Parseobject()
+            {
+                Object_t Result{};
+                ++Cursor;
+
+                while (Peek() != u8'}')
+                {
+                    auto Key = Parsestring();
+                    if (!Key || Peek() != u8':') return {};
+                    ++Cursor;
+
+                    auto Value = Parsevalue();
+                    if (!Value) return {};
+                    Result.emplace(std::move(*Key), std::move(*Value));
+
+                    if (Peek() == u8',') ++Cursor;
+                    else if (Peek() != u8'}') return {};
+                }
+
+                ++Cursor;
+                return Result;
+            }
+            std::optional<Value_t> Parsevalue()
+            {
+                Value_t Result{};
+
+                switch (Peek())
+                {
+                    case u8'"':
+                    {
+                        auto Value = Parsestring();
+                        if (!Value) return {};
+                        Result.Storage = std::move(*Value);
+                        return Result;
+                    }
+                    case u8'{':
+                    {
+                        auto Value = Parseobject();
+                        if (!Value) return {};
+                        Result.Storage = std::move(*Value);
+                        return Result;
+                    }
+                    case u8'[':
+                    {
+                        auto Value = Parsearray();
+                        if (!Value) return {};
+                        Result.Storage = std::move(*Value);
+                        return Result;
+                    }
+
+                    // Closing brackets and separators where a value should be, or out of input.
+                    case u8'}': case u8']': case u8',': case u8':': case char8_t{}:
+                        return {};
+
+                    default:
+                        return Parseliteral();
+                }
+            }
+        };
+    }
+
     // Pretty basic safety checks.
     inline Value_t Parse(std::u8string_view JSONString)
     {
         // To simplify other operations, accept a null string.
         if (JSONString.empty()) [[unlikely]] return {};
 
-        // Malformed string check. Missing brackets, null-chars messing up C-string parsing, etc..
-        const auto C1 = std::ranges::count(JSONString, '{') != std::ranges::count(JSONString, '}');
-        const auto C2 = std::ranges::count(JSONString, '[') != std::ranges::count(JSONString, ']');
-        const auto C3 = std::ranges::count(JSONString, '\0') > 1;
-        if (C1 || C2 || C3) [[unlikely]]
+        // Offsets are 32-bit.
+        if (JSONString.size() > UINT32_MAX) [[unlikely]]
         {
-            if (C1) Errorprint("Trying to parse invalid JSON string, missing }");
-            if (C2) Errorprint("Trying to parse invalid JSON string, missing ]");
-            if (C3) Errorprint("Trying to parse invalid JSON string, null-chars in string");
+            Errorprint("Trying to parse an oversized JSON string");
+            assert(false);
+            return {};
+        }
 
+        Structural::Parser_t Parser{ JSONString };
+        if (!Structural::Buildindex(JSONString, Parser.Index)) [[unlikely]]
+        {
+            Errorprint("Trying to parse invalid JSON string, missing \"");
             assert(false);
             return {};
         }
 
-        [[maybe_unused]] const auto Original = JSONString;
-        const auto Value = Parsing::Parsevalue(JSONString);
+        auto Value = Parser.Parsevalue();
         if (!Value)
         {
-            Errorprint(va("JSON Parsing failed at position: %zu", JSONString.data() - Original.data()));
+            Errorprint(va_view("JSON Parsing failed at position: %zu", Parser.Position()));
             if (!std::is_constant_evaluated()) assert(false);
             return {};
         }
 
-        return Value;
+        return std::move(*Value);
     }
     inline Value_t Parse(std::string_view JSONString)
     {
@@ -503,6 +809,412 @@ namespace JSON
     {
         return Value.dump();
     }
+
+    // Read-only document in a single allocation, nodes first and then a copy of the input that strings point into.
+    // Objects are sorted by key for binary search, strings are unescaped in place.
+    class Document_t
+    {
+    public:
+        enum class Type_t : uint8_t { Null, Boolean, Number, Signed, Unsigned, Object, Array, String };
+
+        struct Member_t;
+        struct Node_t
+        {
+            Type_t Type{};
+            uint32_t Size{};
+            union
+            {
+                Boolean_t Boolean;
+                Number_t Number;
+                Signed_t Signed;
+                Unsigned_t Unsigned;
+                const Member_t *Members;
+                const Node_t *Elements;
+                const char8_t *String{};
+            };
+        };
+        struct Member_t { Node_t Key, Value; };
+
+        // Lightweight handle into the document, invalidated with it.
+        class View_t
+        {
+            static const Node_t *Null() { static const Node_t Dummy{}; return &Dummy; }
+            const Node_t *Node{ Null() };
+
+        public:
+            View_t() = default;
+            explicit View_t(const Node_t *Entry) : Node(Entry) {}
+
+            [[nodiscard]] Type_t Type() const { return Node->Type; }
+            template <Supported_t T> [[nodiscard]] bool isType() const
+            {
+                     if constexpr (std::is_same_v<T, Null_t>) return Node->Type == Type_t::Null;
+                else if constexpr (std::is_same_v<T, Boolean_t>) return Node->Type == Type_t::Boolean;
+                else if constexpr (std::is_same_v<T, Number_t>) return Node->Type == Type_t::Number;
+                else if constexpr (std::is_same_v<T, Signed_t>) return Node->Type == Type_t::Signed;
+                else if constexpr (std::is_same_v<T, Unsigned_t>) return Node->Type == Type_t::Unsigned;
+                else if constexpr (std::is_same_v<T, Object_t>) return Node->Type == Type_t::Object;
+                else if constexpr (std::is_same_v<T, Array_t>) return Node->Type == Type_t::Array;
+                else return Node->Type == Type_t::String;
+            }
+
+            [[nodiscard]] std::u8string_view String() const
+            {
+                if (Node->Type != Type_t::String) return {};
+                return { Node->String, Node->Size };
+            }
+            [[nodiscard]] std::span<const Member_t> Members() const
+            {
+                if (Node->Type != Type_t::Object) return {};
+                return { Node->Members, Node->Size };
+            }
+            [[nodiscard]] std::span<const Node_t> Elements() const
+            {
+                if (Node->Type != Type_t::Array) return {};
+                return { Node->Elements, Node->Size };
+            }
+
+            // Provides a null value on error.
+            View_t operator[](size_t i) const
+            {
+                const auto Array = Elements();
+                if (i >= Array.size()) return {};
+                return View_t(&Array[i]);
+            }
+            [[nodiscard]] const Member_t *Find(std::u8string_view Key) const
+            {
+                const auto Object = Members();
+                const auto Entry = std::ranges::lower_bound(Object, Key, {}, [](const Member_t &Item) { return std::u8string_view(Item.Key.String, Item.Key.Size); });
+                if (Entry == Object.end() || std::u8string_view(Entry->Key.String, Entry->Key.Size) != Key) return nullptr;
+                return &*Entry;
+            }
+            View_t operator[](std::u8string_view Key) const
+            {
+                const auto Entry = Find(Key);
+                return Entry ? View_t(&Entry->Value) : View_t{};
+            }
+            template <cmp::Byte_t U> requires(!std::is_same_v<U, char8_t>) View_t operator[](std::basic_string_view<U> Key) const
+            {
+                return operator[](std::u8string_view(Encoding::toUTF8(Key)));
+            }
+            template <cmp::Byte_t U, size_t N> View_t operator[](const U(&Key)[N]) const
+            {
+                if constexpr (std::is_same_v<U, char8_t>) return operator[](std::u8string_view(Key));
+                else return operator[](std::u8string_view(Encoding::toUTF8(Key)));
+            }
+
+            // Same conversion rules as Value_t.
+            template <typename T> T Get() const
+            {
+                     if constexpr (std::is_same_v<T, Null_t>) return {};
+                else if constexpr (std::is_same_v<T, Value_t>) return toValue();
+                else if constexpr (std::is_same_v<T, std::u8string_view>) return String();
+                else if constexpr (std::is_same_v<T, bool>) { if (Node->Type == Type_t::Boolean) return Node->Boolean; return T{}; }
+                else if constexpr (std::is_floating_point_v<T>) { if (Node->Type == Type_t::Number) return T(Node->Number); return T{}; }
+                else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) { if (Node->Type == Type_t::Signed) return T(Node->Signed); return T{}; }
+                else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) { if (Node->Type == Type_t::Unsigned) return T(Node->Unsigned); return T{}; }
+
+                // Blob_t derives from basic_string, so it needs to be checked first.
+                else if constexpr (std::is_same_v<T, Blob_t> || cmp::isDerived<T, std::unordered_set> || cmp::isDerived<T, std::vector> || cmp::isDerived<T, std::set>)
+                {
+                    T Output{};
+                    for (const auto &Item : Elements()) Output.insert(Output.end(), View_t(&Item).Get<typename T::value_type>());
+                    return Output;
+                }
+                else if constexpr (cmp::isDerived<T, std::basic_string>)
+                {
+                    if (Node->Type != Type_t::String) return T{};
+                    return Internal::toString<T>(String_t(String()));
+                }
+
+                // Maps need to be checked last due to typename T::key_type always being considered.
+                else if constexpr ((cmp::isDerived<T, std::unordered_map> || cmp::isDerived<T, std::map>) && cmp::isDerived<typename T::key_type, std::basic_string>)
+                {
+                    T Output{};
+                    for (const auto &Item : Members())
+                        Output.emplace(Internal::toString<typename T::key_type>(String_t(Item.Key.String, Item.Key.Size)), View_t(&Item.Value).Get<typename T::mapped_type>());
+                    return Output;
+                }
+
+                else static_assert(cmp::always_false<T>, "Could not convert JSON value to T");
+
+                std::unreachable();
+            }
+            template <typename T> requires(!std::is_same_v<T, bool>) explicit operator T() const { return Get<T>(); }
+            explicit operator bool() const { return Node->Type != Type_t::Null; }
+
+            // Safer access to the storage.
+            template <typename T = View_t, typename Key_t> T value(const Key_t &Key, const T &Defaultvalue = {}) const
+            {
+                const auto Value = operator[](Key);
+                if (Value.Type() == Type_t::Null) return Defaultvalue;
+                if constexpr (std::is_same_v<T, View_t>) return Value;
+                else return Value.template Get<T>();
+            }
+
+            // Helpers for objects.
+            [[nodiscard]] size_t size() const
+            {
+                return (Node->Type == Type_t::Object || Node->Type == Type_t::Array) ? Node->Size : 0;
+            }
+            [[nodiscard]] bool empty() const
+            {
+                return (Node->Type == Type_t::Object || Node->Type == Type_t::Array || Node->Type == Type_t::String) ? Node->Size == 0 : true;
+            }
+            [[nodiscard]] bool contains(std::u8string_view Key) const
+            {
+                return Find(Key) != nullptr;
+            }
+            [[nodiscard]] bool contains(const std::string &Key) const
+            {
+                return Find(Encoding::toUTF8(Key)) != nullptr;
+            }
+
+            // Copy out into the mutable representation.
+            [[nodiscard]] Value_t toValue() const
+            {
+                Value_t Result{};
+
+                switch (Node->Type)
+                {
+                    case Type_t::Null: break;
+                    case Type_t::Boolean: Result.Storage = Node->Boolean; break;
+                    case Type_t::Number: Result.Storage = Node->Number; break;
+                    case Type_t::Signed: Result.Storage = Node->Signed; break;
+                    case Type_t::Unsigned: Result.Storage = Node->Unsigned; break;
+                    case Type_t::String: Result.Storage = String_t(String()); break;
+                    case Type_t::Array:
+                    {
+                        auto &Array = Result.Storage.emplace<Array_t>();
+                        Array.reserve(Node->Size);
+                        for (const auto &Item : Elements()) Array.emplace_back(View_t(&Item).toValue());
+                        break;
+                    }
+                    case Type_t::Object:
+                    {
+                        auto &Object = Result.Storage.emplace<Object_t>();
+                        for (const auto &Item : Members()) Object.emplace(String_t(View_t(&Item.Key).String()), View_t(&Item.Value).toValue());
+                        break;
+                    }
+                }
+
+                return Result;
+            }
+            [[nodiscard]] std::string dump() const { return toValue().dump(); }
+        };
+
+    private:
+        // The single allocation goes back to whichever resource it came from.
+        struct Release_t
+        {
+            std::pmr::memory_resource *Resource;
+            size_t Size;
+
+            void operator()(uint8_t *Pointer) const noexcept { Resource->deallocate(Pointer, Size, alignof(Node_t)); }
+        };
+
+        std::unique_ptr<uint8_t[], Release_t> Arena{};
+        Node_t Root{};
+
+        struct Builder_t
+        {
+            std::u8string_view Input;
+            char8_t *Text;
+            std::span<const uint32_t> Index;
+            Node_t *Arena;
+            std::vector<Node_t> Stack{};
+            size_t Cursor{};
+
+            [[nodiscard]] char8_t Peek() const
+            {
+                return Cursor < Index.size() ? Input[Index[Cursor]] : char8_t{};
+            }
+            [[nodiscard]] size_t Position() const
+            {
+                return Cursor < Index.size() ? Index[Cursor] : Input.size();
+            }
+
+            bool Parsestring(Node_t &Node)
+            {
+                if (Peek() != u8'"' || Cursor + 1 >= Index.size()) return false;
+
+                const auto Start = Index[Cursor] + 1, Stop = Index[Cursor + 1];
+                Cursor += 2;
+
+                // Same rules as Parsing, the escaped character is kept verbatim. Never grows, so it's done in place.
+                auto Read = Text + Start, Write = Text + Start;
+                const auto End = Text + Stop;
+                if (std::find(Read, End, u8'\\') != End)
+                {
+                    while (Read < End)
+                    {
+                        if (*Read == u8'\\' && Read + 1 < End) ++Read;
+                        *Write++ = *Read++;
+                    }
+                }
+                else Write = const_cast<char8_t *>(End);
+
+                Node.Type = Type_t::String;
+                Node.String = Text + Start;
+                Node.Size = uint32_t(Write - (Text + Start));
+                return true;
+            }
+            bool Parseliteral(Node_t &Node)
+            {
+                const auto Start = Index[Cursor++];
+                auto Token = Input.substr(Start, Position() - Start);
+                while (!Token.empty() && (Token.back() == u8' ' || (Token.back() >= 0x09 && Token.back() <= 0x0D))) Token.remove_suffix(1);
+
+                if (Token == u8"null") { Node.Type = Type_t::Null; return true; }
+                if (Token == u8"true") { Node.Type = Type_t::Boolean; Node.Boolean = true; return true; }
+                if (Token == u8"false") { Node.Type = Type_t::Boolean; Node.Boolean = false; return true; }
+
+                const auto First = (const char *)Token.data(), Last = First + Token.size();
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Node.Unsigned); ec == std::errc() && Ptr == Last) { Node.Type = Type_t::Unsigned; return true; }
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Node.Signed); ec == std::errc() && Ptr == Last) { Node.Type = Type_t::Signed; return true; }
+                if (const auto [Ptr, ec] = std::from_chars(First, Last, Node.Number); ec == std::errc() && Ptr == Last) { Node.Type = Type_t::Number; return true; }
+                return false;
+            }
+
+            // Children are parsed onto the stack, then moved to the arena once the count is known.
+            bool Parsearray(Node_t &Node)
+            {
+                const auto Base = Stack.size();
+                ++Cursor;
+
+                while (Peek() != u8']')
+                {
+                    Node_t Item{};
+                    if (!Parsevalue(Item)) return false;
+                    Stack.push_back(Item);
+
+                    if (Peek() == u8',') ++Cursor;
+                    else if (Peek() != u8']') return false;
+                }
+                ++Cursor;
+
+                const auto Count = Stack.size() - Base;
+                std::copy(Stack.begin() + Base, Stack.end(), Arena);
+
+                Node.Type = Type_t::Array;
+                Node.Size = uint32_t(Count);
+                Node.Elements = Arena;
+
+                Arena += Count;
+                Stack.resize(Base);
+                return true;
+            }
+            bool Parseobject(Node_t &Node)
+            {
+                const auto Base = Stack.size();
+                ++Cursor;
+
+                while (Peek() != u8'}')
+                {
+                    Node_t Key{}, Value{};
+                    if (!Parsestring(Key) || Peek() != u8':') return false;
+                    ++Cursor;
+
+                    if (!Parsevalue(Value)) return false;
+                    Stack.push_back(Key);
+                    Stack.push_back(Value);
+
+                    if (Peek() == u8',') ++Cursor;
+                    else if (Peek() != u8'}') return false;
+                }
+                ++Cursor;
+
+                const auto Count = (Stack.size() - Base) / 2;
+                const auto Members = reinterpret_cast<Member_t *>(Arena);
+                for (size_t i = 0; i < Count; ++i) Members[i] = { Stack[Base + i * 2], Stack[Base + i * 2 + 1] };
+
+                // Stable so that the first duplicate wins, like Object_t::emplace.
+                std::stable_sort(Members, Members + Count, [](const Member_t &A, const Member_t &B)
+                {
+                    return std::u8string_view(A.Key.String, A.Key.Size) < std::u8string_view(B.Key.String, B.Key.Size);
+                });
+
+                Node.Type = Type_t::Object;
+                Node.Size = uint32_t(Count);
+                Node.Members = Members;
+
+                Arena += Count * 2;
+                Stack.resize(Base);
+                return true;
+            }
+            bool Parsevalue(Node_t &Node)
+            {
+                switch (Peek())
+                {
+                    case u8'"': return Parsestring(Node);
+                    case u8'{': return Parseobject(Node);
+                    case u8'[': return Parsearray(Node);
+
+                    // Closing brackets and separators where a value should be, or out of input.
+                    case u8'}': case u8']': case u8',': case u8':': case char8_t{}:
+                        return false;
+
+                    default:
+                        return Parseliteral(Node);
+                }
+            }
+        };
+
+    public:
+        // Same leniency as Parse, an empty or invalid input gives a null document.
+        // Pass e.g. Memory::Localarena() for documents that only live for the current request.
+        static std::optional<Document_t> Parse(std::u8string_view JSONString, std::pmr::memory_resource *Resource = Memory::Upstream())
+        {
+            if (JSONString.empty() || JSONString.size() > UINT32_MAX) [[unlikely]] return {};
+
+            std::vector<uint32_t> Index;
+            if (!Structural::Buildindex(JSONString, Index)) [[unlikely]]
+            {
+                Errorprint("Trying to parse invalid JSON string, missing \"");
+                return {};
+            }
+
+            // Every node starts at an index entry, a member (two nodes) starts at two.
+            const auto Nodebytes = Index.size() * sizeof(Node_t);
+            static_assert(sizeof(Member_t) == 2 * sizeof(Node_t));
+
+            Document_t Result{};
+            const auto Totalbytes = Nodebytes + JSONString.size();
+            Result.Arena = { static_cast<uint8_t *>(Resource->allocate(Totalbytes, alignof(Node_t))), Release_t{ Resource, Totalbytes } };
+
+            const auto Text = reinterpret_cast<char8_t *>(Result.Arena.get() + Nodebytes);
+            std::memcpy(Text, JSONString.data(), JSONString.size());
+
+            Builder_t Builder{ { Text, JSONString.size() }, Text, Index, reinterpret_cast<Node_t *>(Result.Arena.get()) };
+            if (!Builder.Parsevalue(Result.Root))
+            {
+                Errorprint(va_view("JSON Parsing failed at position: %zu", Builder.Position()));
+                return {};
+            }
+
+            return Result;
+        }
+        static std::optional<Document_t> Parse(std::string_view JSONString, std::pmr::memory_resource *Resource = Memory::Upstream())
+        {
+            return Parse(std::u8string_view((const char8_t *)JSONString.data(), JSONString.size()), Resource);
+        }
+
+        // Forward to the root.
+        [[nodiscard]] View_t Get() const { return View_t(&Root); }
+        template <typename T> T Get() const { return Get().Get<T>(); }
+        template <typename Key_t> View_t operator[](const Key_t &Key) const { return Get()[Key]; }
+        template <cmp::Byte_t U, size_t N> View_t operator[](const U(&Key)[N]) const { return Get()[Key]; }
+        template <typename T = View_t, typename Key_t> T value(const Key_t &Key, const T &Defaultvalue = {}) const { return Get().value<T>(Key, Defaultvalue); }
+        [[nodiscard]] bool contains(std::u8string_view Key) const { return Get().contains(Key); }
+        [[nodiscard]] bool contains(const std::string &Key) const { return Get().contains(Key); }
+        [[nodiscard]] size_t size() const { return Get().size(); }
+        [[nodiscard]] bool empty() const { return Get().empty(); }
+        [[nodiscard]] std::string dump() const { return Get().dump(); }
+
+        Document_t() = default;
+        Document_t(Document_t &&) noexcept = default;
+        Document_t &operator=(Document_t &&) noexcept = default;
+    };
 }
 
 #if defined(ENABLE_UNITTESTS)
@@ -527,6 +1239,54 @@ namespace Unittests
         const auto Dump = Parsed.dump();
         if (Dump != JSON::Parse(Dump).dump())
             std::printf("BROKEN: JSON Dumping\n");
+
+        // Structural characters inside strings, escaped quotes, and fractions.
+        const auto Tricky = JSON::Parse(u8R"([ "{[\"", 1.5, -3, { } ])");
+        if (Tricky[0].Get<std::u8string>() != u8"{[\"" || Tricky[1].Get<double>() != 1.5 || Tricky[2].Get<int64_t>() != -3 || !Tricky[3].isType<JSON::Object_t>())
+            std::printf("BROKEN: JSON structural parsing\n");
+
+        // Same values through the arena document.
+        const auto Document = JSON::Document_t::Parse(Input);
+        if (!Document || (*Document)[u8"Object"][u8"Key"].Get<uint32_t>() != 42 || (*Document)[u8"Array"][3].Get<std::u8string>() != u8"mixed"s ||
+            (*Document)[u8"Array"].Get<std::vector<uint64_t>>().size() != 4 || Document->value<uint64_t>(u8"Missing", 7) != 7)
+            std::printf("BROKEN: JSON document\n");
+
+        // Request-scoped documents straight from an arena.
+        Memory::Arena_t Arena(1024);
+        const auto Scoped = JSON::Document_t::Parse(Input, &Arena);
+        if (!Scoped || (*Scoped)[u8"Array"][2].Get<uint64_t>() != 2 || Arena.Used() == 0)
+            std::printf("BROKEN: JSON document resource\n");
     };
 }
 #endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // An array of small records, roughly what config and network payloads look like.
+    inline void JSONbenchmark()
+    {
+        std::string Input = "[";
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            if (i) Input += ',';
+            Input += std::format(R"({{"ID":{},"Name":"Record \"{}\"","Score":{}.5,"Active":{},"Tags":["a","b","c"],"Nested":{{"Key":{}}}}})",
+                                 i, i, i % 100, (i % 2) ? "true" : "false", -int64_t(i));
+        }
+        Input += "]";
+
+        const auto Parsed = JSON::Parse(Input);
+        Measure("JSON::Parse", Input.size(), [&]() { Keep(JSON::Parse(Input)); });
+        Measure("JSON::Document_t::Parse", Input.size(), [&]() { Keep(JSON::Document_t::Parse(Input)); });
+
+        // One reset per request, the arena keeps its largest block so steady-state parsing never touches the heap.
+        Memory::Arena_t Arena{};
+        Measure("JSON::Document_t::Parse (arena)", Input.size(), [&]()
+        {
+            Keep(JSON::Document_t::Parse(Input, &Arena));
+            Arena.Reset();
+        });
+        Measure("JSON::Dump", Input.size(), [&]() { Keep(JSON::Dump(Parsed)); });
+    }
+}
+#endif
@@ -0,0 +1,537 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Pull-style JSON reader fed in chunks, and a writer that emits straight into a sink.
+    Memory is bounded by the largest single token rather than the document.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "JSON.hpp"
+
+namespace JSON::Stream
+{
+    enum class Event_t : uint8_t
+    {
+        Needinput,      // Feed more data, or call Finish.
+        Startobject, Endobject,
+        Startarray, Endarray,
+        Key, String,
+        Unsigned, Signed, Number,
+        Boolean, Null,
+        End,            // Finished between top-level values.
+        Error
+    };
+
+    // Top-level values may follow each other, so newline-delimited JSON is read as a sequence.
+    class Reader_t
+    {
+        enum class Expect_t : uint8_t { Value, Key, Colon, Separator };
+
+        std::u8string Buffer{};
+        size_t Head{};
+
+        // How far past Head an incomplete string has been scanned, so refills don't rescan it.
+        size_t Stringscan{};
+        bool Stringescaped{};
+
+        std::u8string Scratch{};
+        std::u8string_view Text{};
+        std::vector<char8_t> Stack{};
+        Expect_t Expect{ Expect_t::Value };
+        bool Finished{}, Failed{};
+
+        Boolean_t Boolvalue{};
+        Unsigned_t Unsignedvalue{};
+        Signed_t Signedvalue{};
+        Number_t Numbervalue{};
+
+        static constexpr bool isWhitespace(char8_t Char)
+        {
+            return Char == u8' ' || (Char >= 0x09 && Char <= 0x0D);
+        }
+        static constexpr bool isDelimiter(char8_t Char)
+        {
+            return isWhitespace(Char) || Char == u8',' || Char == u8':' || Char == u8'"' || (Char | 0x20) == u8'{' || (Char | 0x20) == u8'}';
+        }
+
+        Event_t Fail()
+        {
+            Failed = true;
+            return Event_t::Error;
+        }
+        Event_t Incomplete()
+        {
+            return Finished ? Fail() : Event_t::Needinput;
+        }
+        void Aftervalue()
+        {
+            Expect = Stack.empty() ? Expect_t::Value : Expect_t::Separator;
+        }
+
+        Event_t Close(char8_t Char)
+        {
+            const auto Opening = (Char == u8'}') ? u8'{' : u8'[';
+            if (Stack.empty() || Stack.back() != Opening) return Fail();
+
+            Stack.pop_back();
+            ++Head;
+            Aftervalue();
+            return (Char == u8'}') ? Event_t::Endobject : Event_t::Endarray;
+        }
+
+        // Full JSON escapes, \u pairs are combined into a single codepoint.
+        bool Unescape(std::u8string_view Input)
+        {
+            Scratch.clear();
+            Scratch.reserve(Input.size());
+
+            const auto Hex = [](std::u8string_view Digits, uint32_t &Value)
+            {
+                Value = 0;
+                if (Digits.size() < 4) return false;
+
+                for (const auto Char : Digits.substr(0, 4))
+                {
+                    Value <<= 4;
+                    if (Char >= u8'0' && Char <= u8'9') Value |= Char - u8'0';
+                    else if ((Char | 0x20) >= u8'a' && (Char | 0x20) <= u8'f') Value |= (Char | 0x20) - u8'a' + 10;
+                    else return false;
+                }
+                return true;
+            };
+
+            for (size_t i = 0; i < Input.size(); ++i)
+            {
+                if (Input[i] != u8'\\') { Scratch.push_back(Input[i]); continue; }
+                if (++i == Input.size()) return false;
+
+                switch (Input[i])
+                {
+                    case u8'b': Scratch.push_back(u8'\b'); break;
+                    case u8'f': Scratch.push_back(u8'\f'); break;
+                    case u8'n': Scratch.push_back(u8'\n'); break;
+                    case u8'r': Scratch.push_back(u8'\r'); break;
+                    case u8't': Scratch.push_back(u8'\t'); break;
+                    case u8'u':
+                    {
+                        uint32_t Codepoint;
+                        if (!Hex(Input.substr(i + 1), Codepoint)) return false;
+                        i += 4;
+
+                        // Surrogate pair.
+                        if (Codepoint >= 0xD800 && Codepoint < 0xDC00 && Input.substr(i + 1).starts_with(u8"\\u"))
+                        {
+                            uint32_t Low;
+                            if (Hex(Input.substr(i + 3), Low) && Low >= 0xDC00 && Low < 0xE000)
+                            {
+                                Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+                                i += 6;
+                            }
+                        }
+
+                        Scratch.append(UTF8::Internal::fromCodepoint(Codepoint));
+                        break;
+                    }
+
+                    // Quotes, slashes, and anything else verbatim.
+                    default: Scratch.push_back(Input[i]); break;
+                }
+            }
+
+            Text = Scratch;
+            return true;
+        }
+
+        Event_t Readstring(Event_t Kind)
+        {
+            for (size_t i = Head + 1 + Stringscan; i < Buffer.size(); ++i)
+            {
+                i = Buffer.find_first_of(u8"\"\\", i);
+                if (i == std::u8string::npos) break;
+
+                if (Buffer[i] == u8'\\')
+                {
+                    // The escaped character is in the next chunk, resume from the backslash.
+                    if (i + 1 == Buffer.size()) { Stringscan = i - Head - 1; return Incomplete(); }
+
+                    Stringescaped = true;
+                    ++i;
+                    continue;
+                }
+
+                const auto Content = std::u8string_view(Buffer).substr(Head + 1, i - Head - 1);
+                const auto Escaped = std::exchange(Stringescaped, false);
+                Head = i + 1;
+                Stringscan = 0;
+
+                if (!Escaped) Text = Content;
+                else if (!Unescape(Content)) return Fail();
+                return Kind;
+            }
+
+            Stringscan = Buffer.size() - Head - 1;
+            return Incomplete();
+        }
+        Event_t Readliteral()
+        {
+            auto Stop = Head;
+            while (Stop < Buffer.size() && !isDelimiter(Buffer[Stop])) ++Stop;
+
+            // The literal may continue in the next chunk.
+            if (Stop == Buffer.size() && !Finished) return Event_t::Needinput;
+
+            const auto Token = std::u8string_view(Buffer).substr(Head, Stop - Head);
+            if (Token.empty()) return Fail();
+
+            Text = Token;
+            Head = Stop;
+            Aftervalue();
+
+            if (Token == u8"null") return Event_t::Null;
+            if (Token == u8"true") { Boolvalue = true; return Event_t::Boolean; }
+            if (Token == u8"false") { Boolvalue = false; return Event_t::Boolean; }
+
+            const auto First = (const char *)Token.data(), Last = First + Token.size();
+            if (const auto [Ptr, ec] = std::from_chars(First, Last, Unsignedvalue); ec == std::errc() && Ptr == Last) return Event_t::Unsigned;
+            if (const auto [Ptr, ec] = std::from_chars(First, Last, Signedvalue); ec == std::errc() && Ptr == Last) return Event_t::Signed;
+            if (const auto [Ptr, ec] = std::from_chars(First, Last, Numbervalue); ec == std::errc() && Ptr == Last) return Event_t::Number;
+            return Fail();
+        }
+
+    public:
+        // Invalidates the views returned by String().
+        void Feed(std::u8string_view Chunk)
+        {
+            // Only keep what has not been consumed.
+            Buffer.erase(0, Head);
+            Head = 0;
+
+            Buffer.append(Chunk);
+        }
+        void Feed(std::string_view Chunk)
+        {
+            Feed(std::u8string_view((const char8_t *)Chunk.data(), Chunk.size()));
+        }
+
+        // No more input, so trailing literals are complete.
+        void Finish() { Finished = true; }
+
+        Event_t Next()
+        {
+            if (Failed) [[unlikely]] return Event_t::Error;
+
+            while (true)
+            {
+                while (Head < Buffer.size() && isWhitespace(Buffer[Head])) ++Head;
+
+                if (Head == Buffer.size())
+                {
+                    if (!Finished) return Event_t::Needinput;
+                    if (Stack.empty() && Expect == Expect_t::Value) return Event_t::End;
+                    return Fail();
+                }
+
+                const auto Char = Buffer[Head];
+                switch (Expect)
+                {
+                    case Expect_t::Colon:
+                    {
+                        if (Char != u8':') return Fail();
+                        ++Head;
+                        Expect = Expect_t::Value;
+                        continue;
+                    }
+                    case Expect_t::Separator:
+                    {
+                        if (Char == u8',')
+                        {
+                            ++Head;
+                            Expect = (Stack.back() == u8'{') ? Expect_t::Key : Expect_t::Value;
+                            continue;
+                        }
+
+                        if (Char == u8'}' || Char == u8']') return Close(Char);
+                        return Fail();
+                    }
+                    case Expect_t::Key:
+                    {
+                        // Same leniency as Parse for trailing commas.
+                        if (Char == u8'}') return Close(Char);
+                        if (Char != u8'"') return Fail();
+
+                        const auto Event = Readstring(Event_t::Key);
+                        if (Event == Event_t::Key) Expect = Expect_t::Colon;
+                        return Event;
+                    }
+                    case Expect_t::Value:
+                    {
+                        if (Char == u8'{' || Char == u8'[')
+                        {
+                            Stack.push_back(Char);
+                            ++Head;
+                            Expect = (Char == u8'{') ? Expect_t::Key : Expect_t::Value;
+                            return (Char == u8'{') ? Event_t::Startobject : Event_t::Startarray;
+                        }
+
+                        // Empty arrays, and trailing commas.
+                        if (Char == u8']' && !Stack.empty() && Stack.back() == u8'[') return Close(Char);
+
+                        if (Char == u8'"')
+                        {
+                            const auto Event = Readstring(Event_t::String);
+                            if (Event == Event_t::String) Aftervalue();
+                            return Event;
+                        }
+
+                        return Readliteral();
+                    }
+                }
+            }
+        }
+
+        // Valid until the next call to Next or Feed.
+        [[nodiscard]] std::u8string_view String() const { return Text; }
+        [[nodiscard]] Boolean_t Boolean() const { return Boolvalue; }
+        [[nodiscard]] Unsigned_t Unsigned() const { return Unsignedvalue; }
+        [[nodiscard]] Signed_t Signed() const { return Signedvalue; }
+        [[nodiscard]] Number_t Number() const { return Numbervalue; }
+
+        // Open containers, zero between top-level values.
+        [[nodiscard]] size_t Depth() const { return Stack.size(); }
+
+        // Bytes held for incomplete tokens.
+        [[nodiscard]] size_t Buffered() const { return Buffer.size() - Head; }
+    };
+
+    // Staged in a small buffer and flushed to the sink, top-level values are newline-delimited.
+    class Writer_t
+    {
+        std::function<void(std::string_view)> Sink;
+        std::array<char, 4096> Staging;
+        size_t Used{};
+
+        std::vector<bool> Firstitem{};
+        bool Afterkey{}, Anyrecord{};
+
+        void Reserve(size_t Size)
+        {
+            if (Used + Size > Staging.size()) Flush();
+        }
+        void Put(char Char)
+        {
+            Reserve(1);
+            Staging[Used++] = Char;
+        }
+        void Put(std::string_view Data)
+        {
+            if (Data.size() > Staging.size())
+            {
+                Flush();
+                Sink(Data);
+                return;
+            }
+
+            Reserve(Data.size());
+            std::memcpy(Staging.data() + Used, Data.data(), Data.size());
+            Used += Data.size();
+        }
+
+        void Separate()
+        {
+            if (Afterkey) { Afterkey = false; return; }
+
+            if (Firstitem.empty())
+            {
+                if (Anyrecord) Put('\n');
+                Anyrecord = true;
+                return;
+            }
+
+            if (!Firstitem.back()) Put(',');
+            Firstitem.back() = false;
+        }
+
+        // Unescaped runs are copied in one go.
+        void Quote(std::string_view Input)
+        {
+            Put('"');
+
+            size_t Start = 0;
+            for (size_t i = 0; i < Input.size(); ++i)
+            {
+                const auto Char = uint8_t(Input[i]);
+                if (Char >= 0x20 && Char != '"' && Char != '\\') continue;
+
+                Put(Input.substr(Start, i - Start));
+                Start = i + 1;
+
+                switch (Char)
+                {
+                    case '"': Put("\\\""); break;
+                    case '\\': Put("\\\\"); break;
+                    case '\b': Put("\\b"); break;
+                    case '\f': Put("\\f"); break;
+                    case '\n': Put("\\n"); break;
+                    case '\r': Put("\\r"); break;
+                    case '\t': Put("\\t"); break;
+                    default:
+                    {
+                        constexpr char Hex[] = "0123456789abcdef";
+                        const char Escape[] = { '\\', 'u', '0', '0', Hex[Char >> 4], Hex[Char & 0xF] };
+                        Put(std::string_view(Escape, sizeof(Escape)));
+                    }
+                }
+            }
+
+            Put(Input.substr(Start));
+            Put('"');
+        }
+        template <typename T> void Format(T Value)
+        {
+            Reserve(32);
+            const auto Result = std::to_chars(Staging.data() + Used, Staging.data() + Staging.size(), Value);
+            Used = Result.ptr - Staging.data();
+        }
+
+    public:
+        explicit Writer_t(std::function<void(std::string_view)> Output) : Sink(std::move(Output)) {}
+
+        // Bytebuffer_t and anything else with the same raw interface.
+        template <typename Buffer_t> requires requires(Buffer_t &Buffer) { Buffer.rawWrite(size_t{}, (const void *)nullptr); }
+        explicit Writer_t(Buffer_t &Buffer) : Sink([&Buffer](std::string_view Data) { Buffer.rawWrite(Data.size(), Data.data()); }) {}
+
+        ~Writer_t() { Flush(); }
+        Writer_t(const Writer_t &) = delete;
+        Writer_t &operator=(const Writer_t &) = delete;
+
+        void Flush()
+        {
+            if (Used) Sink(std::string_view(Staging.data(), Used));
+            Used = 0;
+        }
+
+        Writer_t &Startobject() { Separate(); Put('{'); Firstitem.push_back(true); return *this; }
+        Writer_t &Startarray() { Separate(); Put('['); Firstitem.push_back(true); return *this; }
+        Writer_t &Endobject() { ASSERT(!Firstitem.empty()); Firstitem.pop_back(); Put('}'); return *this; }
+        Writer_t &Endarray() { ASSERT(!Firstitem.empty()); Firstitem.pop_back(); Put(']'); return *this; }
+
+        template <typename T> Writer_t &Key(const T &Name)
+        {
+            Separate();
+            Quote(std::string_view((const char *)std::basic_string_view(Name).data(), std::basic_string_view(Name).size()));
+            Put(':');
+            Afterkey = true;
+            return *this;
+        }
+
+        // Scalars, strings in any byte-sized encoding, and whole Value_t trees.
+        template <typename T> Writer_t &Value(const T &Item)
+        {
+            if constexpr (std::is_same_v<T, Value_t>)
+            {
+                if (Item.template isType<Object_t>())
+                {
+                    Startobject();
+                    for (const auto &[Name, Child] : std::get<Object_t>(Item.Storage)) Key(Name).Value(Child);
+                    return Endobject();
+                }
+                if (Item.template isType<Array_t>())
+                {
+                    Startarray();
+                    for (const auto &Child : std::get<Array_t>(Item.Storage)) Value(Child);
+                    return Endarray();
+                }
+
+                return std::visit([this](const auto &Scalar) -> Writer_t &
+                {
+                    using Type = std::decay_t<decltype(Scalar)>;
+                    if constexpr (std::is_same_v<Type, Object_t> || std::is_same_v<Type, Array_t>) return *this;
+                    else return Value(Scalar);
+                }, Item.Storage);
+            }
+            else
+            {
+                Separate();
+
+                     if constexpr (std::is_same_v<T, Null_t> || std::is_same_v<T, std::nullptr_t>) Put("null");
+                else if constexpr (std::is_same_v<T, bool>) Put(Item ? "true" : "false");
+                else if constexpr (std::is_floating_point_v<T>) { if (std::isfinite(Item)) Format(Item); else Put("null"); }
+                else if constexpr (std::is_integral_v<T>) Format(Item);
+                else if constexpr (std::is_constructible_v<std::u8string_view, const T &>)
+                {
+                    const auto View = std::u8string_view(Item);
+                    Quote(std::string_view((const char *)View.data(), View.size()));
+                }
+                else if constexpr (std::is_constructible_v<std::string_view, const T &>) Quote(std::string_view(Item));
+                else static_assert(cmp::always_false<T>, "Could not write T as JSON");
+
+                return *this;
+            }
+        }
+    };
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void JSONstreamtest()
+    {
+        using JSON::Stream::Event_t;
+
+        std::string Output{};
+        {
+            JSON::Stream::Writer_t Writer([&](std::string_view Data) { Output.append(Data); });
+            Writer.Startobject().Key(u8"a").Startarray().Value(1).Value(-2).Value(3.5).Value("x\ny").Endarray().Key("b").Value(nullptr).Endobject();
+            Writer.Startobject().Key("c").Value(true).Endobject();
+        }
+
+        const auto Text = std::string_view(Output);
+        if (Text != R"({"a":[1,-2,3.5,"x\ny"],"b":null})" "\n" R"({"c":true})")
+            std::printf("BROKEN: JSON stream writing\n");
+
+        // Feed a few bytes at a time so every token straddles a chunk.
+        JSON::Stream::Reader_t Reader{};
+        std::vector<Event_t> Events{};
+        std::u8string Strings{};
+
+        for (size_t Offset = 0; Offset <= Text.size(); Offset += 3)
+        {
+            if (Offset < Text.size()) Reader.Feed(Text.substr(Offset, 3));
+            else Reader.Finish();
+
+            for (auto Event = Reader.Next(); Event != Event_t::Needinput && Event != Event_t::End && Event != Event_t::Error; Event = Reader.Next())
+            {
+                Events.push_back(Event);
+                if (Event == Event_t::Key || Event == Event_t::String) Strings.append(Reader.String());
+                if (Event == Event_t::Number && Reader.Number() != 3.5) std::printf("BROKEN: JSON stream reading\n");
+                if (Event == Event_t::Signed && Reader.Signed() != -2) std::printf("BROKEN: JSON stream reading\n");
+            }
+        }
+
+        const std::vector<Event_t> Expected
+        {
+            Event_t::Startobject, Event_t::Key, Event_t::Startarray, Event_t::Unsigned, Event_t::Signed, Event_t::Number, Event_t::String, Event_t::Endarray,
+            Event_t::Key, Event_t::Null, Event_t::Endobject, Event_t::Startobject, Event_t::Key, Event_t::Boolean, Event_t::Endobject
+        };
+
+        if (Events != Expected || Strings != u8"ax\nybc") std::printf("BROKEN: JSON stream reading\n");
+
+        // A long string one byte per chunk, with escapes split from the character they escape.
+        std::u8string Long{ u8"\"" }, Plain{};
+        for (int i = 0; i < 500; ++i) { Long += u8R"(ab\\\")"; Plain += u8R"(ab\")"; }
+        Long += u8"\"";
+
+        JSON::Stream::Reader_t Bytewise{};
+        auto Event = Event_t::Needinput;
+        for (size_t i = 0; i < Long.size() && Event == Event_t::Needinput; ++i)
+        {
+            Bytewise.Feed(Long.substr(i, 1));
+            Event = Bytewise.Next();
+        }
+        if (Event != Event_t::String || Bytewise.String() != Plain || Bytewise.Buffered() != 0) std::printf("BROKEN: JSON stream chunked string\n");
+    }
+}
+#endif
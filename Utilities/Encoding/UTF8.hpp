@@ -267,11 +267,297 @@ namespace UTF8
         }
     }
 
+    // Strict RFC 3629 validation, no overlongs, surrogates or codepoints past U+10FFFF.
+    namespace Internal
+    {
+        constexpr bool isValidscalar(std::u8string_view Input)
+        {
+            for (size_t i = 0; i < Input.size();)
+            {
+                const auto Lead = uint8_t(Input[i]);
+                if (Lead < 0x80) { ++i; continue; }
+
+                size_t Length; uint32_t Codepoint, Minimum;
+                     if ((Lead & 0xE0) == 0xC0) { Length = 2; Codepoint = Lead & 0x1F; Minimum = 0x80; }
+                else if ((Lead & 0xF0) == 0xE0) { Length = 3; Codepoint = Lead & 0x0F; Minimum = 0x800; }
+                else if ((Lead & 0xF8) == 0xF0) { Length = 4; Codepoint = Lead & 0x07; Minimum = 0x10000; }
+                else return false;
+
+                if (i + Length > Input.size()) return false;
+                for (size_t k = 1; k < Length; ++k)
+                {
+                    const auto Byte = uint8_t(Input[i + k]);
+                    if ((Byte & 0xC0) != 0x80) return false;
+                    Codepoint = (Codepoint << 6) | (Byte & 0x3F);
+                }
+
+                if (Codepoint < Minimum || Codepoint > 0x10FFFF || (Codepoint >= 0xD800 && Codepoint < 0xE000)) return false;
+                i += Length;
+            }
+
+            return true;
+        }
+
+        #if defined(HAS_CPUID)
+        struct SSE_t
+        {
+            using Vector_t = __m128i;
+            static constexpr size_t Width = 16;
+
+            static Vector_t Load(const void *Data) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data)); }
+            static Vector_t Zero() { return _mm_setzero_si128(); }
+            static Vector_t Or(Vector_t A, Vector_t B) { return _mm_or_si128(A, B); }
+            static Vector_t And(Vector_t A, Vector_t B) { return _mm_and_si128(A, B); }
+            static Vector_t Xor(Vector_t A, Vector_t B) { return _mm_xor_si128(A, B); }
+            static Vector_t Set1(uint8_t Value) { return _mm_set1_epi8(char(Value)); }
+            static Vector_t Table(const std::array<uint8_t, 16> &Values) { return Load(Values.data()); }
+            static Vector_t Lookup(Vector_t Table, Vector_t Index) { return _mm_shuffle_epi8(Table, Index); }
+            static Vector_t High(Vector_t Input) { return _mm_and_si128(_mm_srli_epi16(Input, 4), Set1(0x0F)); }
+            static Vector_t Subs(Vector_t A, Vector_t B) { return _mm_subs_epu8(A, B); }
+            static bool isASCII(Vector_t Input) { return _mm_movemask_epi8(Input) == 0; }
+            static bool Any(Vector_t Input) { return !_mm_testz_si128(Input, Input); }
+            template <int N> static Vector_t Previous(Vector_t Input, Vector_t Prior) { return _mm_alignr_epi8(Input, Prior, 16 - N); }
+
+            // Lanes that have to be below the limit for a sequence to end in this block.
+            static Vector_t Incompletelimit()
+            {
+                return _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+            }
+        };
+        struct AVX2_t
+        {
+            using Vector_t = __m256i;
+            static constexpr size_t Width = 32;
+
+            static Vector_t Load(const void *Data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Data)); }
+            static Vector_t Zero() { return _mm256_setzero_si256(); }
+            static Vector_t Or(Vector_t A, Vector_t B) { return _mm256_or_si256(A, B); }
+            static Vector_t And(Vector_t A, Vector_t B) { return _mm256_and_si256(A, B); }
+            static Vector_t Xor(Vector_t A, Vector_t B) { return _mm256_xor_si256(A, B); }
+            static Vector_t Set1(uint8_t Value) { return _mm256_set1_epi8(char(Value)); }
+            static Vector_t Table(const std::array<uint8_t, 16> &Values) { return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Values.data()))); }
+            static Vector_t Lookup(Vector_t Table, Vector_t Index) { return _mm256_shuffle_epi8(Table, Index); }
+            static Vector_t High(Vector_t Input) { return _mm256_and_si256(_mm256_srli_epi16(Input, 4), Set1(0x0F)); }
+            static Vector_t Subs(Vector_t A, Vector_t B) { return _mm256_subs_epu8(A, B); }
+            static bool isASCII(Vector_t Input) { return _mm256_movemask_epi8(Input) == 0; }
+            static bool Any(Vector_t Input) { return !_mm256_testz_si256(Input, Input); }
+            template <int N> static Vector_t Previous(Vector_t Input, Vector_t Prior) { return _mm256_alignr_epi8(Input, _mm256_permute2x128_si256(Prior, Input, 0x21), 16 - N); }
+
+            static Vector_t Incompletelimit()
+            {
+                return _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+            }
+        };
+
+        // Keiser & Lemire, three nibble lookups classify every two-byte window, then 3/4-byte continuations are checked.
+        template <typename SIMD> bool isValidSIMD(std::u8string_view Input)
+        {
+            using Vector_t = typename SIMD::Vector_t;
+
+            constexpr uint8_t Tooshort = 1 << 0, Toolong = 1 << 1, Overlong3 = 1 << 2, Toolarge = 1 << 3;
+            constexpr uint8_t Surrogate = 1 << 4, Overlong2 = 1 << 5, Toolarge1000 = 1 << 6, Overlong4 = 1 << 6, Twoconts = 1 << 7;
+            constexpr uint8_t Carry = Tooshort | Toolong | Twoconts;
+
+            const auto Byte1high = SIMD::Table({ Toolong, Toolong, Toolong, Toolong, Toolong, Toolong, Toolong, Toolong,
+                                                 Twoconts, Twoconts, Twoconts, Twoconts,
+                                                 Tooshort | Overlong2, Tooshort, Tooshort | Overlong3 | Surrogate, Tooshort | Toolarge | Toolarge1000 | Overlong4 });
+            const auto Byte1low = SIMD::Table({ Carry | Overlong3 | Overlong2 | Overlong4, Carry | Overlong2, Carry, Carry,
+                                                Carry | Toolarge, Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000,
+                                                Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000,
+                                                Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000 | Surrogate, Carry | Toolarge | Toolarge1000, Carry | Toolarge | Toolarge1000 });
+            const auto Byte2high = SIMD::Table({ Tooshort, Tooshort, Tooshort, Tooshort, Tooshort, Tooshort, Tooshort, Tooshort,
+                                                 Toolong | Overlong2 | Twoconts | Overlong3 | Toolarge1000 | Overlong4,
+                                                 Toolong | Overlong2 | Twoconts | Overlong3 | Toolarge,
+                                                 Toolong | Overlong2 | Twoconts | Surrogate | Toolarge,
+                                                 Toolong | Overlong2 | Twoconts | Surrogate | Toolarge,
+                                                 Tooshort, Tooshort, Tooshort, Tooshort });
+
+            const auto Low = SIMD::Set1(0x0F), Third = SIMD::Set1(0xE0 - 0x80), Fourth = SIMD::Set1(0xF0 - 0x80), Highbit = SIMD::Set1(0x80);
+            const auto Limit = SIMD::Incompletelimit();
+
+            auto Error = SIMD::Zero(), Prior = SIMD::Zero(), Incomplete = SIMD::Zero();
+            const auto Check = [&](Vector_t Block)
+            {
+                if (SIMD::isASCII(Block))
+                {
+                    Error = SIMD::Or(Error, Incomplete);
+                }
+                else
+                {
+                    const auto Prev1 = SIMD::template Previous<1>(Block, Prior);
+                    const auto Special = SIMD::And(SIMD::And(SIMD::Lookup(Byte1high, SIMD::High(Prev1)), SIMD::Lookup(Byte1low, SIMD::And(Prev1, Low))), SIMD::Lookup(Byte2high, SIMD::High(Block)));
+
+                    const auto Prev2 = SIMD::template Previous<2>(Block, Prior);
+                    const auto Prev3 = SIMD::template Previous<3>(Block, Prior);
+                    const auto Continuation = SIMD::And(SIMD::Or(SIMD::Subs(Prev2, Third), SIMD::Subs(Prev3, Fourth)), Highbit);
+
+                    Error = SIMD::Or(Error, SIMD::Xor(Continuation, Special));
+                    Incomplete = SIMD::Subs(Block, Limit);
+                }
+
+                Prior = Block;
+            };
+
+            size_t Offset = 0;
+            for (; Offset + SIMD::Width <= Input.size(); Offset += SIMD::Width)
+                Check(SIMD::Load(Input.data() + Offset));
+
+            // Zero padding reads as ASCII, so a truncated tail is caught as too short.
+            if (Offset < Input.size())
+            {
+                std::array<uint8_t, SIMD::Width> Tail{};
+                std::memcpy(Tail.data(), Input.data() + Offset, Input.size() - Offset);
+                Check(SIMD::Load(Tail.data()));
+            }
+
+            return !SIMD::Any(SIMD::Or(Error, Incomplete));
+        }
+
+        // Leading ASCII bytes, a word at a time.
+        inline size_t ASCIIprefix(const char8_t *Data, size_t Size)
+        {
+            size_t Offset = 0;
+
+            if (CPUID::hasAVX2())
+            {
+                for (; Offset + 32 <= Size; Offset += 32)
+                    if (const auto Mask = uint32_t(_mm256_movemask_epi8(AVX2_t::Load(Data + Offset))))
+                        return Offset + std::countr_zero(Mask);
+            }
+
+            for (; Offset + 16 <= Size; Offset += 16)
+                if (const auto Mask = uint32_t(_mm_movemask_epi8(SSE_t::Load(Data + Offset))))
+                    return Offset + std::countr_zero(Mask);
+
+            while (Offset < Size && Data[Offset] < 0x80) ++Offset;
+            return Offset;
+        }
+
+        // Every byte that isn't a continuation starts a codepoint.
+        inline size_t Countleads(const char8_t *Data, size_t Size)
+        {
+            size_t Offset = 0, Count = 0;
+
+            if (CPUID::hasAVX2())
+            {
+                for (; Offset + 32 <= Size; Offset += 32)
+                    Count += std::popcount(uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(AVX2_t::Load(Data + Offset), _mm256_set1_epi8(-65)))));
+            }
+
+            for (; Offset + 16 <= Size; Offset += 16)
+                Count += std::popcount(uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(SSE_t::Load(Data + Offset), _mm_set1_epi8(-65)))));
+
+            for (; Offset < Size; ++Offset) Count += (Data[Offset] & 0xC0) != 0x80;
+            return Count;
+        }
+
+        // Zero-extend ASCII into 16 or 32-bit units.
+        template <typename T> void Widen(const char8_t *Data, size_t Size, T *Output)
+        {
+            static_assert(sizeof(T) == 2 || sizeof(T) == 4);
+            size_t Offset = 0;
+
+            for (; Offset + 16 <= Size; Offset += 16)
+            {
+                const auto Input = SSE_t::Load(Data + Offset);
+                const auto Zero = _mm_setzero_si128();
+                const auto Low = _mm_unpacklo_epi8(Input, Zero), High = _mm_unpackhi_epi8(Input, Zero);
+
+                if constexpr (sizeof(T) == 2)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset), Low);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset + 8), High);
+                }
+                else
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset), _mm_unpacklo_epi16(Low, Zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset + 4), _mm_unpackhi_epi16(Low, Zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset + 8), _mm_unpacklo_epi16(High, Zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset + 12), _mm_unpackhi_epi16(High, Zero));
+                }
+            }
+
+            for (; Offset < Size; ++Offset) Output[Offset] = T(Data[Offset]);
+        }
+
+        // Leading units below 0x80, narrowed while scanning.
+        template <typename T> size_t Narrow(const T *Data, size_t Size, char8_t *Output)
+        {
+            static_assert(sizeof(T) == 2 || sizeof(T) == 4);
+            size_t Offset = 0;
+
+            for (; Offset + 16 <= Size; Offset += 16)
+            {
+                __m128i Bytes;
+                if constexpr (sizeof(T) == 2)
+                {
+                    const auto A = SSE_t::Load(Data + Offset), B = SSE_t::Load(Data + Offset + 8);
+                    const auto Wide = _mm_and_si128(_mm_or_si128(A, B), _mm_set1_epi16(int16_t(0xFF80)));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi16(Wide, _mm_setzero_si128())) != 0xFFFF) break;
+                    Bytes = _mm_packus_epi16(A, B);
+                }
+                else
+                {
+                    const auto A = SSE_t::Load(Data + Offset), B = SSE_t::Load(Data + Offset + 4);
+                    const auto C = SSE_t::Load(Data + Offset + 8), D = SSE_t::Load(Data + Offset + 12);
+                    const auto Wide = _mm_and_si128(_mm_or_si128(_mm_or_si128(A, B), _mm_or_si128(C, D)), _mm_set1_epi32(int32_t(0xFFFFFF80)));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(Wide, _mm_setzero_si128())) != 0xFFFF) break;
+                    Bytes = _mm_packus_epi16(_mm_packs_epi32(A, B), _mm_packs_epi32(C, D));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(Output + Offset), Bytes);
+            }
+
+            for (; Offset < Size && uint32_t(Data[Offset]) < 0x80; ++Offset) Output[Offset] = char8_t(Data[Offset]);
+            return Offset;
+        }
+        #endif
+
+        // Non-allocating version of fromCodepoint for the common 1 - 4 byte range.
+        constexpr size_t Encodepoint(Codepoint_t Code, char8_t *Output)
+        {
+            if (Code < 0x80) { Output[0] = char8_t(Code); return 1; }
+            if (Code < 0x800) { Output[0] = char8_t(0xC0 | (Code >> 6)); Output[1] = char8_t(0x80 | (Code & 0x3F)); return 2; }
+            if (Code < 0x10000)
+            {
+                Output[0] = char8_t(0xE0 | (Code >> 12));
+                Output[1] = char8_t(0x80 | ((Code >> 6) & 0x3F));
+                Output[2] = char8_t(0x80 | (Code & 0x3F));
+                return 3;
+            }
+
+            Output[0] = char8_t(0xF0 | ((Code >> 18) & 0x07));
+            Output[1] = char8_t(0x80 | ((Code >> 12) & 0x3F));
+            Output[2] = char8_t(0x80 | ((Code >> 6) & 0x3F));
+            Output[3] = char8_t(0x80 | (Code & 0x3F));
+            return 4;
+        }
+    }
+
+    constexpr bool isValid(std::u8string_view Input)
+    {
+        #if defined(HAS_CPUID)
+        if (!std::is_constant_evaluated())
+        {
+            if (CPUID::hasAVX2()) return Internal::isValidSIMD<Internal::AVX2_t>(Input);
+            if (CPUID::hasSSE41()) return Internal::isValidSIMD<Internal::SSE_t>(Input);
+        }
+        #endif
+
+        return Internal::isValidscalar(Input);
+    }
+
     constexpr size_t strlen(std::u8string_view Input)
     {
         if (Encoding::isASCII(std::span(Input))) [[likely]]
             return Input.size();
 
+        // Valid input can just count the lead bytes.
+        #if defined(HAS_CPUID)
+        if (!std::is_constant_evaluated() && isValid(Input)) return Internal::Countleads(Input.data(), Input.size());
+        #endif
+
         size_t Size{};
         for (auto it = Input.begin(); it != Input.end();)
         {
@@ -356,6 +642,22 @@ namespace Encoding
 
         while (!Input.empty())
         {
+            // Runs of ASCII are widened a vector at a time.
+            #if defined(HAS_CPUID)
+            if (!std::is_constant_evaluated())
+            {
+                if (const auto Run = UTF8::Internal::ASCIIprefix(Input.data(), Input.size()))
+                {
+                    const auto Used = Buffer.size();
+                    Buffer.resize(Used + Run);
+                    UTF8::Internal::Widen(Input.data(), Run, Buffer.data() + Used);
+
+                    Input.remove_prefix(Run);
+                    if (Input.empty()) break;
+                }
+            }
+            #endif
+
             const auto Codepoint = UTF8::Internal::toCodepoint(Input);
             const auto Size = UTF8::Internal::Sequencelength(Codepoint);
 
@@ -402,15 +704,41 @@ namespace Encoding
     constexpr std::u8string toUTF8(std::wstring_view Input)
     {
         std::u8string Result{};
-        Result.reserve(Input.size() * 3);
 
         // Common case is that it's only ASCII data.
         if (std::min(Input.find(L"\\u"), Input.find(L"\\U")) == std::wstring_view::npos) [[likely]]
         {
-            for (const auto &Item : Input) Result.append(UTF8::Internal::fromCodepoint(Item));
+            // Worst case of a 16-bit unit, or a legacy 6-byte sequence for 32-bit wchar_t.
+            Result.resize(Input.size() * (sizeof(wchar_t) == 2 ? 3 : 6));
+            size_t Used = 0;
+
+            for (size_t i = 0; i < Input.size();)
+            {
+                #if defined(HAS_CPUID)
+                if (!std::is_constant_evaluated())
+                {
+                    const auto Run = UTF8::Internal::Narrow(Input.data() + i, Input.size() - i, Result.data() + Used);
+                    Used += Run; i += Run;
+                    if (i == Input.size()) break;
+                }
+                #endif
+
+                const auto Code = UTF8::Codepoint_t(Input[i++]);
+                if (Code < 0x200000) [[likely]] Used += UTF8::Internal::Encodepoint(Code, Result.data() + Used);
+                else
+                {
+                    const auto Sequence = UTF8::Internal::fromCodepoint(Code);
+                    std::ranges::copy(Sequence, Result.begin() + Used);
+                    Used += Sequence.size();
+                }
+            }
+
+            Result.resize(Used);
             return Result;
         }
 
+        Result.reserve(Input.size() * 3);
+
         // In case of extended 32-bit codepoints.
         UTF8::Codepoint_t Extendedpoint{};
 
@@ -542,5 +870,140 @@ namespace Unittests
     constexpr bool UTF8Test4 = "???" == Encoding::toASCII(Encoding::toUNICODE(u8"åäö"));
 
     static_assert(UTF8Test1 && UTF8Test2 && UTF8Test3 && UTF8Test4, "BROKEN: UTF8 encoding (verify that the source-file is saved as UTF8)");
+
+    // Boundaries of the scalar validator, which the SIMD paths are checked against.
+    static_assert(UTF8::Internal::isValidscalar(u8"a\u00E5\u65E5\U0001F600"), "BROKEN: UTF8 scalar validation");
+    static_assert(UTF8::Internal::isValidscalar(u8"\xED\x9F\xBF\xEE\x80\x80\xF4\x8F\xBF\xBF"), "BROKEN: UTF8 scalar validation (edges)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\xC0\xAF") && !UTF8::Internal::isValidscalar(u8"\xC1\xBF"), "BROKEN: UTF8 scalar validation (overlong 2)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\xE0\x80\xAF") && !UTF8::Internal::isValidscalar(u8"\xF0\x80\x80\xAF"), "BROKEN: UTF8 scalar validation (overlong 3/4)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\xED\xA0\x80") && !UTF8::Internal::isValidscalar(u8"\xED\xBF\xBF"), "BROKEN: UTF8 scalar validation (surrogate)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\xF4\x90\x80\x80") && !UTF8::Internal::isValidscalar(u8"\xF5\x80\x80\x80"), "BROKEN: UTF8 scalar validation (> U+10FFFF)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\xE2\x82") && !UTF8::Internal::isValidscalar(u8"a\xF0\x9F\x98"), "BROKEN: UTF8 scalar validation (truncated)");
+    static_assert(!UTF8::Internal::isValidscalar(u8"\x80") && !UTF8::Internal::isValidscalar(u8"\xC3\xA5\xA5"), "BROKEN: UTF8 scalar validation (stray continuation)");
+
+    #if defined(HAS_CPUID)
+    // The vector paths against the scalar ones, with every offset and length across a 16 / 32 byte block.
+    inline void UTF8test()
+    {
+        const auto Scalarlength = [](std::u8string_view Input) { return size_t(std::ranges::count_if(Input, [](char8_t Byte) { return (Byte & 0xC0) != 0x80; })); };
+        const auto Validate = [](std::u8string_view Input)
+        {
+            const auto Expected = UTF8::Internal::isValidscalar(Input);
+            if (CPUID::hasSSE41() && UTF8::Internal::isValidSIMD<UTF8::Internal::SSE_t>(Input) != Expected) return false;
+            if (CPUID::hasAVX2() && UTF8::Internal::isValidSIMD<UTF8::Internal::AVX2_t>(Input) != Expected) return false;
+            return true;
+        };
+
+        // BMP only, so that either wchar_t width roundtrips through the public API.
+        std::u8string Text{}, BMP{};
+        constexpr std::u8string_view Points[] = { u8"a", u8"\u00E5", u8"\u65E5", u8"\U0001F600", u8"bc", u8"\u07FF", u8"\uFFFD" };
+        for (uint32_t State = 7; Text.size() < 160;)
+        {
+            State = State * 1103515245U + 12345U;
+            const auto &Point = Points[(State >> 16) % std::size(Points)];
+
+            Text += Point;
+            if (Point.size() < 4) BMP += Point;
+        }
+
+        // Slices that start or end mid-sequence are the invalid cases.
+        bool Broken = false;
+        for (size_t Offset = 0; Offset < 70 && !Broken; ++Offset)
+        {
+            for (size_t Size = 0; Size <= 80 && !Broken; ++Size)
+            {
+                const auto Slice = std::u8string_view(Text).substr(Offset, Size);
+                Broken |= !Validate(Slice);
+                Broken |= UTF8::Internal::Countleads(Slice.data(), Slice.size()) != Scalarlength(Slice);
+            }
+        }
+        if (Broken) std::printf("BROKEN: UTF8 SIMD validation (slices)\n");
+
+        // Malformed sequences placed across every block boundary in both ASCII and non-ASCII surroundings.
+        constexpr std::u8string_view Malformed[] = { u8"\xC0\xAF", u8"\xE0\x80\xAF", u8"\xF0\x80\x80\xAF", u8"\xED\xA0\x80", u8"\xF4\x90\x80\x80",
+                                                     u8"\xF5\x80\x80\x80", u8"\xE2\x82", u8"\xF0\x9F\x98", u8"\x80", u8"\xFF", u8"\xC3\xA5\xA5" };
+        Broken = false;
+        for (const auto &Sequence : Malformed)
+        {
+            Broken |= UTF8::Internal::isValidscalar(Sequence);
+
+            for (size_t Position = 0; Position < 70 && !Broken; ++Position)
+            {
+                for (const auto &Background : { std::u8string(96, u8'x'), Text.substr(0, 96) })
+                {
+                    auto Input = Background;
+                    Input.replace(Position, Sequence.size(), Sequence);
+
+                    Broken |= !Validate(Input);
+                    Broken |= !Validate(std::u8string_view(Input).substr(0, Position + Sequence.size()));
+                }
+            }
+        }
+        if (Broken) std::printf("BROKEN: UTF8 SIMD validation (malformed)\n");
+
+        // ASCII runs and the 16 / 32-bit widening and narrowing.
+        const auto Check = []<typename T>(T)
+        {
+            for (size_t Size = 0; Size <= 80; ++Size)
+            {
+                std::u8string ASCII(Size, u8'\0');
+                for (size_t i = 0; i < Size; ++i) ASCII[i] = char8_t('A' + i % 26);
+
+                std::vector<T> Wide(Size + 1), Expected(Size + 1);
+                UTF8::Internal::Widen(ASCII.data(), Size, Wide.data());
+                for (size_t i = 0; i < Size; ++i) Expected[i] = T(ASCII[i]);
+                if (Wide != Expected) return false;
+
+                for (size_t Stop = 0; Stop <= Size; ++Stop)
+                {
+                    auto Mixed = ASCII; Mixed.insert(Stop, u8"\u00E5");
+                    if (UTF8::Internal::ASCIIprefix(Mixed.data(), Mixed.size()) != Stop) return false;
+
+                    auto Units = Expected; Units[Stop] = T(0xE5);
+                    std::u8string Narrowed(Size + 1, u8'\0');
+                    if (UTF8::Internal::Narrow(Units.data(), Size + 1, Narrowed.data()) != Stop) return false;
+                    if (std::u8string_view(Narrowed).substr(0, Stop) != std::u8string_view(ASCII).substr(0, Stop)) return false;
+                }
+            }
+
+            return true;
+        };
+        if (!Check(char16_t{}) || !Check(char32_t{})) std::printf("BROKEN: UTF8 SIMD widening / narrowing\n");
+
+        // And through the public API.
+        Broken = false;
+        for (size_t Offset = 0; Offset < 70 && !Broken; ++Offset)
+        {
+            for (size_t Size = 0; Size <= 80 && !Broken; ++Size)
+            {
+                const auto Slice = std::u8string_view(BMP).substr(Offset, Size);
+                if (!UTF8::Internal::isValidscalar(Slice) || Slice.empty()) continue;
+
+                Broken |= UTF8::strlen(Slice) != Scalarlength(Slice);
+                Broken |= Encoding::toUTF8(Encoding::toUNICODE(Slice)) != Slice;
+            }
+        }
+        if (Broken) std::printf("BROKEN: UTF8 SIMD conversion\n");
+    }
+    #endif
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // Mostly ASCII with some two, three and four byte sequences, like typical text.
+    inline void UTF8benchmark()
+    {
+        std::u8string Text{};
+        while (Text.size() < 64 * 1024) Text += u8"The quick brown fox jumps over the lazy dog, åäö, 日本語, 😀. ";
+        const auto Wide = Encoding::toUNICODE(Text);
+
+        Measure("UTF8::isValid (64 KiB)", Text.size(), [&]() { Keep(UTF8::isValid(Text)); });
+        Measure("UTF8::strlen (64 KiB)", Text.size(), [&]() { Keep(UTF8::strlen(Text)); });
+        Measure("Encoding::toUNICODE (UTF8 -> UTF16/32)", Text.size(), [&]() { Keep(Encoding::toUNICODE(Text)); });
+        Measure("Encoding::toUTF8 (UTF16/32 -> UTF8)", Text.size(), [&]() { Keep(Encoding::toUTF8(Wide)); });
+        Measure("Encoding::toASCII (UTF8 -> escaped)", Text.size(), [&]() { Keep(Encoding::toASCII(Text)); });
+    }
 }
 #endif
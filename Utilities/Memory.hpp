@@ -0,0 +1,10 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+*/
+
+#pragma once
+#include "Memory/Heap.hpp"
+#include "Memory/Arena.hpp"
+#include "Memory/Pool.hpp"
@@ -0,0 +1,249 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Monotonic arena for request-scoped work, allocation is a pointer bump and deallocation is a no-op.
+    Reset() drops everything at once but keeps the newest (largest) block, so a steady workload stops touching the heap.
+    Blocks freed by a rewind are kept as a spare for the next overflow, so repeated scopes don't go upstream either.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+#include "Heap.hpp"
+
+namespace Memory
+{
+    class Arena_t final : public std::pmr::memory_resource
+    {
+        // Header at the start of every block, newest first.
+        struct Block_t
+        {
+            Block_t *Next;
+            size_t Size;
+
+            [[nodiscard]] uint8_t *Begin() noexcept { return reinterpret_cast<uint8_t *>(this + 1); }
+            [[nodiscard]] uint8_t *End() noexcept { return reinterpret_cast<uint8_t *>(this) + Size; }
+        };
+
+        std::pmr::memory_resource *Parent;
+        Block_t *Head{}, *Spare{};
+        uint8_t *Cursor{}, *Limit{};
+        size_t Nextsize;
+
+        static constexpr size_t Maxblocksize = 64 * 1024 * 1024;
+
+        [[gnu::noinline]] void *Allocateslow(size_t Size, size_t Alignment)
+        {
+            const auto Needed = sizeof(Block_t) + Size + Alignment;
+
+            Block_t *Block;
+            if (Spare && Spare->Size >= Needed) Block = std::exchange(Spare, nullptr);
+            else
+            {
+                // Blocks double until the cap, oversized requests get a block of their own.
+                const auto Blocksize = std::max(Nextsize, Needed);
+                Nextsize = std::min(Nextsize * 2, Maxblocksize);
+
+                Block = static_cast<Block_t *>(Parent->allocate(Blocksize, alignof(std::max_align_t)));
+                Block->Size = Blocksize;
+            }
+
+            Block->Next = Head;
+
+            Head = Block;
+            Cursor = Block->Begin();
+            Limit = Block->End();
+
+            return do_allocate(Size, Alignment);
+        }
+
+        void Free(Block_t *Block) noexcept { Parent->deallocate(Block, Block->Size, alignof(std::max_align_t)); }
+
+        // Only the largest freed block is worth keeping around.
+        void Retire(Block_t *Block) noexcept
+        {
+            if (Spare && Spare->Size >= Block->Size) return Free(Block);
+            if (Spare) Free(Spare);
+            Spare = Block;
+        }
+        void Releaseafter(Block_t *Keep) noexcept
+        {
+            while (Head && Head != Keep)
+            {
+                const auto Next = Head->Next;
+                Retire(Head);
+                Head = Next;
+            }
+        }
+
+    protected:
+        void *do_allocate(size_t Size, size_t Alignment) override
+        {
+            const auto Aligned = (reinterpret_cast<uintptr_t>(Cursor) + (Alignment - 1)) & ~uintptr_t(Alignment - 1);
+            if (Cursor && Aligned + Size <= reinterpret_cast<uintptr_t>(Limit)) [[likely]]
+            {
+                Cursor = reinterpret_cast<uint8_t *>(Aligned + Size);
+                return reinterpret_cast<void *>(Aligned);
+            }
+
+            return Allocateslow(Size, Alignment);
+        }
+        void do_deallocate(void *, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override { return this == &Other; }
+
+    public:
+        // Where to rewind to, see Scope_t.
+        struct Marker_t { Block_t *Block; uint8_t *Cursor; };
+
+        explicit Arena_t(size_t Initialsize = 64 * 1024, std::pmr::memory_resource *Upstream = Memory::Upstream()) noexcept
+            : Parent(Upstream), Nextsize(std::max<size_t>(Initialsize, 1024)) {}
+
+        Arena_t(const Arena_t &) = delete;
+        Arena_t &operator=(const Arena_t &) = delete;
+        ~Arena_t() override { Release(); }
+
+        // Typed helper, the arena never runs destructors.
+        template <typename T, typename... Args> requires (std::is_trivially_destructible_v<T>) T *Create(Args&&... args)
+        {
+            return std::construct_at(static_cast<T *>(allocate(sizeof(T), alignof(T))), std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] Marker_t Mark() const noexcept { return { Head, Cursor }; }
+        void Rewind(const Marker_t &Marker) noexcept
+        {
+            Releaseafter(Marker.Block);
+            Cursor = Marker.Cursor;
+            Limit = Head ? Head->End() : nullptr;
+        }
+
+        // Everything allocated so far is invalid afterwards.
+        void Reset() noexcept
+        {
+            if (!Head) return;
+
+            const auto Keep = Head;
+            Head = Head->Next;
+            Releaseafter(nullptr);
+
+            Head = Keep;
+            Head->Next = nullptr;
+            Cursor = Head->Begin();
+            Limit = Head->End();
+        }
+        void Release() noexcept
+        {
+            Releaseafter(nullptr);
+            if (Spare) Free(std::exchange(Spare, nullptr));
+            Cursor = Limit = nullptr;
+        }
+
+        // Bytes handed out from the current block and reserved over all blocks, including the spare.
+        [[nodiscard]] size_t Used() const noexcept { return Head ? size_t(Cursor - Head->Begin()) : 0; }
+        [[nodiscard]] size_t Reserved() const noexcept
+        {
+            size_t Total = Spare ? Spare->Size : 0;
+            for (auto Block = Head; Block; Block = Block->Next) Total += Block->Size;
+            return Total;
+        }
+    };
+
+    // One per thread, for work that doesn't outlive the current request.
+    inline Arena_t &Localarena()
+    {
+        thread_local Arena_t Instance{};
+        return Instance;
+    }
+
+    // Everything allocated from the arena while in scope is released when it ends, scopes nest.
+    struct Scope_t
+    {
+        Arena_t &Arena;
+        Arena_t::Marker_t Marker;
+
+        explicit Scope_t(Arena_t &Target = Localarena()) noexcept : Arena(Target), Marker(Target.Mark()) {}
+        ~Scope_t() noexcept { Arena.Rewind(Marker); }
+
+        Scope_t(const Scope_t &) = delete;
+        Scope_t &operator=(const Scope_t &) = delete;
+    };
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Arenatest()
+    {
+        Memory::Arena_t Arena(1024);
+
+        // Alignment is honoured and small allocations are contiguous.
+        const auto A = static_cast<uint8_t *>(Arena.allocate(3, 1));
+        const auto B = static_cast<uint8_t *>(Arena.allocate(8, 8));
+        if (reinterpret_cast<uintptr_t>(B) % 8 != 0 || B - A > 16) std::printf("BROKEN: Arena alignment\n");
+
+        // Scopes rewind, including blocks that were added inside them.
+        const auto Before = Arena.Used();
+        {
+            Memory::Scope_t Scope(Arena);
+            for (size_t i = 0; i < 100; ++i) (void)Arena.allocate(1000, 16);
+            if (Arena.Reserved() < 100 * 1000) std::printf("BROKEN: Arena growth\n");
+        }
+        if (Arena.Used() != Before) std::printf("BROKEN: Arena scope\n");
+
+        // Repeated scopes reuse the spare rather than going upstream for ever larger blocks.
+        struct Counting_t final : std::pmr::memory_resource
+        {
+            size_t Calls{};
+            void *do_allocate(size_t Size, size_t Alignment) override { ++Calls; return std::pmr::new_delete_resource()->allocate(Size, Alignment); }
+            void do_deallocate(void *Pointer, size_t Size, size_t Alignment) override { std::pmr::new_delete_resource()->deallocate(Pointer, Size, Alignment); }
+            bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override { return this == &Other; }
+        } Counting{};
+        {
+            Memory::Arena_t Scoped(1024, &Counting);
+            (void)Scoped.allocate(16, 16);
+            for (size_t Round = 0; Round < 200; ++Round)
+            {
+                Memory::Scope_t Scope(Scoped);
+                for (size_t i = 0; i < 100; ++i) (void)Scoped.allocate(1000, 16);
+            }
+            if (Counting.Calls > 16 || Scoped.Reserved() > 512 * 1024) std::printf("BROKEN: Arena scope reuse\n");
+        }
+
+        // Containers through the polymorphic allocator.
+        std::pmr::vector<std::pmr::string> Strings(&Arena);
+        for (size_t i = 0; i < 100; ++i) Strings.emplace_back(std::string(50, char('a' + i % 26)));
+        if (Strings.size() != 100 || Strings[99] != std::pmr::string(50, 'v')) std::printf("BROKEN: Arena containers\n");
+
+        // Reset keeps the largest block, so the next round doesn't allocate.
+        Arena.Reset();
+        const auto Reserved = Arena.Reserved();
+        for (size_t i = 0; i < 10; ++i) (void)Arena.allocate(64, 8);
+        if (Arena.Used() != 640 || Arena.Reserved() != Reserved) std::printf("BROKEN: Arena reset\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // A request's worth of small allocations, released all at once.
+    inline void Arenabenchmark()
+    {
+        std::array<void *, 64> Blocks{};
+        Memory::Arena_t Arena{};
+
+        Measure("Memory::Arena_t 64 x 64B + Reset", 0, [&]()
+        {
+            for (auto &Block : Blocks) Block = Arena.allocate(64, 16);
+            Keep(Blocks);
+            Arena.Reset();
+        });
+        Measure("Memory::Malloc 64 x 64B + Free", 0, [&]()
+        {
+            for (auto &Block : Blocks) Block = Memory::Malloc(64);
+            Keep(Blocks);
+            for (const auto Block : Blocks) Memory::Free(Block);
+        });
+    }
+}
+#endif
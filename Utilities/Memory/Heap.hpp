@@ -0,0 +1,70 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    The general-purpose heap everything else falls back to, mimalloc when built with -DBETTER_MALLOC=ON.
+    Replacing global new/delete has to happen in exactly one translation unit, define MEMORY_OVERRIDE_NEW before including us there.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+
+#if defined (BETTER_MALLOC) && __has_include(<mimalloc.h>)
+#include <mimalloc.h>
+#define HAS_MIMALLOC
+
+#if defined (MEMORY_OVERRIDE_NEW)
+#include <mimalloc-new-delete.h>
+#endif
+#endif
+
+namespace Memory
+{
+    [[nodiscard]] inline void *Malloc(size_t Size) noexcept
+    {
+        #if defined (HAS_MIMALLOC)
+        return mi_malloc(Size);
+        #else
+        return std::malloc(Size);
+        #endif
+    }
+    [[nodiscard]] inline void *Realloc(void *Pointer, size_t Size) noexcept
+    {
+        #if defined (HAS_MIMALLOC)
+        return mi_realloc(Pointer, Size);
+        #else
+        return std::realloc(Pointer, Size);
+        #endif
+    }
+    inline void Free(void *Pointer) noexcept
+    {
+        #if defined (HAS_MIMALLOC)
+        mi_free(Pointer);
+        #else
+        std::free(Pointer);
+        #endif
+    }
+
+    // Where the arenas and pools get their blocks from.
+    inline std::pmr::memory_resource *Upstream() noexcept
+    {
+        #if defined (HAS_MIMALLOC)
+        struct Mimalloc_t final : std::pmr::memory_resource
+        {
+            void *do_allocate(size_t Size, size_t Alignment) override
+            {
+                const auto Pointer = mi_malloc_aligned(Size, Alignment);
+                if (!Pointer) [[unlikely]] throw std::bad_alloc();
+                return Pointer;
+            }
+            void do_deallocate(void *Pointer, size_t, size_t) override { mi_free(Pointer); }
+            bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override { return this == &Other; }
+        };
+        static Mimalloc_t Instance{};
+        return &Instance;
+        #else
+        return std::pmr::new_delete_resource();
+        #endif
+    }
+}
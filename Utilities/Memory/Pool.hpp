@@ -0,0 +1,271 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Size-class pool for small, short-lived allocations.
+    Every thread has its own free-lists so the common path is a pointer pop without atomics.
+    Lists that grow too long, or belong to an exiting thread, are pushed to a shared lock-free stack for other threads to take whole.
+    Slabs are never returned to the upstream, the pool is meant to live as long as the process.
+*/
+
+#pragma once
+#include <Stdinclude.hpp>
+#include "Heap.hpp"
+
+namespace Memory
+{
+    namespace Pool
+    {
+        // 16-byte steps up to 256, then powers of two up to 32 KiB.
+        constexpr size_t Smallstep = 16, Smalllimit = 256, Largelimit = 32 * 1024;
+        constexpr size_t Classcount = Smalllimit / Smallstep + std::countr_zero(Largelimit) - std::countr_zero(Smalllimit);
+        constexpr size_t Slabsize = 64 * 1024;
+
+        // Frees past this many per class since the last refill hand the thread's list to the shared stack.
+        constexpr uint32_t Localspill = 256;
+
+        constexpr size_t Classindex(size_t Size) noexcept
+        {
+            if (Size <= Smalllimit) return (std::max<size_t>(Size, 1) - 1) / Smallstep;
+            return Smalllimit / Smallstep + std::bit_width(Size - 1) - std::countr_zero(Smalllimit) - 1;
+        }
+        constexpr size_t Classsize(size_t Index) noexcept
+        {
+            if (Index < Smalllimit / Smallstep) return (Index + 1) * Smallstep;
+            return Smalllimit << (Index - Smalllimit / Smallstep + 1);
+        }
+        static_assert(Classindex(1) == 0 && Classindex(16) == 0 && Classindex(17) == 1 && Classindex(256) == 15 && Classindex(257) == 16);
+        static_assert(Classsize(Classindex(Largelimit)) == Largelimit && Classindex(Largelimit) == Classcount - 1);
+
+        namespace Internal
+        {
+            struct Node_t { Node_t *Next; };
+
+            // Producers CAS a whole chain on, consumers exchange the whole stack off, so there's no ABA to worry about.
+            struct alignas(64) Shared_t
+            {
+                std::atomic<Node_t *> Head{};
+
+                void Push(Node_t *First, Node_t *Last) noexcept
+                {
+                    auto Expected = Head.load(std::memory_order_relaxed);
+                    do { Last->Next = Expected; }
+                    while (!Head.compare_exchange_weak(Expected, First, std::memory_order_release, std::memory_order_relaxed));
+                }
+                [[nodiscard]] Node_t *Take() noexcept
+                {
+                    if (!Head.load(std::memory_order_relaxed)) return nullptr;
+                    return Head.exchange(nullptr, std::memory_order_acquire);
+                }
+            };
+            inline std::array<Shared_t, Classcount> &Shared()
+            {
+                static std::array<Shared_t, Classcount> Instance{};
+                return Instance;
+            }
+
+            inline std::atomic<size_t> Slabbytes{};
+
+            struct Cache_t
+            {
+                std::array<Node_t *, Classcount> Free{};
+                std::array<uint32_t, Classcount> Count{};
+
+                void Spill(size_t Index) noexcept
+                {
+                    const auto First = Free[Index];
+                    if (!First) return;
+
+                    auto Last = First;
+                    while (Last->Next) Last = Last->Next;
+
+                    Shared()[Index].Push(First, Last);
+                    Free[Index] = nullptr;
+                    Count[Index] = 0;
+                }
+
+                // Carve a slab into a chain, blocks are naturally aligned for power-of-two classes up to the page size.
+                [[gnu::noinline]] Node_t *Refill(size_t Index)
+                {
+                    if (const auto Chain = Shared()[Index].Take()) return Chain;
+
+                    const auto Blocksize = Classsize(Index);
+                    const auto Bytes = std::max(Slabsize, Blocksize * 8);
+                    const auto Alignment = std::has_single_bit(Blocksize) ? std::min<size_t>(Blocksize, 4096) : Smallstep;
+                    const auto Slab = static_cast<uint8_t *>(Upstream()->allocate(Bytes, Alignment));
+                    Slabbytes.fetch_add(Bytes, std::memory_order_relaxed);
+
+                    const auto Blocks = Bytes / Blocksize;
+                    for (size_t i = 0; i + 1 < Blocks; ++i)
+                        reinterpret_cast<Node_t *>(Slab + i * Blocksize)->Next = reinterpret_cast<Node_t *>(Slab + (i + 1) * Blocksize);
+                    reinterpret_cast<Node_t *>(Slab + (Blocks - 1) * Blocksize)->Next = nullptr;
+
+                    return reinterpret_cast<Node_t *>(Slab);
+                }
+
+                ~Cache_t() { for (size_t i = 0; i < Classcount; ++i) Spill(i); }
+            };
+            inline Cache_t &Local()
+            {
+                thread_local Cache_t Instance{};
+                return Instance;
+            }
+
+            // Over-aligned requests use a power-of-two class at least as large as the alignment.
+            constexpr size_t Effectivesize(size_t Size, size_t Alignment) noexcept
+            {
+                if (Alignment <= Smallstep) return Size;
+                return std::bit_ceil(std::max(Size, Alignment));
+            }
+        }
+
+        // Anything the pool doesn't handle goes straight to the upstream.
+        [[nodiscard]] inline void *Allocate(size_t Size, size_t Alignment = alignof(std::max_align_t))
+        {
+            const auto Effective = Internal::Effectivesize(Size, Alignment);
+            if (Effective > Largelimit || Alignment > 4096) [[unlikely]] return Upstream()->allocate(Size, Alignment);
+
+            const auto Index = Classindex(Effective);
+            auto &Cache = Internal::Local();
+
+            auto Node = Cache.Free[Index];
+            if (!Node) [[unlikely]]
+            {
+                Node = Cache.Refill(Index);
+                Cache.Count[Index] = 0;
+            }
+            else if (Cache.Count[Index]) --Cache.Count[Index];
+
+            Cache.Free[Index] = Node->Next;
+            return Node;
+        }
+
+        // Size and alignment must match the allocation, blocks may be freed from any thread.
+        inline void Deallocate(void *Pointer, size_t Size, size_t Alignment = alignof(std::max_align_t)) noexcept
+        {
+            const auto Effective = Internal::Effectivesize(Size, Alignment);
+            if (Effective > Largelimit || Alignment > 4096) [[unlikely]] return Upstream()->deallocate(Pointer, Size, Alignment);
+
+            const auto Index = Classindex(Effective);
+            auto &Cache = Internal::Local();
+
+            const auto Node = static_cast<Internal::Node_t *>(Pointer);
+            Node->Next = Cache.Free[Index];
+            Cache.Free[Index] = Node;
+
+            if (++Cache.Count[Index] > Localspill) [[unlikely]] Cache.Spill(Index);
+        }
+
+        // Total bytes taken from the upstream for slabs.
+        [[nodiscard]] inline size_t Reserved() noexcept { return Internal::Slabbytes.load(std::memory_order_relaxed); }
+    }
+
+    // The pool as a memory resource, all instances share the same per-thread caches.
+    class Pool_t final : public std::pmr::memory_resource
+    {
+    protected:
+        void *do_allocate(size_t Size, size_t Alignment) override { return Pool::Allocate(Size, Alignment); }
+        void do_deallocate(void *Pointer, size_t Size, size_t Alignment) override { Pool::Deallocate(Pointer, Size, Alignment); }
+        bool do_is_equal(const std::pmr::memory_resource &Other) const noexcept override { return this == &Other; }
+    };
+    inline Pool_t *Poolresource() noexcept
+    {
+        static Pool_t Instance{};
+        return &Instance;
+    }
+
+    // Stateless allocator for containers that take one as a template parameter.
+    template <typename T> struct Poolallocator_t
+    {
+        using value_type = T;
+
+        constexpr Poolallocator_t() noexcept = default;
+        template <typename U> constexpr Poolallocator_t(const Poolallocator_t<U> &) noexcept {}
+
+        [[nodiscard]] T *allocate(size_t Count) { return static_cast<T *>(Pool::Allocate(Count * sizeof(T), std::max(alignof(T), alignof(std::max_align_t)))); }
+        void deallocate(T *Pointer, size_t Count) noexcept { Pool::Deallocate(Pointer, Count * sizeof(T), std::max(alignof(T), alignof(std::max_align_t))); }
+
+        template <typename U> constexpr bool operator==(const Poolallocator_t<U> &) const noexcept { return true; }
+    };
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Pooltest()
+    {
+        // Freed blocks are reused by the same thread.
+        const auto A = Memory::Pool::Allocate(40);
+        Memory::Pool::Deallocate(A, 40);
+        if (Memory::Pool::Allocate(48) != A) std::printf("BROKEN: Pool reuse\n");
+        Memory::Pool::Deallocate(A, 48);
+
+        // Over-aligned and oversized requests.
+        const auto Aligned = Memory::Pool::Allocate(24, 256);
+        const auto Large = Memory::Pool::Allocate(100000);
+        if (reinterpret_cast<uintptr_t>(Aligned) % 256 != 0 || !Large) std::printf("BROKEN: Pool alignment\n");
+        Memory::Pool::Deallocate(Aligned, 24, 256);
+        Memory::Pool::Deallocate(Large, 100000);
+
+        // Blocks allocated on one thread and freed on others end up back in circulation.
+        std::vector<void *> Blocks(10000);
+        for (auto &Block : Blocks) { Block = Memory::Pool::Allocate(64); std::memset(Block, 0xAB, 64); }
+        const auto Reserved = Memory::Pool::Reserved();
+
+        {
+            std::vector<std::jthread> Threads{};
+            for (size_t t = 0; t < 4; ++t)
+                Threads.emplace_back([&, t]() { for (size_t i = t; i < Blocks.size(); i += 4) Memory::Pool::Deallocate(Blocks[i], 64); });
+        }
+        for (auto &Block : Blocks) Block = Memory::Pool::Allocate(64);
+        if (Memory::Pool::Reserved() != Reserved) std::printf("BROKEN: Pool cross-thread reuse\n");
+        for (const auto Block : Blocks) Memory::Pool::Deallocate(Block, 64);
+
+        // Through the allocator interfaces.
+        std::vector<std::string, Memory::Poolallocator_t<std::string>> Typed(100, "pooled");
+        std::pmr::vector<int> Polymorphic(1000, 7, Memory::Poolresource());
+        if (Typed.back() != "pooled" || Polymorphic.back() != 7) std::printf("BROKEN: Pool allocators\n");
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void Poolbenchmark()
+    {
+        std::array<void *, 64> Blocks{};
+
+        Measure("Memory::Pool 64 x 64B", 0, [&]()
+        {
+            for (auto &Block : Blocks) Block = Memory::Pool::Allocate(64);
+            Keep(Blocks);
+            for (const auto Block : Blocks) Memory::Pool::Deallocate(Block, 64);
+        });
+        Measure("Memory::Malloc 64 x 64B", 0, [&]()
+        {
+            for (auto &Block : Blocks) Block = Memory::Malloc(64);
+            Keep(Blocks);
+            for (const auto Block : Blocks) Memory::Free(Block);
+        });
+
+        // Allocate and free on every thread at once, the shared heap has to synchronize where the pool doesn't.
+        for (const size_t Threads : { 1, 4 })
+        {
+            Measurethreads("Memory::Pool 64B", Threads, 1'000'000, [](size_t)
+            {
+                const auto Block = Memory::Pool::Allocate(64);
+                Keep(Block);
+                Memory::Pool::Deallocate(Block, 64);
+            });
+            Measurethreads("Memory::Malloc 64B", Threads, 1'000'000, [](size_t)
+            {
+                const auto Block = Memory::Malloc(64);
+                Keep(Block);
+                Memory::Free(Block);
+            });
+        }
+    }
+}
+#endif
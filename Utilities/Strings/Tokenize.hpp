@@ -6,221 +6,299 @@
 
 #pragma once
 #include <vector>
+#include <ranges>
+#include <cstring>
+#include <cwchar>
 #include <string_view>
 
 namespace String
 {
-    // Standard commandline parsing.
-    constexpr std::vector<std::string_view> Tokenize(std::string_view Input)
+    namespace Internal
     {
-        std::vector<std::string_view> Tokens{};
-        bool Quoted{};
+        template <typename T> concept Unit_t = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t>;
 
-        while (!Input.empty())
+        // memchr is vectorized by every CRT we care about.
+        template <Unit_t T> constexpr size_t Find(std::basic_string_view<T> Input, T Needle)
         {
-            const auto P1 = Input.find('\"');
-            const auto P2 = Input.find(' ');
-
-            if (Quoted)
-            {
-                // Malformed quote-sequence, stop parsing.
-                if (P1 == std::string_view::npos) [[unlikely]]
-                    return Tokens;
-
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = false;
-            }
-            else
+            if (!std::is_constant_evaluated())
             {
-                if (P2 < P1)
+                if constexpr (sizeof(T) == 1)
                 {
-                    if (P2) Tokens.emplace_back(Input.substr(0, P2));
-                    Input.remove_prefix(P2 + 1);
-                }
-                else if (P1 != std::string_view::npos)
-                {
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = true;
+                    const auto Result = (const T *)std::memchr(Input.data(), int(uint8_t(Needle)), Input.size());
+                    return Result ? size_t(Result - Input.data()) : std::basic_string_view<T>::npos;
                 }
                 else
                 {
-                    break;
+                    const auto Result = (const T *)std::wmemchr(Input.data(), Needle, Input.size());
+                    return Result ? size_t(Result - Input.data()) : std::basic_string_view<T>::npos;
                 }
             }
-        }
-
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
-
-        return Tokens;
-    }
-    constexpr std::vector<std::wstring_view> Tokenize(std::wstring_view Input)
-    {
-        std::vector<std::wstring_view> Tokens{};
-        bool Quoted{};
 
-        while (!Input.empty())
+            return Input.find(Needle);
+        }
+        template <Unit_t T> constexpr size_t Find(std::basic_string_view<T> Input, std::basic_string_view<T> Needle)
         {
-            const auto P1 = Input.find(L'\"');
-            const auto P2 = Input.find(L' ');
+            if (Needle.size() == 1) return Find(Input, Needle[0]);
+            if (Needle.empty() || Needle.size() > Input.size()) return std::basic_string_view<T>::npos;
 
-            if (Quoted)
+            // Scan for the first unit, then verify the rest.
+            for (size_t Offset = 0; Offset + Needle.size() <= Input.size(); ++Offset)
             {
-                // Malformed quote-sequence, stop parsing.
-                if (P1 == std::wstring_view::npos) [[unlikely]]
-                    return Tokens;
+                const auto Candidate = Find(Input.substr(Offset, Input.size() - Offset - Needle.size() + 1), Needle[0]);
+                if (Candidate == std::basic_string_view<T>::npos) break;
 
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = false;
+                Offset += Candidate;
+                if (Input.substr(Offset + 1, Needle.size() - 1) == Needle.substr(1)) return Offset;
             }
-            else
+
+            return std::basic_string_view<T>::npos;
+        }
+
+        // First occurrence of either unit.
+        template <Unit_t T> constexpr size_t Findeither(std::basic_string_view<T> Input, T A, T B)
+        {
+            size_t Offset = 0;
+
+            #if defined(HAS_CPUID)
+            if constexpr (sizeof(T) == 1)
             {
-                if (P2 < P1)
-                {
-                    if (P2) Tokens.emplace_back(Input.substr(0, P2));
-                    Input.remove_prefix(P2 + 1);
-                }
-                else if (P1 != std::wstring_view::npos)
-                {
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = true;
-                }
-                else
+                if (!std::is_constant_evaluated())
                 {
-                    break;
+                    const auto Data = (const uint8_t *)Input.data();
+                    const auto VA = _mm_set1_epi8(char(A)), VB = _mm_set1_epi8(char(B));
+
+                    for (; Offset + 16 <= Input.size(); Offset += 16)
+                    {
+                        const auto Block = _mm_loadu_si128((const __m128i *)(Data + Offset));
+                        const auto Mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(Block, VA), _mm_cmpeq_epi8(Block, VB)));
+                        if (Mask) return Offset + std::countr_zero(uint32_t(Mask));
+                    }
                 }
             }
-        }
+            #endif
 
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
+            for (; Offset < Input.size(); ++Offset)
+                if (Input[Offset] == A || Input[Offset] == B)
+                    return Offset;
 
-        return Tokens;
+            return std::basic_string_view<T>::npos;
+        }
     }
-    constexpr std::vector<std::u8string_view> Tokenize(std::u8string_view Input)
+
+    // Lazy version of Split, tokens of length 0 are dropped unless PreserveNULL = true.
+    template <Internal::Unit_t T> class Splitview_t : public std::ranges::view_interface<Splitview_t<T>>
     {
-        std::vector<std::u8string_view> Tokens{};
-        bool Quoted{};
+        std::basic_string_view<T> Input{}, External{};
+        bool PreserveNULL{}, isSingle{};
+        T Single{};
+
+        constexpr std::basic_string_view<T> Needle() const noexcept { return isSingle ? std::basic_string_view<T>{ &Single, 1 } : External; }
 
-        while (!Input.empty())
+    public:
+        class Iterator_t
         {
-            const auto P1 = Input.find('\"');
-            const auto P2 = Input.find(' ');
+            const Splitview_t *Parent{};
+            std::basic_string_view<T> Remaining{}, Current{};
+            bool Atend{ true };
 
-            if (Quoted)
+            constexpr void Advance()
             {
-                // Malformed quote-sequence, stop parsing.
-                if (P1 == std::string_view::npos) [[unlikely]]
-                    return Tokens;
+                const auto Needle = Parent->Needle();
 
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = false;
-            }
-            else
-            {
-                if (P2 < P1)
-                {
-                    if (P2) Tokens.emplace_back(Input.substr(0, P2));
-                    Input.remove_prefix(P2 + 1);
-                }
-                else if (P1 != std::string_view::npos)
-                {
-                    if (P1) Tokens.emplace_back(Input.substr(0, P1));
-                    Input.remove_prefix(P1 + 1);
-                    Quoted = true;
-                }
-                else
+                while (!Remaining.empty())
                 {
-                    break;
+                    const auto Length = Internal::Find(Remaining, Needle);
+
+                    // Any remaining.
+                    if (Length == std::basic_string_view<T>::npos || Needle.empty())
+                    {
+                        Current = Remaining;
+                        Remaining = {};
+                        return;
+                    }
+
+                    const auto Token = Remaining.substr(0, Length);
+                    Remaining.remove_prefix(Length + Needle.size());
+
+                    if (Parent->PreserveNULL || Length)
+                    {
+                        Current = Token;
+                        return;
+                    }
                 }
+
+                Atend = true;
             }
-        }
 
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using value_type = std::basic_string_view<T>;
+            using difference_type = std::ptrdiff_t;
 
-        return Tokens;
-    }
+            constexpr Iterator_t() = default;
+            constexpr Iterator_t(const Splitview_t *View) : Parent(View), Remaining(View->Input), Atend(false) { Advance(); }
 
-    // Tokens of length 0 are dropped unless PreserveNULL = true.
-    constexpr std::vector<std::string_view> Split(std::string_view Input, std::string_view Needle, bool PreserveNULL = false)
-    {
-        std::vector<std::string_view> Tokens{};
+            constexpr value_type operator*() const noexcept { return Current; }
+            constexpr Iterator_t &operator++() { Advance(); return *this; }
+            constexpr Iterator_t operator++(int) { auto Copy = *this; Advance(); return Copy; }
 
-        while (!Input.empty())
-        {
-            const auto Length = Input.find(Needle);
-            if (Length == std::string_view::npos) break;
+            constexpr bool operator==(std::default_sentinel_t) const noexcept { return Atend; }
+            constexpr bool operator==(const Iterator_t &Right) const noexcept
+            {
+                if (Atend || Right.Atend) return Atend == Right.Atend;
+                return Current.data() == Right.Current.data() && Remaining.data() == Right.Remaining.data();
+            }
+        };
 
-            if (PreserveNULL || Length) Tokens.emplace_back(Input.substr(0, Length));
-            Input.remove_prefix(Length + Needle.size());
-        }
+        constexpr Splitview_t() = default;
+        constexpr Splitview_t(std::basic_string_view<T> Input, std::basic_string_view<T> Needle, bool PreserveNULL = false) : Input(Input), External(Needle), PreserveNULL(PreserveNULL) {}
+        constexpr Splitview_t(std::basic_string_view<T> Input, T Needle, bool PreserveNULL = false) : Input(Input), PreserveNULL(PreserveNULL), isSingle(true), Single(Needle) {}
 
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
+        // The iterators refer back to the view, so it must outlive them.
+        constexpr Iterator_t begin() const { return Iterator_t(this); }
+        constexpr std::default_sentinel_t end() const noexcept { return {}; }
+    };
 
-        return Tokens;
-    }
-    constexpr std::vector<std::wstring_view> Split(std::wstring_view Input, std::wstring_view Needle, bool PreserveNULL = false)
+    // Lazy version of Tokenize, splits on ' ' and ", dropping anything in between.
+    template <Internal::Unit_t T> class Tokenizeview_t : public std::ranges::view_interface<Tokenizeview_t<T>>
     {
-        std::vector<std::wstring_view> Tokens{};
+        std::basic_string_view<T> Input{};
 
-        while (!Input.empty())
+    public:
+        class Iterator_t
         {
-            const auto Length = Input.find(Needle);
-            if (Length == std::wstring_view::npos) break;
+            std::basic_string_view<T> Remaining{}, Current{};
+            bool Atend{ true }, Quoted{};
 
-            if (PreserveNULL || Length) Tokens.emplace_back(Input.substr(0, Length));
-            Input.remove_prefix(Length + Needle.size());
-        }
+            constexpr void Advance()
+            {
+                while (!Remaining.empty())
+                {
+                    if (Quoted)
+                    {
+                        const auto P1 = Internal::Find(Remaining, T('\"'));
+
+                        // Malformed quote-sequence, stop parsing.
+                        if (P1 == std::basic_string_view<T>::npos) [[unlikely]] break;
+
+                        const auto Token = Remaining.substr(0, P1);
+                        Remaining.remove_prefix(P1 + 1);
+                        Quoted = false;
+
+                        if (P1) { Current = Token; return; }
+                    }
+                    else
+                    {
+                        const auto Point = Internal::Findeither(Remaining, T(' '), T('\"'));
+
+                        // Any remaining.
+                        if (Point == std::basic_string_view<T>::npos)
+                        {
+                            Current = Remaining;
+                            Remaining = {};
+                            return;
+                        }
+
+                        const auto Token = Remaining.substr(0, Point);
+                        Quoted = Remaining[Point] == T('\"');
+                        Remaining.remove_prefix(Point + 1);
+
+                        if (Point) { Current = Token; return; }
+                    }
+                }
+
+                Atend = true;
+            }
 
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using value_type = std::basic_string_view<T>;
+            using difference_type = std::ptrdiff_t;
 
-        return Tokens;
-    }
-    constexpr std::vector<std::u8string_view> Split(std::u8string_view Input, std::u8string_view Needle, bool PreserveNULL = false)
-    {
-        std::vector<std::u8string_view> Tokens{};
+            constexpr Iterator_t() = default;
+            constexpr Iterator_t(std::basic_string_view<T> Input) : Remaining(Input), Atend(false) { Advance(); }
 
-        while (!Input.empty())
-        {
-            const auto Length = Input.find(Needle);
-            if (Length == std::string_view::npos) break;
+            constexpr value_type operator*() const noexcept { return Current; }
+            constexpr Iterator_t &operator++() { Advance(); return *this; }
+            constexpr Iterator_t operator++(int) { auto Copy = *this; Advance(); return Copy; }
+
+            constexpr bool operator==(std::default_sentinel_t) const noexcept { return Atend; }
+            constexpr bool operator==(const Iterator_t &Right) const noexcept
+            {
+                if (Atend || Right.Atend) return Atend == Right.Atend;
+                return Current.data() == Right.Current.data() && Remaining.data() == Right.Remaining.data();
+            }
+        };
+
+        constexpr Tokenizeview_t() = default;
+        constexpr Tokenizeview_t(std::basic_string_view<T> Input) : Input(Input) {}
 
-            if (PreserveNULL || Length) Tokens.emplace_back(Input.substr(0, Length));
-            Input.remove_prefix(Length + Needle.size());
+        constexpr Iterator_t begin() const { return Iterator_t(Input); }
+        constexpr std::default_sentinel_t end() const noexcept { return {}; }
+    };
+
+    namespace Internal
+    {
+        template <typename View> constexpr auto Collect(const View &Range)
+        {
+            std::vector<std::ranges::range_value_t<View>> Tokens{};
+            for (const auto &Token : Range) Tokens.emplace_back(Token);
+            return Tokens;
         }
+    }
+
+    // Overloads so that literals deduce the right type.
+    constexpr Splitview_t<char> SplitView(std::string_view Input, std::string_view Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
+    constexpr Splitview_t<wchar_t> SplitView(std::wstring_view Input, std::wstring_view Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
+    constexpr Splitview_t<char8_t> SplitView(std::u8string_view Input, std::u8string_view Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
+    constexpr Splitview_t<char> SplitView(std::string_view Input, char Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
+    constexpr Splitview_t<wchar_t> SplitView(std::wstring_view Input, wchar_t Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
+    constexpr Splitview_t<char8_t> SplitView(std::u8string_view Input, char8_t Needle, bool PreserveNULL = false) { return { Input, Needle, PreserveNULL }; }
 
-        // Any remaining.
-        if (!Input.empty())
-            Tokens.emplace_back(Input);
+    constexpr Tokenizeview_t<char> TokenizeView(std::string_view Input) { return { Input }; }
+    constexpr Tokenizeview_t<wchar_t> TokenizeView(std::wstring_view Input) { return { Input }; }
+    constexpr Tokenizeview_t<char8_t> TokenizeView(std::u8string_view Input) { return { Input }; }
 
-        return Tokens;
+    // Standard commandline parsing.
+    constexpr std::vector<std::string_view> Tokenize(std::string_view Input)
+    {
+        return Internal::Collect(TokenizeView(Input));
+    }
+    constexpr std::vector<std::wstring_view> Tokenize(std::wstring_view Input)
+    {
+        return Internal::Collect(TokenizeView(Input));
+    }
+    constexpr std::vector<std::u8string_view> Tokenize(std::u8string_view Input)
+    {
+        return Internal::Collect(TokenizeView(Input));
+    }
+
+    // Tokens of length 0 are dropped unless PreserveNULL = true.
+    constexpr std::vector<std::string_view> Split(std::string_view Input, std::string_view Needle, bool PreserveNULL = false)
+    {
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
+    }
+    constexpr std::vector<std::wstring_view> Split(std::wstring_view Input, std::wstring_view Needle, bool PreserveNULL = false)
+    {
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
+    }
+    constexpr std::vector<std::u8string_view> Split(std::u8string_view Input, std::u8string_view Needle, bool PreserveNULL = false)
+    {
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
     }
 
     // Common overloads.
     constexpr std::vector<std::string_view> Split(std::string_view Input, char Needle, bool PreserveNULL = false)
     {
-        return Split(Input, std::string_view{ &Needle, 1 }, PreserveNULL);
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
     }
     constexpr std::vector<std::wstring_view> Split(std::wstring_view Input, wchar_t Needle, bool PreserveNULL = false)
     {
-        return Split(Input, std::wstring_view{ &Needle, 1 }, PreserveNULL);
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
     }
     constexpr std::vector<std::u8string_view> Split(std::u8string_view Input, char8_t Needle, bool PreserveNULL = false)
     {
-        return Split(Input, std::u8string_view{ &Needle, 1 }, PreserveNULL);
+        return Internal::Collect(SplitView(Input, Needle, PreserveNULL));
     }
 }
 
@@ -241,5 +319,30 @@ namespace Unittests
     static_assert(3 == String::Tokenize(R"(a "b c "    "" d)").size(), "BROKEN: String::Tokenize(A)");
     static_assert(3 == String::Tokenize(LR"(a "b c "    "" d)").size(), "BROKEN: String::Tokenize(W)");
     static_assert(3 == String::Tokenize(u8R"(a "b c "    "" d)").size(), "BROKEN: String::Tokenize(U8)");
+
+    // The lazy views.
+    static_assert(std::ranges::forward_range<String::Splitview_t<char>> && std::ranges::view<String::Tokenizeview_t<char>>, "BROKEN: String::SplitView");
+    static_assert(4 == std::ranges::distance(String::SplitView("ab,c,,,,,d,e", ',')), "BROKEN: String::SplitView(A)");
+    static_assert(3 == std::ranges::distance(String::SplitView(u8"ab::c::::d", u8"::")), "BROKEN: String::SplitView(U8)");
+    static_assert(*std::ranges::next(String::SplitView(L"ab,c,,d", L',', true).begin(), 2) == L"", "BROKEN: String::SplitView(W)");
+    static_assert(*std::ranges::next(String::TokenizeView(R"(a "b c "    "" d)").begin()) == "b c ", "BROKEN: String::TokenizeView(A)");
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // A CSV-ish line and a command line, both long enough that allocation isn't everything.
+    inline void Tokenizebenchmark()
+    {
+        std::string CSV{}, Commandline{};
+        for (size_t i = 0; i < 4096; ++i) CSV += std::to_string(i * 2654435761ULL % 100000) + ',';
+        for (size_t i = 0; i < 1024; ++i) Commandline += (i % 5) ? "--flag=value " : R"("quoted arg" )";
+
+        Measure("String::Split (char)", CSV.size(), [&]() { Keep(String::Split(CSV, ',')); });
+        Measure("String::Split (string)", CSV.size(), [&]() { Keep(String::Split(CSV, ","sv)); });
+        Measure("String::SplitView (count)", CSV.size(), [&]() { Keep(std::ranges::distance(String::SplitView(CSV, ','))); });
+        Measure("String::Tokenize", Commandline.size(), [&]() { Keep(String::Tokenize(Commandline)); });
+    }
 }
 #endif
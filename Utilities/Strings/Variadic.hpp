@@ -16,24 +16,197 @@ template <String_t T> constexpr decltype(auto) Forward(const T &Arg) { return Ar
 template <typename T> constexpr decltype(auto) Forward(T &&Arg) { static_assert(!cmp::isDerived<T, std::basic_string_view>); return Arg; }
 template <typename T> constexpr decltype(auto) Forward(const T &Arg) { static_assert(!cmp::isDerived<T, std::basic_string_view>); return Arg; }
 
-template <typename ...Args> [[nodiscard]] std::string va_impl(const char *Format, const Args& ...args)
+// Not constexpr, so reaching it while validating a format fails the build with the message in the diagnostic.
+inline void va_error(const char *) {}
+
+// printf-style format string validated against the argument types at compile-time.
+template <typename Char, typename ...Args> struct Basicformat_t
 {
-    const auto Size = std::snprintf(nullptr, 0, Format, args...);
-    std::string Buffer(Size, '\0');
+    const Char *String;
 
-    std::snprintf(Buffer.data(), Size + 1, Format, args...);
-    return Buffer;
+    template <typename T> requires std::is_convertible_v<const T &, const Char *>
+    consteval Basicformat_t(const T &Format) : String(Format)
+    {
+        Validate(std::basic_string_view<Char>(String));
+    }
+
+private:
+    // 'i'nteger, 'f'loat, 's'tring, 'w'ide string, 'p'ointer or '?' for anything printf can't take.
+    template <typename T> static consteval char Category()
+    {
+        using Type = std::decay_t<T>;
+
+        if constexpr (String_t<Type>) return std::is_same_v<typename Type::value_type, wchar_t> ? 'w' : 's';
+        else if constexpr (std::is_pointer_v<Type>)
+        {
+            using Pointee = std::remove_cv_t<std::remove_pointer_t<Type>>;
+            if constexpr (std::is_same_v<Pointee, char> || std::is_same_v<Pointee, char8_t>) return 's';
+            else if constexpr (std::is_same_v<Pointee, wchar_t>) return 'w';
+            else return 'p';
+        }
+        else if constexpr (std::is_null_pointer_v<Type>) return 'p';
+        else if constexpr (std::is_integral_v<Type> || std::is_enum_v<Type>) return 'i';
+        else if constexpr (std::is_floating_point_v<Type>) return 'f';
+        else return '?';
+    }
+
+    static consteval void Validate(std::basic_string_view<Char> Format)
+    {
+        constexpr std::array<char, sizeof...(Args) + 1> Kinds{ Category<Args>()..., '\0' };
+        constexpr std::array<size_t, sizeof...(Args) + 1> Sizes{ sizeof(std::decay_t<Args>)..., 0 };
+        size_t Next{};
+
+        // Length 0 means anything that promotes to int / double.
+        const auto Consume = [&](char Kind, size_t Length)
+        {
+            if (Next >= sizeof...(Args)) return va_error("va: too few arguments for the format");
+
+            const auto Actual = Kinds[Next];
+            if (Kind == 'p' && (Actual == 'p' || Actual == 's' || Actual == 'w')) { ++Next; return; }
+            if (Kind != Actual) return va_error("va: argument type does not match the conversion");
+
+            if (Kind == 'i' && (Length ? Sizes[Next] != Length : Sizes[Next] > sizeof(int)))
+                return va_error("va: integer size does not match the length modifier");
+            if (Kind == 'f' && (Length ? Sizes[Next] != Length : Sizes[Next] > sizeof(double)))
+                return va_error("va: floating point size does not match the length modifier");
+
+            ++Next;
+        };
+        const auto Digits = [&](size_t &i) { while (i < Format.size() && Format[i] >= '0' && Format[i] <= '9') ++i; };
+
+        for (size_t i = 0; i < Format.size(); ++i)
+        {
+            if (Format[i] != '%') continue;
+            if (++i == Format.size()) return va_error("va: format ends with a lone %");
+            if (Format[i] == '%') continue;
+
+            // Flags.
+            while (i < Format.size() && (Format[i] == '-' || Format[i] == '+' || Format[i] == ' ' || Format[i] == '#' || Format[i] == '0')) ++i;
+
+            // Width and precision, either inline or as an int argument.
+            if (i < Format.size() && Format[i] == '*') { Consume('i', 0); ++i; }
+            else Digits(i);
+
+            if (i < Format.size() && Format[i] == '.')
+            {
+                if (++i < Format.size() && Format[i] == '*') { Consume('i', 0); ++i; }
+                else Digits(i);
+            }
+
+            // Length modifiers.
+            size_t Length{};
+            bool Wide{};
+            if (i + 1 < Format.size() && Format[i] == 'h' && Format[i + 1] == 'h') i += 2;
+            else if (i + 1 < Format.size() && Format[i] == 'l' && Format[i + 1] == 'l') { Length = sizeof(long long); i += 2; }
+            else if (i < Format.size())
+            {
+                switch (Format[i])
+                {
+                    case 'h': ++i; break;
+                    case 'l': Length = sizeof(long); Wide = true; ++i; break;
+                    case 'j': Length = sizeof(intmax_t); ++i; break;
+                    case 'z': Length = sizeof(size_t); ++i; break;
+                    case 't': Length = sizeof(ptrdiff_t); ++i; break;
+                    case 'L': Length = sizeof(long double); ++i; break;
+                    default: break;
+                }
+            }
+
+            if (i == Format.size()) return va_error("va: format ends inside a conversion");
+            switch (Format[i])
+            {
+                case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                    Consume('i', Length); break;
+
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    // %lf is accepted as plain double.
+                    Consume('f', Wide ? 0 : Length); break;
+
+                case 's': Consume(Wide ? 'w' : 's', 0); break;
+                case 'p': Consume('p', 0); break;
+
+                case 'n': return va_error("va: %n is not supported");
+                default: return va_error("va: unknown conversion specifier");
+            }
+        }
+
+        if (Next != sizeof...(Args)) va_error("va: too many arguments for the format");
+    }
+};
+template <typename ...Args> using Format_t = Basicformat_t<char, std::type_identity_t<Args>...>;
+template <typename ...Args> using Format8_t = Basicformat_t<char8_t, std::type_identity_t<Args>...>;
+
+// Formats into the callers buffer in a single pass, output is truncated to fit.
+template <typename ...Args> std::string_view va_to(std::span<char> Buffer, Format_t<Args...> Format, const Args& ...args)
+{
+    if (Buffer.empty()) [[unlikely]] return {};
+
+    const auto Size = std::snprintf(Buffer.data(), Buffer.size(), Format.String, Forward<Args>(args)...);
+    return { Buffer.data(), Size < 0 ? 0 : std::min(size_t(Size), Buffer.size() - 1) };
 }
-template <typename ...Args> [[nodiscard]] std::string va(const std::string &Format, const Args& ...args)
+
+// Formats into a thread-local buffer that is reused by the next call on the same thread.
+template <typename ...Args> std::string_view va_impl(const char *Format, const Args& ...args)
 {
-    return va_impl(Format.c_str(), Forward<Args>(args)...);
+    thread_local std::string Buffer(512, '\0');
+
+    // Only measured twice when the buffer needs to grow.
+    auto Size = std::snprintf(Buffer.data(), Buffer.size() + 1, Format, args...);
+    if (Size > 0 && size_t(Size) > Buffer.size()) [[unlikely]]
+    {
+        Buffer.resize(Size);
+        Size = std::snprintf(Buffer.data(), Buffer.size() + 1, Format, args...);
+    }
+
+    return { Buffer.data(), size_t(std::max(Size, 0)) };
+}
+// Non-owning, the view is only valid until the next va / va_view call on the same thread.
+template <typename ...Args> [[nodiscard]] std::string_view va_view(Format_t<Args...> Format, const Args& ...args)
+{
+    return va_impl(Format.String, Forward<Args>(args)...);
+}
+template <typename ...Args> [[nodiscard]] std::u8string_view va_view(Format8_t<Args...> Format, const Args& ...args)
+{
+    const auto Result = va_impl((const char *)Format.String, Forward<Args>(args)...);
+    return { (const char8_t *)Result.data(), Result.size() };
+}
+
+// Owning versions, literal formats are checked while runtime ones are passed on as-is.
+template <typename ...Args> [[nodiscard]] std::string va(Format_t<Args...> Format, const Args& ...args)
+{
+    return std::string(va_impl(Format.String, Forward<Args>(args)...));
+}
+template <typename ...Args> [[nodiscard]] std::u8string va(Format8_t<Args...> Format, const Args& ...args)
+{
+    const auto Result = va_impl((const char *)Format.String, Forward<Args>(args)...);
+    return std::u8string((const char8_t *)Result.data(), Result.size());
+}
+template <String_t T, typename ...Args> requires std::is_same_v<typename T::value_type, char> [[nodiscard]] std::string va(const T &Format, const Args& ...args)
+{
+    return std::string(va_impl(Format.c_str(), Forward<Args>(args)...));
 }
-template <typename ...Args> [[nodiscard]] std::u8string va(const std::u8string &Format, const Args& ...args)
+template <String_t T, typename ...Args> requires std::is_same_v<typename T::value_type, char8_t> [[nodiscard]] std::u8string va(const T &Format, const Args& ...args)
 {
-    if (Encoding::isASCII(Format)) return va_impl((const char *)Format.c_str(), Forward<Args>(args)...);
+    // UTF8 is passed through by printf, so only the escaped form needs converting.
+    if (Encoding::isASCII(Format))
+    {
+        const auto Result = va_impl((const char *)Format.c_str(), Forward<Args>(args)...);
+        return std::u8string((const char8_t *)Result.data(), Result.size());
+    }
 
     const auto Encoded = Encoding::toASCII(Format);
-    return va_impl(Encoded.c_str(), Forward<Args>(args)...);
+    const auto Result = va_impl(Encoded.c_str(), Forward<Args>(args)...);
+    return std::u8string((const char8_t *)Result.data(), Result.size());
+}
+
+// Formats that are only known at runtime, these are not validated so the caller vouches for them.
+template <typename ...Args> [[nodiscard]] std::string va_runtime(std::string_view Format, const Args& ...args)
+{
+    return va(std::string(Format), args...);
+}
+template <typename ...Args> [[nodiscard]] std::u8string va_runtime(std::u8string_view Format, const Args& ...args)
+{
+    return va(std::u8string(Format), args...);
 }
 
 #if defined (_WIN32)
@@ -58,4 +231,25 @@ template <typename ...Args> [[nodiscard]] std::wstring va(const std::wstring &Fo
     return Encoding::toUNICODE(va(Encoding::toASCII(Format), Forward<Args>(args)...));
 }
 
-#endif
\ No newline at end of file
+#endif
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Variadictest()
+    {
+        if (va("%s %u %05.2f %llu", "a"s, 7u, 3.14159, uint64_t(1) << 40) != "a 7 03.14 1099511627776")
+            std::printf("BROKEN: va formatting\n");
+
+        // Larger than the initial thread-local buffer.
+        if (va_view("%*d", 2000, 1).size() != 2000) std::printf("BROKEN: va_view growth\n");
+
+        std::array<char, 8> Small{};
+        if (va_to(Small, "%s", "truncated") != "truncat") std::printf("BROKEN: va_to truncation\n");
+
+        const std::string_view Runtime = "%d-%s";
+        if (va_runtime(Runtime.substr(0, 2), 42) != "42" || va_runtime(Runtime, 1, "x") != "1-x") std::printf("BROKEN: va runtime format\n");
+        if (va(u8"%s = %d", u8"ÅÄÖ"s, 1) != u8"ÅÄÖ = 1") std::printf("BROKEN: va UTF8\n");
+    }
+}
+#endif
@@ -9,124 +9,300 @@
 
 namespace String
 {
-    template <typename T, size_t N> constexpr std::string toHex(const std::array<T, N> &Input, bool Spaced = false)
+    namespace Internal
     {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
-        std::string Output{}; Output.reserve(sizeof(T) * Input.size() * (2 + (Spaced ? 1 : 0)));
+        constexpr std::array<char, 16> Lowercase{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+        constexpr std::array<char, 16> Uppercase{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
 
-        for (const auto &Item : Input)
+        // 0xFF for anything that isn't [0-9a-fA-F].
+        constexpr uint8_t Nibble(char Item)
         {
-            const auto Bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(Item);
-            for (const auto Byte : Bytes)
+            if (Item >= '0' && Item <= '9') return uint8_t(Item - '0');
+            if (Item >= 'a' && Item <= 'f') return uint8_t(Item - 'a' + 10);
+            if (Item >= 'A' && Item <= 'F') return uint8_t(Item - 'A' + 10);
+            return 0xFF;
+        }
+
+        #if defined(HAS_CPUID)
+        // Each nibble indexes the alphabet via pshufb, then the halves are interleaved.
+        inline size_t Encodehex(const uint8_t *Input, size_t Size, char *Output, const std::array<char, 16> &Mapping)
+        {
+            size_t Offset = 0;
+
+            if (CPUID::hasAVX2())
             {
-                Output += Mapping[(uint8_t(Byte) & 0xF0) >> 4];
-                Output += Mapping[uint8_t(Byte) & 0x0F];
-                if (Spaced) Output += ' ';
+                const auto Table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)Mapping.data()));
+                const auto Mask = _mm256_set1_epi8(0x0F);
+
+                for (; Offset + 32 <= Size; Offset += 32)
+                {
+                    const auto Block = _mm256_loadu_si256((const __m256i *)(Input + Offset));
+                    const auto High = _mm256_shuffle_epi8(Table, _mm256_and_si256(_mm256_srli_epi16(Block, 4), Mask));
+                    const auto Low = _mm256_shuffle_epi8(Table, _mm256_and_si256(Block, Mask));
+
+                    // Unpacking works per lane, so swap the middle halves back.
+                    const auto A = _mm256_unpacklo_epi8(High, Low), B = _mm256_unpackhi_epi8(High, Low);
+                    _mm256_storeu_si256((__m256i *)(Output + Offset * 2), _mm256_permute2x128_si256(A, B, 0x20));
+                    _mm256_storeu_si256((__m256i *)(Output + Offset * 2 + 32), _mm256_permute2x128_si256(A, B, 0x31));
+                }
             }
-        }
 
-        while (Output.back() == ' ')
-            Output.pop_back();
+            if (CPUID::hasSSSE3())
+            {
+                const auto Table = _mm_loadu_si128((const __m128i *)Mapping.data());
+                const auto Mask = _mm_set1_epi8(0x0F);
 
-        return Output;
-    }
-    template <typename T, size_t N> constexpr std::string toHEX(const std::array<T, N> &Input, bool Spaced = false)
-    {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-        std::string Output{}; Output.reserve(sizeof(T) * Input.size() * (2 + (Spaced ? 1 : 0)));
+                for (; Offset + 16 <= Size; Offset += 16)
+                {
+                    const auto Block = _mm_loadu_si128((const __m128i *)(Input + Offset));
+                    const auto High = _mm_shuffle_epi8(Table, _mm_and_si128(_mm_srli_epi16(Block, 4), Mask));
+                    const auto Low = _mm_shuffle_epi8(Table, _mm_and_si128(Block, Mask));
+
+                    _mm_storeu_si128((__m128i *)(Output + Offset * 2), _mm_unpacklo_epi8(High, Low));
+                    _mm_storeu_si128((__m128i *)(Output + Offset * 2 + 16), _mm_unpackhi_epi8(High, Low));
+                }
+            }
+
+            return Offset;
+        }
 
-        for (const auto &Item : Input)
+        // Digits and letters are range-checked separately, maddubs then fuses the pairs as High * 16 + Low.
+        inline size_t Decodehex(const char *Input, size_t Size, uint8_t *Output, bool &Valid)
         {
-            const auto Bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(Item);
-            for (const auto Byte : Bytes)
+            size_t Offset = 0;
+
+            if (CPUID::hasAVX2())
             {
-                Output += Mapping[(uint8_t(Byte) & 0xF0) >> 4];
-                Output += Mapping[uint8_t(Byte) & 0x0F];
-                if (Spaced) Output += ' ';
+                const auto Nibbles = [](__m256i Block, __m256i &Accumulator)
+                {
+                    const auto Digit = _mm256_sub_epi8(Block, _mm256_set1_epi8('0'));
+                    const auto Letter = _mm256_sub_epi8(_mm256_or_si256(Block, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+                    const auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(Digit, _mm256_set1_epi8(9)), Digit);
+                    const auto isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(Letter, _mm256_set1_epi8(5)), Letter);
+
+                    Accumulator = _mm256_and_si256(Accumulator, _mm256_or_si256(isDigit, isLetter));
+                    const auto Value = _mm256_or_si256(_mm256_and_si256(isDigit, Digit), _mm256_and_si256(isLetter, _mm256_add_epi8(Letter, _mm256_set1_epi8(10))));
+                    return _mm256_maddubs_epi16(Value, _mm256_set1_epi16(0x0110));
+                };
+
+                auto Accumulator = _mm256_set1_epi8(-1);
+                for (; Offset + 32 <= Size; Offset += 32)
+                {
+                    const auto A = Nibbles(_mm256_loadu_si256((const __m256i *)(Input + Offset * 2)), Accumulator);
+                    const auto B = Nibbles(_mm256_loadu_si256((const __m256i *)(Input + Offset * 2 + 32)), Accumulator);
+
+                    // Packing is also per lane.
+                    _mm256_storeu_si256((__m256i *)(Output + Offset), _mm256_permute4x64_epi64(_mm256_packus_epi16(A, B), 0xD8));
+                }
+
+                if (uint32_t(_mm256_movemask_epi8(Accumulator)) != 0xFFFFFFFF) { Valid = false; return Offset; }
             }
-        }
 
-        while (Output.back() == ' ')
-            Output.pop_back();
+            if (CPUID::hasSSSE3())
+            {
+                const auto Nibbles = [](__m128i Block, __m128i &Accumulator)
+                {
+                    const auto Digit = _mm_sub_epi8(Block, _mm_set1_epi8('0'));
+                    const auto Letter = _mm_sub_epi8(_mm_or_si128(Block, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+                    const auto isDigit = _mm_cmpeq_epi8(_mm_min_epu8(Digit, _mm_set1_epi8(9)), Digit);
+                    const auto isLetter = _mm_cmpeq_epi8(_mm_min_epu8(Letter, _mm_set1_epi8(5)), Letter);
 
-        return Output;
-    }
+                    Accumulator = _mm_and_si128(Accumulator, _mm_or_si128(isDigit, isLetter));
+                    const auto Value = _mm_or_si128(_mm_and_si128(isDigit, Digit), _mm_and_si128(isLetter, _mm_add_epi8(Letter, _mm_set1_epi8(10))));
+                    return _mm_maddubs_epi16(Value, _mm_set1_epi16(0x0110));
+                };
 
-    template <cmp::Range_t T> requires (sizeof(typename T::value_type) != 1) constexpr std::string toHex(const T &Input, bool Spaced = false)
-    {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
-        std::string Output{}; Output.reserve(sizeof(typename T::value_type) * Input.size() * (2 + (Spaced ? 1 : 0)));
+                auto Accumulator = _mm_set1_epi8(-1);
+                for (; Offset + 16 <= Size; Offset += 16)
+                {
+                    const auto A = Nibbles(_mm_loadu_si128((const __m128i *)(Input + Offset * 2)), Accumulator);
+                    const auto B = Nibbles(_mm_loadu_si128((const __m128i *)(Input + Offset * 2 + 16)), Accumulator);
+                    _mm_storeu_si128((__m128i *)(Output + Offset), _mm_packus_epi16(A, B));
+                }
 
-        for (const auto &Item : Input)
+                if (_mm_movemask_epi8(Accumulator) != 0xFFFF) { Valid = false; return Offset; }
+            }
+
+            return Offset;
+        }
+        #endif
+
+        // Returns the number of characters written, Output needs 2 per byte (3 if spaced).
+        constexpr size_t Encode(std::span<const uint8_t> Input, std::span<char> Output, bool Spaced, const std::array<char, 16> &Mapping)
         {
-            const auto Bytes = std::bit_cast<std::array<uint8_t, sizeof(typename T::value_type)>>(Item);
-            for (const auto Byte : Bytes)
+            if (Input.empty()) return 0;
+            const auto Required = Input.size() * (Spaced ? 3 : 2) - (Spaced ? 1 : 0);
+            if (Output.size() < Required) [[unlikely]] return 0;
+
+            size_t Offset = 0;
+
+            #if defined(HAS_CPUID)
+            if (!std::is_constant_evaluated() && !Spaced)
+                Offset = Encodehex(Input.data(), Input.size(), Output.data(), Mapping);
+            #endif
+
+            for (size_t i = Offset; i < Input.size(); ++i)
             {
-                Output += Mapping[(uint8_t(Byte) & 0xF0) >> 4];
-                Output += Mapping[uint8_t(Byte) & 0x0F];
-                if (Spaced) Output += ' ';
+                const auto Position = i * (Spaced ? 3 : 2);
+                Output[Position + 0] = Mapping[(Input[i] & 0xF0) >> 4];
+                Output[Position + 1] = Mapping[Input[i] & 0x0F];
+                if (Spaced && i + 1 < Input.size()) Output[Position + 2] = ' ';
             }
+
+            return Required;
         }
 
-        while (Output.back() == ' ')
-            Output.pop_back();
+        // Bytes of the elements in memory order, falls back to bit_cast when constant evaluated.
+        template <cmp::Range_t T> constexpr size_t Encoderange(const T &Input, std::span<char> Output, bool Spaced, const std::array<char, 16> &Mapping)
+        {
+            using Value_t = std::ranges::range_value_t<T>;
 
-        return Output;
-    }
-    template <cmp::Range_t T> requires (sizeof(typename T::value_type) != 1) constexpr std::string toHEX(const T &Input, bool Spaced = false)
-    {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-        std::string Output{}; Output.reserve(sizeof(typename T::value_type) * Input.size() * (2 + (Spaced ? 1 : 0)));
+            if constexpr (std::ranges::contiguous_range<T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    return Encode({ (const uint8_t *)std::ranges::data(Input), std::ranges::size(Input) * sizeof(Value_t) }, Output, Spaced, Mapping);
+                }
+            }
 
-        for (const auto &Item : Input)
-        {
-            const auto Bytes = std::bit_cast<std::array<uint8_t, sizeof(typename T::value_type)>>(Item);
-            for (const auto Byte : Bytes)
+            const auto Count = size_t(std::ranges::distance(Input)) * sizeof(Value_t);
+            if (Count == 0) return 0;
+
+            const auto Required = Count * (Spaced ? 3 : 2) - (Spaced ? 1 : 0);
+            if (Output.size() < Required) [[unlikely]] return 0;
+
+            size_t Position{};
+            for (const auto &Item : Input)
             {
-                Output += Mapping[(uint8_t(Byte) & 0xF0) >> 4];
-                Output += Mapping[uint8_t(Byte) & 0x0F];
-                if (Spaced) Output += ' ';
+                const auto Bytes = std::bit_cast<std::array<uint8_t, sizeof(Value_t)>>(Item);
+                for (const auto Byte : Bytes)
+                {
+                    Output[Position++] = Mapping[(Byte & 0xF0) >> 4];
+                    Output[Position++] = Mapping[Byte & 0x0F];
+                    if (Spaced && Position < Required) Output[Position++] = ' ';
+                }
             }
+
+            return Required;
         }
+        template <cmp::Range_t T> constexpr std::string Encoderange(const T &Input, bool Spaced, const std::array<char, 16> &Mapping)
+        {
+            const auto Count = size_t(std::ranges::distance(Input)) * sizeof(std::ranges::range_value_t<T>);
+            std::string Output(Count * (Spaced ? 3 : 2), '\0');
 
-        while (Output.back() == ' ')
-            Output.pop_back();
+            Output.resize(Encoderange(Input, Output, Spaced, Mapping));
+            return Output;
+        }
+    }
 
-        return Output;
+    // Allocating versions, optionally with a space between bytes.
+    template <cmp::Range_t T> constexpr std::string toHex(const T &Input, bool Spaced = false)
+    {
+        return Internal::Encoderange(Input, Spaced, Internal::Lowercase);
+    }
+    template <cmp::Range_t T> constexpr std::string toHEX(const T &Input, bool Spaced = false)
+    {
+        return Internal::Encoderange(Input, Spaced, Internal::Uppercase);
     }
 
-    template <cmp::Range_t T> requires (sizeof(typename T::value_type) == 1) constexpr std::string toHex(const T &Input, bool Spaced = false)
+    // Into a caller-provided buffer, returns the characters written or 0 if it's too small.
+    template <cmp::Range_t T> constexpr size_t toHex(const T &Input, std::span<char> Output, bool Spaced = false)
+    {
+        return Internal::Encoderange(Input, Output, Spaced, Internal::Lowercase);
+    }
+    template <cmp::Range_t T> constexpr size_t toHEX(const T &Input, std::span<char> Output, bool Spaced = false)
     {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
-        std::string Output{}; Output.reserve(Input.size() * (2 + (Spaced ? 1 : 0)));
+        return Internal::Encoderange(Input, Output, Spaced, Internal::Uppercase);
+    }
 
-        for (const auto Item : Input)
+    // Strict decoding, an even number of [0-9a-fA-F] and nothing else.
+    constexpr bool fromHex(std::string_view Input, std::span<uint8_t> Output)
+    {
+        if ((Input.size() & 1) || Output.size() < Input.size() / 2) [[unlikely]] return false;
+
+        const auto Size = Input.size() / 2;
+        bool Valid = true;
+        size_t Offset = 0;
+
+        #if defined(HAS_CPUID)
+        if (!std::is_constant_evaluated())
+            Offset = Internal::Decodehex(Input.data(), Size, Output.data(), Valid);
+        #endif
+
+        for (size_t i = Offset; Valid && i < Size; ++i)
         {
-            Output += Mapping[(uint8_t(Item) & 0xF0) >> 4];
-            Output += Mapping[uint8_t(Item) & 0x0F];
-            if (Spaced) Output += ' ';
+            const auto High = Internal::Nibble(Input[i * 2]), Low = Internal::Nibble(Input[i * 2 + 1]);
+            Valid = (High | Low) != 0xFF;
+            Output[i] = uint8_t((High << 4) | Low);
         }
 
-        while (Output.back() == ' ')
-            Output.pop_back();
-
+        return Valid;
+    }
+    template <size_t N> constexpr std::optional<std::array<uint8_t, N>> fromHex(std::string_view Input)
+    {
+        std::array<uint8_t, N> Output{};
+        if (Input.size() != N * 2 || !fromHex(Input, Output)) return std::nullopt;
+        return Output;
+    }
+    inline std::optional<Blob_t> fromHex(std::string_view Input)
+    {
+        Blob_t Output(Input.size() / 2, 0);
+        if (!fromHex(Input, Output)) return std::nullopt;
         return Output;
     }
-    template <cmp::Range_t T> requires (sizeof(typename T::value_type) == 1) constexpr std::string toHEX(const T &Input, bool Spaced = false)
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    static_assert("01 ab ff" == String::toHex(std::array<uint8_t, 3>{ 0x01, 0xAB, 0xFF }, true), "BROKEN: String::toHex");
+    static_assert("0201" == String::toHEX(std::array<uint16_t, 1>{ 0x0102 }), "BROKEN: String::toHEX");
+    static_assert(String::fromHex<3>("01aBfF") == std::array<uint8_t, 3>{ 0x01, 0xAB, 0xFF }, "BROKEN: String::fromHex");
+    static_assert(!String::fromHex<2>("01aG") && !String::fromHex<2>("01a"), "BROKEN: String::fromHex");
+
+    inline void Hextest()
     {
-        constexpr std::array<char, 16> Mapping{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-        std::string Output{}; Output.reserve(Input.size() * (2 + (Spaced ? 1 : 0)));
+        Blob_t Input(1000, 0);
+        for (size_t i = 0; i < Input.size(); ++i) Input[i] = uint8_t(i * 7);
 
-        for (const auto Item : Input)
+        // Every length so that each kernel and the scalar tail get covered.
+        for (size_t Length = 0; Length < Input.size(); Length += 13)
         {
-            Output += Mapping[(uint8_t(Item) & 0xF0) >> 4];
-            Output += Mapping[uint8_t(Item) & 0x0F];
-            if (Spaced) Output += ' ';
+            const auto View = Blob_view_t(Input.data(), Length);
+            const auto Encoded = String::toHEX(View);
+
+            std::string Expected{};
+            for (const auto Byte : View) { Expected += String::Internal::Uppercase[Byte >> 4]; Expected += String::Internal::Uppercase[Byte & 0xF]; }
+            if (Encoded != Expected) std::printf("BROKEN: String::toHEX\n");
+
+            const auto Decoded = String::fromHex(Encoded);
+            if (!Decoded || *Decoded != View) std::printf("BROKEN: String::fromHex\n");
         }
 
-        while (Output.back() == ' ')
-            Output.pop_back();
+        // A bad character inside the vectorized part, then in the scalar tail (the last 8 bytes of 1000).
+        for (const auto Position : { 1500, 1990 })
+        {
+            auto Bad = String::toHex(Input);
+            Bad[Position] = 'x';
+            if (String::fromHex(Bad)) std::printf("BROKEN: String::fromHex validation\n");
+        }
+    }
+}
+#endif
 
-        return Output;
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    inline void Hexbenchmark()
+    {
+        const auto Input = Randombytes(64 * 1024);
+        const auto Encoded = String::toHex(Input);
+        std::vector<uint8_t> Decoded(Input.size());
+        std::string Output(Encoded.size(), '\0');
+
+        Measure("String::toHex (64 KiB)", Input.size(), [&]() { Keep(String::toHex(Input, Output)); });
+        Measure("String::fromHex (64 KiB)", Input.size(), [&]() { Keep(String::fromHex(Encoded, Decoded)); });
+        Measure("String::toHex (16 bytes)", 16, [&]() { Keep(String::toHex(std::span(Input).first(16))); });
     }
 }
+#endif
@@ -7,10 +7,129 @@
 #pragma once
 #include "Threading/Debugmutex.hpp"
 #include "Threading/Spinlock.hpp"
+#include "Threading/Ticketlock.hpp"
+#include "Threading/MCSlock.hpp"
+#include "Threading/Hybridmutex.hpp"
+#include "Threading/RWSpinlock.hpp"
+#include "Threading/Lockprofiler.hpp"
+#include "Threading/Tracer.hpp"
+#include "Threading/Scheduler.hpp"
+#include "Threading/Coroutine.hpp"
+#include "Threading/AsyncIO.hpp"
 
-// Helper to switch between debug and release mutex's.
-#if defined (NDEBUG)
-    #define Defaultmutex_t Spinlock_t
+// Helper to switch between debug and release mutex's, any of the above can be selected with -DDEFAULTMUTEX=.
+#if defined (DEFAULTMUTEX)
+    #define Basemutex_t DEFAULTMUTEX
+#elif defined (NDEBUG)
+    #define Basemutex_t Spinlock_t
 #else
-    #define Defaultmutex_t Debugmutex_t
+    #define Basemutex_t Debugmutex_t
+#endif
+
+// Contention counters per lock and call-site, see Lockprofiler::Dump().
+#if defined (PROFILE_LOCKS)
+    #define Defaultmutex_t Profiledmutex_t<Basemutex_t>
+#else
+    #define Defaultmutex_t Basemutex_t
+#endif
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Threadingtest()
+    {
+        // Unsynchronized increments only add up if the lock excludes.
+        const auto Hammer = []<typename T>(T &Lock, const char *Name)
+        {
+            size_t Counter{};
+            {
+                std::vector<std::jthread> Threads;
+                for (size_t t = 0; t < 4; ++t)
+                    Threads.emplace_back([&]() { for (size_t i = 0; i < 10000; ++i) { std::scoped_lock Guard(Lock); ++Counter; } });
+            }
+
+            if (Counter != 40000) std::printf("BROKEN: %s exclusion\n", Name);
+        };
+
+        Spinlock_t A; Ticketlock_t B; MCSlock_t C; Hybridmutex_t D; RWSpinlock_t E;
+        Hammer(A, "Spinlock_t"); Hammer(B, "Ticketlock_t"); Hammer(C, "MCSlock_t"); Hammer(D, "Hybridmutex_t"); Hammer(E, "RWSpinlock_t");
+
+        // Nested MCS locks need a node each.
+        MCSlock_t F;
+        { std::scoped_lock Guard(C, F); if (C.try_lock() || F.try_lock()) std::printf("BROKEN: MCSlock_t try_lock\n"); }
+
+        // One lock taken at one site.
+        Lockprofiler::Reset();
+        Profiledmutex_t<Spinlock_t> G;
+        Hammer(G, "Profiledmutex_t");
+
+        const auto Stats = Lockprofiler::Snapshot();
+        if (Stats.size() != 1 || Stats.begin()->second.Acquisitions != 40000) std::printf("BROKEN: Lockprofiler counting\n");
+        if (!Lockprofiler::Dump().contains("\"Acquisitions\"")) std::printf("BROKEN: Lockprofiler dump\n");
+
+        // Members declared together still get an entry per instance and per acquiring site.
+        Lockprofiler::Reset();
+        struct Pair_t { Profiledmutex_t<Spinlock_t> A, B; } First{}, Second{};
+        for (const auto Pair : { &First, &Second })
+        {
+            { const Lockprofiler::Guard_t Guard(Pair->A); }
+            { const Lockprofiler::Guard_t Guard(Pair->B); }
+        }
+        { const Lockprofiler::Guard_t Guard(First.A); }
+        if (Lockprofiler::Snapshot().size() != 5) std::printf("BROKEN: Lockprofiler sites\n");
+
+        // Readers share, writers exclude them.
+        std::shared_lock Reader(E);
+        if (E.try_lock_shared()) E.unlock_shared();
+        else std::printf("BROKEN: RWSpinlock_t sharing\n");
+
+        if (E.try_lock()) { E.unlock(); std::printf("BROKEN: RWSpinlock_t exclusion\n"); }
+    }
+}
+#endif
+
+#if defined(ENABLE_BENCHMARKS)
+namespace Benchmarks
+{
+    // Lock + tiny critical section + unlock, from one thread up to every hardware thread.
+    inline void Lockbenchmark()
+    {
+        const auto Maxthreads = std::max(1U, std::thread::hardware_concurrency());
+        constexpr uint64_t Iterations = 100000;
+
+        // Powers of two, then every hardware thread even when that isn't one.
+        std::vector<size_t> Threadcounts{};
+        for (size_t Threads = 1; Threads < Maxthreads; Threads *= 2) Threadcounts.push_back(Threads);
+        Threadcounts.push_back(Maxthreads);
+
+        const auto Contend = [&]<typename T>(const char *Name)
+        {
+            for (const auto Threads : Threadcounts)
+            {
+                T Lock{};
+                uint64_t Counter{};
+
+                Measurethreads(std::format("{} (lock/unlock)", Name), Threads, Iterations, [&](size_t)
+                {
+                    std::scoped_lock Guard(Lock);
+                    Keep(++Counter);
+                });
+            }
+        };
+
+        Contend.template operator()<Spinlock_t>("Spinlock_t");
+        Contend.template operator()<Ticketlock_t>("Ticketlock_t");
+        Contend.template operator()<MCSlock_t>("MCSlock_t");
+        Contend.template operator()<Hybridmutex_t>("Hybridmutex_t");
+        Contend.template operator()<RWSpinlock_t>("RWSpinlock_t");
+        Contend.template operator()<std::mutex>("std::mutex");
+
+        // Readers only, which should scale.
+        for (const auto Threads : Threadcounts)
+        {
+            RWSpinlock_t Lock{};
+            Measurethreads("RWSpinlock_t (shared)", Threads, Iterations, [&](size_t) { std::shared_lock Guard(Lock); });
+        }
+    }
+}
 #endif
@@ -0,0 +1,354 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Socket reads and writes as coroutines, one reactor thread per loop hands completions to the scheduler.
+    Windows uses IOCP, everything else edge-triggered epoll.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "Spinlock.hpp"
+#include "Scheduler.hpp"
+#include "Coroutine.hpp"
+
+#if !defined (_WIN32)
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <fcntl.h>
+#endif
+
+#if defined (_WIN32)
+using Socket_t = SOCKET;
+#else
+using Socket_t = int;
+#endif
+
+struct Eventloop_t
+{
+    struct Descriptor_t
+    {
+        Eventloop_t *Loop;
+        Socket_t Socket;
+
+        #if !defined (_WIN32)
+        // Set by the reactor when an edge arrives with nobody waiting for it.
+        Spinlock_t Lock{};
+        Job_t *Reader{}, *Writer{};
+        bool Readready{ true }, Writeready{ true };
+        #endif
+    };
+
+    Scheduler_t &Scheduler;
+    std::atomic<bool> Terminate{};
+    std::jthread Reactor{};
+
+    #if defined (_WIN32)
+    HANDLE Port{};
+
+    struct Overlapped_t : OVERLAPPED
+    {
+        Job_t Job{};
+        DWORD Bytes{}, Error{};
+    };
+    #else
+    int Epoll{ -1 }, Wakeup{ -1 };
+
+    // Detached descriptors are freed by the reactor once it's done with the current batch of events.
+    Spinlock_t Retiredlock{};
+    std::vector<Descriptor_t *> Retired{};
+    #endif
+
+    explicit Eventloop_t(Scheduler_t &Pool = Scheduler_t::Default()) : Scheduler(Pool)
+    {
+        #if defined (_WIN32)
+        Port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        #else
+        Epoll = epoll_create1(EPOLL_CLOEXEC);
+        Wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event Event{ EPOLLIN, { .ptr = nullptr } };
+        epoll_ctl(Epoll, EPOLL_CTL_ADD, Wakeup, &Event);
+        #endif
+
+        Reactor = std::jthread([this]() { Reactorloop(); });
+    }
+    ~Eventloop_t()
+    {
+        Terminate.store(true);
+
+        #if defined (_WIN32)
+        PostQueuedCompletionStatus(Port, 0, 0, nullptr);
+        Reactor.join();
+        CloseHandle(Port);
+        #else
+        const uint64_t One = 1;
+        (void)!write(Wakeup, &One, sizeof(One));
+        Reactor.join();
+
+        for (const auto Descriptor : Retired) delete Descriptor;
+        close(Wakeup);
+        close(Epoll);
+        #endif
+    }
+
+    static Eventloop_t &Default()
+    {
+        static Eventloop_t Instance{};
+        return Instance;
+    }
+
+    // The socket is made non-blocking and stays owned by the caller.
+    [[nodiscard]] Descriptor_t *Attach(Socket_t Socket)
+    {
+        const auto Descriptor = new Descriptor_t{ this, Socket };
+
+        #if defined (_WIN32)
+        CreateIoCompletionPort((HANDLE)Socket, Port, 0, 0);
+        #else
+        fcntl(Socket, F_SETFL, fcntl(Socket, F_GETFL) | O_NONBLOCK);
+
+        epoll_event Event{ EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, { .ptr = Descriptor } };
+        epoll_ctl(Epoll, EPOLL_CTL_ADD, Socket, &Event);
+        #endif
+
+        return Descriptor;
+    }
+
+    // No reads or writes may be pending, they are not cancelled.
+    void Detach(Descriptor_t *Descriptor)
+    {
+        #if defined (_WIN32)
+        delete Descriptor;
+        #else
+        epoll_ctl(Epoll, EPOLL_CTL_DEL, Descriptor->Socket, nullptr);
+
+        std::scoped_lock Guard(Retiredlock);
+        Retired.push_back(Descriptor);
+        #endif
+    }
+
+    #if defined (_WIN32)
+    // Issues the request on suspension, the coroutine may be resumed before WSARecv even returns.
+    struct Overlappedop_t
+    {
+        Overlapped_t Request{};
+        Socket_t Socket;
+        WSABUF Buffer;
+        bool isWrite;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> Handle) noexcept
+        {
+            Request.Job.Coroutine = Handle;
+
+            DWORD Flags{};
+            const auto Result = isWrite ? WSASend(Socket, &Buffer, 1, nullptr, 0, &Request, nullptr)
+                                        : WSARecv(Socket, &Buffer, 1, nullptr, &Flags, &Request, nullptr);
+
+            if (Result == SOCKET_ERROR) if (const auto Error = WSAGetLastError(); Error != WSA_IO_PENDING)
+            {
+                Request.Error = Error;
+                return false;
+            }
+
+            return true;
+        }
+        int64_t await_resume() const noexcept { return Request.Error ? -int64_t(Request.Error) : int64_t(Request.Bytes); }
+    };
+
+    #else
+
+    // Waits for the next edge unless one already came in.
+    struct Readiness_t
+    {
+        Descriptor_t *Descriptor;
+        bool isWrite;
+        Job_t Job{};
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> Handle) noexcept
+        {
+            std::scoped_lock Guard(Descriptor->Lock);
+            auto &Ready = isWrite ? Descriptor->Writeready : Descriptor->Readready;
+
+            if (Ready) { Ready = false; return false; }
+            Job.Coroutine = Handle;
+            (isWrite ? Descriptor->Writer : Descriptor->Reader) = &Job;
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+    #endif
+
+private:
+    // Waiters embed their job, so handing them back is allocation free.
+    void Resume(Job_t *Job)
+    {
+        Scheduler.Submit(Job);
+    }
+
+    #if defined (_WIN32)
+    void Reactorloop()
+    {
+        while (true)
+        {
+            DWORD Bytes{}; ULONG_PTR Key{}; OVERLAPPED *Overlapped{};
+            const auto Success = GetQueuedCompletionStatus(Port, &Bytes, &Key, &Overlapped, INFINITE);
+
+            if (!Overlapped) { if (Terminate.load()) break; continue; }
+
+            const auto Request = static_cast<Overlapped_t *>(Overlapped);
+            Request->Bytes = Bytes;
+            Request->Error = Success ? 0 : GetLastError();
+            Resume(&Request->Job);
+        }
+    }
+
+    #else
+
+    void Signal(Descriptor_t *Descriptor, bool isWrite)
+    {
+        Job_t *Waiting{};
+        {
+            std::scoped_lock Guard(Descriptor->Lock);
+            auto &Waiter = isWrite ? Descriptor->Writer : Descriptor->Reader;
+
+            if (Waiter) Waiting = std::exchange(Waiter, nullptr);
+            else (isWrite ? Descriptor->Writeready : Descriptor->Readready) = true;
+        }
+
+        if (Waiting) Resume(Waiting);
+    }
+    void Reactorloop()
+    {
+        std::array<epoll_event, 256> Events;
+
+        while (!Terminate.load(std::memory_order_relaxed))
+        {
+            const auto Count = epoll_wait(Epoll, Events.data(), int(Events.size()), -1);
+
+            for (int i = 0; i < Count; ++i)
+            {
+                const auto Descriptor = (Descriptor_t *)Events[i].data.ptr;
+                const auto Flags = Events[i].events;
+
+                if (!Descriptor)
+                {
+                    uint64_t Value;
+                    (void)!read(Wakeup, &Value, sizeof(Value));
+                    continue;
+                }
+
+                // Errors and hangups wake both sides so that they see the result.
+                const auto Failed = Flags & (EPOLLERR | EPOLLHUP);
+                if (Flags & (EPOLLIN | EPOLLRDHUP) || Failed) Signal(Descriptor, false);
+                if (Flags & EPOLLOUT || Failed) Signal(Descriptor, true);
+            }
+
+            std::vector<Descriptor_t *> Done{};
+            {
+                std::scoped_lock Guard(Retiredlock);
+                Done.swap(Retired);
+            }
+            for (const auto Descriptor : Done) delete Descriptor;
+        }
+    }
+    #endif
+};
+
+// Appends up to Max bytes at the end of the buffer, returns the count, 0 on EOF or a negative error.
+inline Task_t<int64_t> Asyncread(Eventloop_t::Descriptor_t *Descriptor, Bytebuffer_t &Buffer, size_t Max = 4096)
+{
+    Buffer.Seek(0, SEEK_END);
+    const auto Destination = Buffer.rawReserve(Max);
+    int64_t Result{};
+
+    #if defined (_WIN32)
+    Result = co_await Eventloop_t::Overlappedop_t{ {}, Descriptor->Socket, { ULONG(Max), (CHAR *)Destination }, false };
+    #else
+    while (true)
+    {
+        if (const auto Count = recv(Descriptor->Socket, Destination, Max, 0); Count >= 0) { Result = Count; break; }
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) { Result = -int64_t(errno); break; }
+        if (errno != EINTR) co_await Eventloop_t::Readiness_t{ Descriptor, false };
+    }
+    #endif
+
+    // Give back what wasn't filled.
+    Buffer.Shrink(Max - size_t(std::max<int64_t>(Result, 0)));
+    co_return Result;
+}
+
+// Writes all of the data, returns the count or a negative error.
+inline Task_t<int64_t> Asyncwrite(Eventloop_t::Descriptor_t *Descriptor, std::span<const uint8_t> Data)
+{
+    size_t Total{};
+
+    while (Total < Data.size())
+    {
+        #if defined (_WIN32)
+        const auto Result = co_await Eventloop_t::Overlappedop_t{ {}, Descriptor->Socket, { ULONG(Data.size() - Total), (CHAR *)Data.data() + Total }, true };
+        if (Result <= 0) co_return Result ? Result : -int64_t(WSAECONNRESET);
+        Total += size_t(Result);
+        #else
+        if (const auto Count = send(Descriptor->Socket, Data.data() + Total, Data.size() - Total, MSG_NOSIGNAL); Count >= 0) { Total += size_t(Count); continue; }
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) co_return -int64_t(errno);
+        if (errno != EINTR) co_await Eventloop_t::Readiness_t{ Descriptor, true };
+        #endif
+    }
+
+    co_return int64_t(Total);
+}
+
+// Exact match only, Bytebuffer_t converts from most containers which would make the span overload ambiguous.
+template <std::same_as<Bytebuffer_t> T> Task_t<int64_t> Asyncwrite(Eventloop_t::Descriptor_t *Descriptor, const T &Buffer)
+{
+    return Asyncwrite(Descriptor, Buffer.as_span());
+}
+
+#if defined(ENABLE_UNITTESTS) && !defined (_WIN32)
+namespace Unittests
+{
+    inline void AsyncIOtest()
+    {
+        Scheduler_t Pool(2);
+        Eventloop_t Loop(Pool);
+
+        int Pair[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, Pair);
+        const auto A = Loop.Attach(Pair[0]), B = Loop.Attach(Pair[1]);
+
+        // Large enough to fill the socket buffer, so both sides have to wait on the reactor.
+        std::vector<uint8_t> Payload(1 << 20);
+        for (size_t i = 0; i < Payload.size(); ++i) Payload[i] = uint8_t(i * 31);
+
+        const auto Writer = [&]() -> Task_t<int64_t>
+        {
+            co_await Schedule(Pool);
+            co_return co_await Asyncwrite(A, Payload);
+        };
+        const auto Reader = [&]() -> Task_t<int64_t>
+        {
+            Bytebuffer_t Received{};
+            while (Received.size() < Payload.size())
+                if (co_await Asyncread(B, Received, 64 * 1024) <= 0) break;
+
+            co_return std::ranges::equal(Received.as_span(), Payload) ? int64_t(Received.size()) : -1;
+        };
+
+        const auto [Written, Read] = Syncwait(WhenAll(Writer(), Reader()));
+        if (Written != int64_t(Payload.size()) || Read != Written) std::printf("BROKEN: AsyncIO transfer\n");
+
+        // Hangups complete the read with EOF.
+        close(Pair[0]);
+        Bytebuffer_t Empty{};
+        if (Syncwait(Asyncread(B, Empty)) != 0 || Empty.size() != 0) std::printf("BROKEN: AsyncIO EOF\n");
+
+        Loop.Detach(A); Loop.Detach(B);
+        close(Pair[1]);
+    }
+}
+#endif
@@ -0,0 +1,420 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Lazy coroutine tasks, frames come from a per-thread pool.
+    co_await Schedule() to hop onto the work-stealing scheduler.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include <coroutine>
+#include <semaphore>
+#include "Scheduler.hpp"
+
+namespace Coroutine
+{
+    // Size-classed freelists, frames freed on another thread simply migrate there.
+    namespace Framepool
+    {
+        constexpr size_t Granularity = 64, Classes = 32, Maxcached = 256;
+
+        struct Freelist_t
+        {
+            struct Node_t { Node_t *Next; };
+            std::array<Node_t *, Classes> Heads{};
+            std::array<size_t, Classes> Counts{};
+
+            ~Freelist_t()
+            {
+                for (auto Head : Heads)
+                    while (Head) { const auto Next = Head->Next; ::operator delete(Head); Head = Next; }
+            }
+        };
+        inline Freelist_t &Local()
+        {
+            thread_local Freelist_t Instance{};
+            return Instance;
+        }
+
+        inline void *Allocate(size_t Size)
+        {
+            const auto Class = (Size + Granularity - 1) / Granularity;
+            if (Class >= Classes) [[unlikely]] return ::operator new(Size);
+
+            auto &List = Local();
+            if (const auto Node = List.Heads[Class])
+            {
+                List.Heads[Class] = Node->Next;
+                List.Counts[Class]--;
+                return Node;
+            }
+
+            return ::operator new(Class * Granularity);
+        }
+        inline void Release(void *Pointer, size_t Size)
+        {
+            const auto Class = (Size + Granularity - 1) / Granularity;
+            auto &List = Local();
+
+            if (Class >= Classes || List.Counts[Class] >= Maxcached) [[unlikely]]
+                return ::operator delete(Pointer);
+
+            const auto Node = (Freelist_t::Node_t *)Pointer;
+            Node->Next = List.Heads[Class];
+            List.Heads[Class] = Node;
+            List.Counts[Class]++;
+        }
+    }
+
+    struct Pooled_t
+    {
+        static void *operator new(size_t Size) { return Framepool::Allocate(Size); }
+        static void operator delete(void *Pointer, size_t Size) { Framepool::Release(Pointer, Size); }
+    };
+
+    // Resumes whoever awaited us once done.
+    struct Promisebase_t : Pooled_t
+    {
+        std::coroutine_handle<> Continuation{};
+
+        struct Final_t
+        {
+            bool await_ready() const noexcept { return false; }
+            template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> Handle) noexcept
+            {
+                const auto Next = Handle.promise().Continuation;
+                return Next ? Next : std::noop_coroutine();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        Final_t final_suspend() const noexcept { return {}; }
+
+        // Exceptions are disabled in release builds.
+        [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+    };
+}
+
+template <typename T = void> struct [[nodiscard]] Task_t
+{
+    struct promise_type : Coroutine::Promisebase_t
+    {
+        std::optional<T> Value{};
+
+        Task_t get_return_object() noexcept { return Task_t{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        template <typename U> void return_value(U &&Result) { Value.emplace(std::forward<U>(Result)); }
+    };
+
+    std::coroutine_handle<promise_type> Handle{};
+
+    // Starts the task, our caller is resumed when it's done.
+    bool await_ready() const noexcept { return !Handle || Handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> Caller) noexcept
+    {
+        Handle.promise().Continuation = Caller;
+        return Handle;
+    }
+    T await_resume()
+    {
+        // A default constructed or moved-from task has no result to give.
+        assert(Handle);
+        return std::move(*Handle.promise().Value);
+    }
+
+    Task_t() = default;
+    explicit Task_t(std::coroutine_handle<promise_type> Coroutine) noexcept : Handle(Coroutine) {}
+    Task_t(Task_t &&Other) noexcept : Handle(std::exchange(Other.Handle, {})) {}
+    Task_t &operator=(Task_t &&Other) noexcept
+    {
+        if (this != &Other) { if (Handle) Handle.destroy(); Handle = std::exchange(Other.Handle, {}); }
+        return *this;
+    }
+    ~Task_t() { if (Handle) Handle.destroy(); }
+};
+template <> struct [[nodiscard]] Task_t<void>
+{
+    struct promise_type : Coroutine::Promisebase_t
+    {
+        Task_t get_return_object() noexcept { return Task_t{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        void return_void() const noexcept {}
+    };
+
+    std::coroutine_handle<promise_type> Handle{};
+
+    bool await_ready() const noexcept { return !Handle || Handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> Caller) noexcept
+    {
+        Handle.promise().Continuation = Caller;
+        return Handle;
+    }
+    void await_resume() const noexcept {}
+
+    Task_t() = default;
+    explicit Task_t(std::coroutine_handle<promise_type> Coroutine) noexcept : Handle(Coroutine) {}
+    Task_t(Task_t &&Other) noexcept : Handle(std::exchange(Other.Handle, {})) {}
+    Task_t &operator=(Task_t &&Other) noexcept
+    {
+        if (this != &Other) { if (Handle) Handle.destroy(); Handle = std::exchange(Other.Handle, {}); }
+        return *this;
+    }
+    ~Task_t() { if (Handle) Handle.destroy(); }
+};
+
+namespace Coroutine
+{
+    // Void results are stored as monostate so that they fit in containers.
+    template <typename T> using Result_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    // Helpers that run a task to completion and then signal someone.
+    struct Child_t
+    {
+        struct promise_type : Pooled_t
+        {
+            std::atomic<size_t> *Remaining{};
+            std::coroutine_handle<> Parent{};
+
+            struct Final_t
+            {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> Handle) noexcept
+                {
+                    // The last one to finish resumes the parent, which then destroys us.
+                    const auto &Promise = Handle.promise();
+                    if (Promise.Remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) return Promise.Parent;
+                    return std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+            Child_t get_return_object() noexcept { return Child_t{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            Final_t final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> Handle{};
+
+        explicit Child_t(std::coroutine_handle<promise_type> Coroutine) noexcept : Handle(Coroutine) {}
+        Child_t(Child_t &&Other) noexcept : Handle(std::exchange(Other.Handle, {})) {}
+        ~Child_t() { if (Handle) Handle.destroy(); }
+    };
+    template <typename T> Child_t Runchild(Task_t<T> &Task, std::optional<Result_t<T>> &Slot)
+    {
+        if constexpr (std::is_void_v<T>) { co_await Task; Slot.emplace(); }
+        else Slot.emplace(co_await Task);
+    }
+
+    // Starts all children and resumes the awaiting coroutine after the last one finishes.
+    struct Join_t
+    {
+        std::span<Child_t> Children;
+        std::atomic<size_t> Remaining{};
+
+        bool await_ready() const noexcept { return Children.empty(); }
+        bool await_suspend(std::coroutine_handle<> Parent) noexcept
+        {
+            // An extra count for ourselves so that no child resumes the parent while we're still starting them.
+            Remaining.store(Children.size() + 1, std::memory_order_relaxed);
+            for (auto &Child : Children)
+            {
+                Child.Handle.promise().Remaining = &Remaining;
+                Child.Handle.promise().Parent = Parent;
+                Child.Handle.resume();
+            }
+
+            return Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    // Self-destroying, for fire-and-forget and blocking waits.
+    struct Detached_t
+    {
+        struct promise_type : Pooled_t
+        {
+            Detached_t get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+}
+
+// Continues on one of the schedulers workers, the job lives in the awaiter until then.
+struct Schedule_t
+{
+    Scheduler_t &Scheduler;
+    Job_t Job{};
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> Handle)
+    {
+        Job.Coroutine = Handle;
+        Scheduler.Submit(&Job);
+    }
+    void await_resume() const noexcept {}
+};
+inline Schedule_t Schedule(Scheduler_t &Scheduler = Scheduler_t::Default()) { return { Scheduler }; }
+
+// Run on the scheduler without waiting for the result.
+inline void Detach(Task_t<> Task, Scheduler_t &Scheduler = Scheduler_t::Default())
+{
+    [](Task_t<> Task, Scheduler_t &Scheduler) -> Coroutine::Detached_t
+    {
+        co_await Schedule(Scheduler);
+        co_await Task;
+    }(std::move(Task), Scheduler);
+}
+
+// Blocks the calling thread, for use outside of coroutines.
+template <typename T> T Syncwait(Task_t<T> Task)
+{
+    std::binary_semaphore Done{ 0 };
+    std::optional<Coroutine::Result_t<T>> Result{};
+
+    [](Task_t<T> &Task, std::optional<Coroutine::Result_t<T>> &Result, std::binary_semaphore &Done) -> Coroutine::Detached_t
+    {
+        if constexpr (std::is_void_v<T>) { co_await Task; Result.emplace(); }
+        else Result.emplace(co_await Task);
+        Done.release();
+    }(Task, Result, Done);
+
+    Done.acquire();
+    if constexpr (!std::is_void_v<T>) return std::move(*Result);
+}
+
+// Completes once every task has, results in order.
+template <typename T> Task_t<std::vector<Coroutine::Result_t<T>>> WhenAll(std::vector<Task_t<T>> Tasks)
+{
+    std::vector<std::optional<Coroutine::Result_t<T>>> Slots(Tasks.size());
+    std::vector<Coroutine::Child_t> Children{};
+    Children.reserve(Tasks.size());
+
+    for (size_t i = 0; i < Tasks.size(); ++i) Children.emplace_back(Coroutine::Runchild(Tasks[i], Slots[i]));
+    co_await Coroutine::Join_t{ Children };
+
+    std::vector<Coroutine::Result_t<T>> Results{};
+    Results.reserve(Slots.size());
+    for (auto &Slot : Slots) Results.emplace_back(std::move(*Slot));
+    co_return Results;
+}
+template <typename... T> Task_t<std::tuple<Coroutine::Result_t<T>...>> WhenAll(Task_t<T>... Tasks)
+{
+    std::tuple<std::optional<Coroutine::Result_t<T>>...> Slots{};
+    std::array<Coroutine::Child_t, sizeof...(T)> Children = std::apply([&](auto &...Slot) { return std::array{ Coroutine::Runchild(Tasks, Slot)... }; }, Slots);
+
+    co_await Coroutine::Join_t{ Children };
+    co_return std::apply([](auto &...Slot) { return std::tuple<Coroutine::Result_t<T>...>{ std::move(*Slot)... }; }, Slots);
+}
+
+// Completes with the index (and result) of the first task to finish, the rest keep running in the background.
+template <typename T> auto WhenAny(std::vector<Task_t<T>> Tasks) -> Task_t<std::conditional_t<std::is_void_v<T>, size_t, std::pair<size_t, Coroutine::Result_t<T>>>>
+{
+    struct State_t
+    {
+        std::vector<Task_t<T>> Tasks;
+        std::optional<Coroutine::Result_t<T>> Result{};
+        std::atomic<bool> Finished{};
+        std::atomic<int> Gate{ 2 };
+        std::coroutine_handle<> Parent{};
+        size_t Winner{};
+    };
+    const auto State = std::make_shared<State_t>(std::move(Tasks));
+
+    // Both the winner and the starting loop have to pass the gate before the parent resumes.
+    struct Starter_t
+    {
+        const std::shared_ptr<State_t> &State;
+
+        bool await_ready() const noexcept { return State->Tasks.empty(); }
+        bool await_suspend(std::coroutine_handle<> Parent)
+        {
+            State->Parent = Parent;
+
+            for (size_t i = 0; i < State->Tasks.size(); ++i)
+            {
+                [](std::shared_ptr<State_t> State, size_t Index) -> Coroutine::Detached_t
+                {
+                    auto &Task = State->Tasks[Index];
+                    std::optional<Coroutine::Result_t<T>> Value{};
+
+                    if constexpr (std::is_void_v<T>) { co_await Task; Value.emplace(); }
+                    else Value.emplace(co_await Task);
+
+                    if (!State->Finished.exchange(true, std::memory_order_acq_rel))
+                    {
+                        State->Winner = Index;
+                        State->Result = std::move(Value);
+                        if (State->Gate.fetch_sub(1, std::memory_order_acq_rel) == 1) State->Parent.resume();
+                    }
+                }(State, i);
+            }
+
+            return State->Gate.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    co_await Starter_t{ State };
+    if constexpr (std::is_void_v<T>) co_return State->Winner;
+    else co_return std::pair{ State->Winner, std::move(*State->Result) };
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Coroutinetest()
+    {
+        // The losing WhenAny task is still blocked on a worker when the race returns, so its gate and closure must outlive the pool.
+        std::binary_semaphore Gate{ 0 };
+        const auto Slow = [&Gate](Scheduler_t &Target) -> Task_t<int> { co_await Schedule(Target); Gate.acquire(); co_return 1; };
+
+        Scheduler_t Pool(2);
+
+        const auto Square = [&Pool](int Value) -> Task_t<int>
+        {
+            co_await Schedule(Pool);
+            co_return Value * Value;
+        };
+        const auto Sum = [&]() -> Task_t<int>
+        {
+            std::vector<Task_t<int>> Tasks{};
+            for (int i = 1; i <= 10; ++i) Tasks.emplace_back(Square(i));
+
+            int Total{};
+            for (const auto Item : co_await WhenAll(std::move(Tasks))) Total += Item;
+
+            const auto [A, B] = co_await WhenAll(Square(2), Square(3));
+            co_return Total + A + B;
+        };
+        if (Syncwait(Sum()) != 385 + 13) std::printf("BROKEN: Coroutine WhenAll\n");
+
+        // The immediate task wins, the other is left to finish in the background.
+        const auto Fast = []() -> Task_t<int> { co_return 2; };
+
+        std::vector<Task_t<int>> Race{};
+        Race.emplace_back(Slow(Pool));
+        Race.emplace_back(Fast());
+
+        const auto [Index, Value] = Syncwait(WhenAny(std::move(Race)));
+        if (Index != 1 || Value != 2) std::printf("BROKEN: Coroutine WhenAny\n");
+        Gate.release();
+
+        // Frames are recycled.
+        const auto Trivial = []() -> Task_t<> { co_return; };
+        const auto First = (void *)Trivial().Handle.address();
+        if (First != (void *)Trivial().Handle.address()) std::printf("BROKEN: Coroutine frame pool\n");
+
+        // Lambda coroutines refer to their closure, so it has to outlive the task.
+        std::binary_semaphore Detached{ 0 };
+        const auto Signal = [&]() -> Task_t<> { Detached.release(); co_return; };
+        Detach(Signal(), Pool);
+        Detached.acquire();
+    }
+}
+#endif
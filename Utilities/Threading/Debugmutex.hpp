@@ -50,6 +50,18 @@ struct Debugmutex_t
 
         Currentowner = std::this_thread::get_id();
     }
+    bool try_lock()
+    {
+        if (Currentowner == std::this_thread::get_id())
+        {
+            Break(std::format("Debugmutex: Recursive lock by thread {:X}", std::bit_cast<uint32_t>(Currentowner)));
+        }
+
+        if (!Mutex.try_lock()) return false;
+
+        Currentowner = std::this_thread::get_id();
+        return true;
+    }
     void unlock()
     {
         if (Currentowner != std::this_thread::get_id())
@@ -0,0 +1,49 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Spins for a short while, then parks on the address (futex / WaitOnAddress via std::atomic::wait).
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <intrin.h>
+
+struct Hybridmutex_t
+{
+    // 0 = unlocked, 1 = locked, 2 = locked with sleepers.
+    std::atomic<uint32_t> State{};
+
+    bool try_lock() noexcept
+    {
+        uint32_t Expected{};
+        return State.compare_exchange_strong(Expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void unlock() noexcept
+    {
+        // Only pay for the syscall if someone is asleep.
+        if (State.exchange(0, std::memory_order_release) == 2)
+            State.notify_one();
+    }
+
+    void lock() noexcept
+    {
+        // Common case, no conflicts.
+        if (try_lock()) [[likely]]
+            return;
+
+        // Most critical sections are short, so wait them out.
+        for (size_t i = 0; i < 256; ++i)
+        {
+            _mm_pause();
+
+            if (State.load(std::memory_order_relaxed) == 0 && try_lock()) return;
+        }
+
+        // Mark as contended, the unlocking thread then knows to wake us.
+        while (State.exchange(2, std::memory_order_acquire) != 0)
+            State.wait(2, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,254 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Opt-in contention counters for any lockable, keyed by the lock and the site that acquired it.
+    std::scoped_lock and friends report their own header as the site, use Lockprofiler::Guard_t to get the caller.
+    Counters are per-thread and only merged when a snapshot is requested.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include <source_location>
+#include "Spinlock.hpp"
+
+namespace Lockprofiler
+{
+    // Times are in TSC cycles where available, nanoseconds otherwise.
+    struct Counters_t
+    {
+        uint64_t Acquisitions{}, Contended{};
+        uint64_t Waittotal{}, Waitmax{};
+        uint64_t Holdtotal{}, Holdmax{};
+
+        void Merge(const Counters_t &Other) noexcept
+        {
+            Acquisitions += Other.Acquisitions; Contended += Other.Contended;
+            Waittotal += Other.Waittotal; Waitmax = std::max(Waitmax, Other.Waitmax);
+            Holdtotal += Other.Holdtotal; Holdmax = std::max(Holdmax, Other.Holdmax);
+        }
+    };
+
+    // Where the lock was taken and which lock it was, source_location strings have static storage.
+    // Files are compared by content as every translation unit may have its own copy of the string.
+    struct Site_t
+    {
+        const char *File, *Function;
+        uint32_t Line;
+
+        const void *Instance;
+        const char *Declaredfile;
+        uint32_t Declaredline;
+
+        bool operator==(const Site_t &Right) const noexcept
+        {
+            return Instance == Right.Instance && Line == Right.Line && std::string_view(File) == std::string_view(Right.File);
+        }
+    };
+    struct Sitehash_t
+    {
+        size_t operator()(const Site_t &Site) const noexcept
+        {
+            return std::hash<std::string_view>{}(Site.File) ^ (size_t(Site.Line) * 0x9E3779B97F4A7C15ULL) ^ std::hash<const void *>{}(Site.Instance);
+        }
+    };
+    using Sitemap_t = std::unordered_map<Site_t, Counters_t, Sitehash_t>;
+
+    inline uint64_t Timestamp() noexcept
+    {
+        #if defined(HAS_CPUID)
+        return __rdtsc();
+        #else
+        return uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+    }
+
+    namespace Internal
+    {
+        struct Thread_t;
+        struct Registry_t
+        {
+            std::mutex Lock{};
+            std::vector<Thread_t *> Threads{};
+            Sitemap_t Retired{};
+        };
+        inline Registry_t &Registry()
+        {
+            static Registry_t Instance{};
+            return Instance;
+        }
+
+        // The local lock is only contended while a snapshot is being taken.
+        struct Thread_t
+        {
+            Spinlock_t Lock{};
+            Sitemap_t Sites{};
+
+            Thread_t()
+            {
+                std::scoped_lock Guard(Registry().Lock);
+                Registry().Threads.push_back(this);
+            }
+            ~Thread_t()
+            {
+                std::scoped_lock Guard(Registry().Lock, Lock);
+                for (const auto &[Site, Counters] : Sites) Registry().Retired[Site].Merge(Counters);
+                std::erase(Registry().Threads, this);
+            }
+        };
+        inline Thread_t &Local()
+        {
+            thread_local Thread_t Instance{};
+            return Instance;
+        }
+    }
+
+    inline void Record(const Site_t &Site, uint64_t Wait, bool Contended, uint64_t Hold) noexcept
+    {
+        auto &Local = Internal::Local();
+        std::scoped_lock Guard(Local.Lock);
+
+        // Called from unlock() in guard destructors, so a new site that can't be allocated is dropped rather than thrown.
+        Sitemap_t::iterator Entry;
+        try { Entry = Local.Sites.try_emplace(Site).first; }
+        catch (const std::bad_alloc &) { return; }
+        auto &Counters = Entry->second;
+
+        Counters.Acquisitions++;
+        Counters.Contended += Contended;
+        Counters.Waittotal += Wait; Counters.Waitmax = std::max(Counters.Waitmax, Wait);
+        Counters.Holdtotal += Hold; Counters.Holdmax = std::max(Counters.Holdmax, Hold);
+    }
+
+    // Totals across all threads, including those that have exited.
+    inline Sitemap_t Snapshot()
+    {
+        auto &Registry = Internal::Registry();
+        std::scoped_lock Guard(Registry.Lock);
+        Sitemap_t Result = Registry.Retired;
+
+        for (const auto Thread : Registry.Threads)
+        {
+            std::scoped_lock Inner(Thread->Lock);
+            for (const auto &[Site, Counters] : Thread->Sites) Result[Site].Merge(Counters);
+        }
+
+        return Result;
+    }
+    inline void Reset()
+    {
+        auto &Registry = Internal::Registry();
+        std::scoped_lock Guard(Registry.Lock);
+        Registry.Retired.clear();
+
+        for (const auto Thread : Registry.Threads)
+        {
+            std::scoped_lock Inner(Thread->Lock);
+            Thread->Sites.clear();
+        }
+    }
+
+    // Hottest locks first, by total time spent waiting.
+    inline std::string Dump()
+    {
+        const auto Sites = Snapshot();
+        std::vector<std::pair<Site_t, Counters_t>> Sorted(Sites.begin(), Sites.end());
+        std::ranges::sort(Sorted, std::greater{}, [](const auto &Item) { return Item.second.Waittotal; });
+
+        JSON::Array_t Output{};
+        for (const auto &[Site, Counters] : Sorted)
+        {
+            JSON::Object_t Entry{};
+            Entry[u8"File"] = std::string(Site.File);
+            Entry[u8"Function"] = std::string(Site.Function);
+            Entry[u8"Line"] = Site.Line;
+            Entry[u8"Declared"] = std::format("{}:{}", Site.Declaredfile, Site.Declaredline);
+            Entry[u8"Acquisitions"] = Counters.Acquisitions;
+            Entry[u8"Contended"] = Counters.Contended;
+            Entry[u8"Waittotal"] = Counters.Waittotal;
+            Entry[u8"Waitmax"] = Counters.Waitmax;
+            Entry[u8"Holdtotal"] = Counters.Holdtotal;
+            Entry[u8"Holdmax"] = Counters.Holdmax;
+            Output.emplace_back(std::move(Entry));
+        }
+
+        return JSON::Dump(JSON::Value_t(std::move(Output)));
+    }
+}
+
+// Wraps any lockable, enabled for Defaultmutex_t with -DPROFILE_LOCKS.
+template <typename Lock_t> struct Profiledmutex_t
+{
+    Lock_t Inner{};
+
+    // Only written by the holder, the call-site part is updated on every acquisition.
+    Lockprofiler::Site_t Site;
+    uint64_t Acquired{}, Waited{};
+    bool Contended{};
+
+    Profiledmutex_t(std::source_location Location = std::source_location::current()) noexcept
+        : Site{ Location.file_name(), Location.function_name(), Location.line(), this, Location.file_name(), Location.line() } {}
+
+    Profiledmutex_t(const Profiledmutex_t &) = delete;
+    Profiledmutex_t &operator=(const Profiledmutex_t &) = delete;
+
+    bool try_lock(std::source_location Location = std::source_location::current())
+    {
+        if (!Inner.try_lock()) return false;
+
+        Acquired = Lockprofiler::Timestamp();
+        Waited = 0; Contended = false;
+        Setsite(Location);
+        return true;
+    }
+    void lock(std::source_location Location = std::source_location::current())
+    {
+        const auto Start = Lockprofiler::Timestamp();
+        const auto Immediate = Inner.try_lock();
+        if (!Immediate) Inner.lock();
+
+        Acquired = Lockprofiler::Timestamp();
+        Waited = Acquired - Start;
+        Contended = !Immediate;
+        Setsite(Location);
+    }
+    void unlock()
+    {
+        const auto Hold = Lockprofiler::Timestamp() - Acquired;
+        const auto Wait = Waited;
+        const bool wasContended = Contended;
+
+        // Bookkeeping happens outside the critical section.
+        const auto Current = Site;
+        Inner.unlock();
+        Lockprofiler::Record(Current, Wait, wasContended, Hold);
+    }
+
+private:
+    void Setsite(const std::source_location &Location) noexcept
+    {
+        Site.File = Location.file_name();
+        Site.Function = Location.function_name();
+        Site.Line = Location.line();
+    }
+};
+
+namespace Lockprofiler
+{
+    // Like std::lock_guard, but profiled locks get the guard's location as their site.
+    template <typename Lock_t> struct [[nodiscard]] Guard_t
+    {
+        Lock_t &Lock;
+
+        explicit Guard_t(Lock_t &Target, std::source_location Location = std::source_location::current()) : Lock(Target)
+        {
+            if constexpr (requires { Lock.lock(Location); }) Lock.lock(Location);
+            else Lock.lock();
+        }
+        ~Guard_t() { Lock.unlock(); }
+
+        Guard_t(const Guard_t &) = delete;
+        Guard_t &operator=(const Guard_t &) = delete;
+    };
+}
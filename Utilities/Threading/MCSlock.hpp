@@ -0,0 +1,122 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Queue lock, each waiter spins on a flag in its own cache-line.
+    Nodes come from a per-thread freelist so that it can be used as a plain mutex.
+*/
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <intrin.h>
+
+struct MCSlock_t
+{
+    struct alignas(64) Node_t
+    {
+        std::atomic<Node_t *> Next;
+        std::atomic<bool> Locked;
+        Node_t *Free;
+    };
+
+    std::atomic<Node_t *> Tail{};
+    Node_t *Holder{};
+
+    // One node per lock held concurrently by the thread, freed when the thread exits.
+    static inline thread_local constinit Node_t *Freelist{};
+    struct Owner_t
+    {
+        ~Owner_t()
+        {
+            while (Freelist) delete std::exchange(Freelist, Freelist->Free);
+        }
+    };
+
+    static Node_t *Acquire() noexcept
+    {
+        if (!Freelist) [[unlikely]]
+        {
+            // Only reached on allocation, so the hot path doesn't pay for the TLS destructor.
+            thread_local Owner_t Owner{};
+            (void)Owner;
+
+            Freelist = new Node_t{};
+        }
+        auto Node = Freelist;
+
+        Freelist = Node->Free;
+        Node->Free = (Node_t *)&Freelist;
+        return Node;
+    }
+    static void Release(Node_t *Node) noexcept
+    {
+        // Free doubles as a back-pointer to the owning threads list while in use.
+        const auto Freelist = (Node_t **)Node->Free;
+        Node->Free = *Freelist;
+        *Freelist = Node;
+    }
+
+    bool try_lock() noexcept
+    {
+        if (Tail.load(std::memory_order_relaxed)) return false;
+
+        const auto Node = Acquire();
+        Node->Next.store(nullptr, std::memory_order_relaxed);
+
+        Node_t *Expected{};
+        if (!Tail.compare_exchange_strong(Expected, Node, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            Release(Node);
+            return false;
+        }
+
+        Holder = Node;
+        return true;
+    }
+    void lock() noexcept
+    {
+        const auto Node = Acquire();
+        Node->Next.store(nullptr, std::memory_order_relaxed);
+        Node->Locked.store(true, std::memory_order_relaxed);
+
+        if (const auto Previous = Tail.exchange(Node, std::memory_order_acq_rel))
+        {
+            Previous->Next.store(Node, std::memory_order_release);
+
+            for (size_t i = 0; Node->Locked.load(std::memory_order_acquire); ++i)
+            {
+                _mm_pause();
+
+                // Oversubscribed, let the holder run.
+                if (i > 4096) std::this_thread::yield();
+            }
+        }
+
+        Holder = Node;
+    }
+    void unlock() noexcept
+    {
+        const auto Node = Holder;
+        auto Successor = Node->Next.load(std::memory_order_acquire);
+
+        if (!Successor)
+        {
+            // No one waiting.
+            auto Expected = Node;
+            if (Tail.compare_exchange_strong(Expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+            {
+                Release(Node);
+                return;
+            }
+
+            // Someone swapped in but hasn't linked yet.
+            while (!(Successor = Node->Next.load(std::memory_order_acquire))) _mm_pause();
+        }
+
+        Successor->Locked.store(false, std::memory_order_release);
+        Release(Node);
+    }
+};
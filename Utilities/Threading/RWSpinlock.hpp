@@ -0,0 +1,63 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Reader-writer spinlock for read-mostly data, compatible with std::shared_lock.
+    Writers announce themselves first so that new readers can't starve them.
+*/
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <intrin.h>
+
+struct RWSpinlock_t
+{
+    static constexpr uint32_t Writer = 1U << 31, Pending = 1U << 30, Readers = Pending - 1;
+    std::atomic<uint32_t> State{};
+
+    // Exclusive.
+    bool try_lock() noexcept
+    {
+        auto Expected = State.load(std::memory_order_relaxed);
+        if (Expected & (Writer | Readers)) return false;
+        return State.compare_exchange_strong(Expected, Writer, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void unlock() noexcept
+    {
+        State.fetch_and(~Writer, std::memory_order_release);
+    }
+    void lock() noexcept
+    {
+        for (size_t i = 0; !try_lock(); ++i)
+        {
+            // Block new readers until we're in.
+            State.fetch_or(Pending, std::memory_order_relaxed);
+
+            _mm_pause();
+            if (i > 1024) std::this_thread::yield();
+        }
+    }
+
+    // Shared.
+    bool try_lock_shared() noexcept
+    {
+        auto Expected = State.load(std::memory_order_relaxed);
+        if (Expected & (Writer | Pending)) return false;
+        return State.compare_exchange_strong(Expected, Expected + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void unlock_shared() noexcept
+    {
+        State.fetch_sub(1, std::memory_order_release);
+    }
+    void lock_shared() noexcept
+    {
+        for (size_t i = 0; !try_lock_shared(); ++i)
+        {
+            _mm_pause();
+            if (i > 1024) std::this_thread::yield();
+        }
+    }
+};
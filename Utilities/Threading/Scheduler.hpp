@@ -0,0 +1,343 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Work-stealing task scheduler, one Chase-Lev deque per worker.
+    Waiting on a group runs other tasks in the meantime, so it's safe to do from inside a task.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include <coroutine>
+#include "Spinlock.hpp"
+
+// Outstanding jobs, must outlive them.
+struct Waitgroup_t
+{
+    std::atomic<size_t> Pending{};
+
+    [[nodiscard]] bool Done() const noexcept { return Pending.load(std::memory_order_acquire) == 0; }
+};
+
+struct Job_t
+{
+    std::move_only_function<void()> Work;
+
+    // Dependencies starts at 1 as a hold released by Submit(), continuations add to it.
+    std::atomic<uint32_t> Dependencies{ 1 };
+    Job_t *Successor{};
+    Waitgroup_t *Group{};
+
+    // Set instead of Work by awaiters that embed the job in the coroutine frame, so resuming doesn't allocate.
+    std::coroutine_handle<> Coroutine{};
+};
+
+// Owner pushes and pops at the bottom, thieves take from the top.
+template <size_t N> requires (std::has_single_bit(N))
+struct Workdeque_t
+{
+    static constexpr int64_t Mask = N - 1;
+
+    alignas(64) std::atomic<int64_t> Top{};
+    alignas(64) std::atomic<int64_t> Bottom{};
+    std::array<std::atomic<Job_t *>, N> Buffer{};
+
+    bool Push(Job_t *Job) noexcept
+    {
+        const auto B = Bottom.load(std::memory_order_relaxed);
+        const auto T = Top.load(std::memory_order_acquire);
+        if (B - T >= int64_t(N)) [[unlikely]] return false;
+
+        Buffer[B & Mask].store(Job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Bottom.store(B + 1, std::memory_order_relaxed);
+        return true;
+    }
+    Job_t *Pop() noexcept
+    {
+        const auto B = Bottom.load(std::memory_order_relaxed) - 1;
+        Bottom.store(B, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto T = Top.load(std::memory_order_relaxed);
+
+        if (T > B)
+        {
+            Bottom.store(B + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto Job = Buffer[B & Mask].load(std::memory_order_relaxed);
+
+        // Last item, race the thieves for it.
+        if (T == B)
+        {
+            if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) Job = nullptr;
+            Bottom.store(B + 1, std::memory_order_relaxed);
+        }
+
+        return Job;
+    }
+    Job_t *Steal() noexcept
+    {
+        auto T = Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto B = Bottom.load(std::memory_order_acquire);
+
+        if (T >= B) return nullptr;
+
+        const auto Job = Buffer[T & Mask].load(std::memory_order_relaxed);
+        if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return Job;
+    }
+};
+
+struct Scheduler_t
+{
+    struct Worker_t
+    {
+        Workdeque_t<4096> Deque{};
+        std::jthread Thread{};
+    };
+
+    std::vector<std::unique_ptr<Worker_t>> Workers{};
+
+    // Submissions from threads outside the pool.
+    Spinlock_t Globallock{};
+    std::deque<Job_t *> Global{};
+    std::atomic<size_t> Globalsize{};
+
+    // Idle workers sleep on the epoch, which is bumped for every submission.
+    std::atomic<uint32_t> Epoch{}, Sleepers{};
+    std::atomic<bool> Terminate{};
+
+    // Which pool and worker the current thread belongs to, if any.
+    static inline thread_local Scheduler_t *Currentpool{};
+    static inline thread_local size_t Currentindex{};
+
+    explicit Scheduler_t(size_t Threadcount = std::max(2U, std::thread::hardware_concurrency()) - 1)
+    {
+        // Stealing picks a victim modulo the worker count.
+        Threadcount = std::max<size_t>(Threadcount, 1);
+
+        for (size_t i = 0; i < Threadcount; ++i) Workers.emplace_back(std::make_unique<Worker_t>());
+        for (size_t i = 0; i < Threadcount; ++i) Workers[i]->Thread = std::jthread([this, i]() { Workerloop(i); });
+    }
+    ~Scheduler_t()
+    {
+        Terminate.store(true);
+        Epoch.fetch_add(1);
+        Epoch.notify_all();
+
+        for (const auto &Worker : Workers) Worker->Thread.join();
+    }
+
+    // Shared pool for ParallelFor and friends.
+    static Scheduler_t &Default()
+    {
+        static Scheduler_t Instance{};
+        return Instance;
+    }
+
+    // Jobs are held until Submit(), so continuations can be attached first.
+    template <typename F> [[nodiscard]] Job_t *Create(F &&Work, Waitgroup_t *Group = nullptr)
+    {
+        const auto Job = new Job_t{ std::forward<F>(Work) };
+        Job->Group = Group;
+
+        if (Group) Group->Pending.fetch_add(1, std::memory_order_relaxed);
+        return Job;
+    }
+
+    // After runs once Before (and any other predecessors) have finished, one successor per job.
+    static void Then(Job_t *Before, Job_t *After) noexcept
+    {
+        assert(!Before->Successor);
+        After->Dependencies.fetch_add(1, std::memory_order_relaxed);
+        Before->Successor = After;
+    }
+
+    void Submit(Job_t *Job)
+    {
+        if (Job->Dependencies.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+        // Workers keep their own spawns local for cache locality.
+        if (!(Currentpool == this && Workers[Currentindex]->Deque.Push(Job)))
+        {
+            // Full deque, run it directly rather than block.
+            if (Currentpool == this) return Execute(Job);
+
+            std::scoped_lock Guard(Globallock);
+            Global.push_back(Job);
+            Globalsize.fetch_add(1, std::memory_order_release);
+        }
+
+        Epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (Sleepers.load(std::memory_order_seq_cst)) Epoch.notify_one();
+    }
+    template <typename F> void Spawn(F &&Work, Waitgroup_t *Group = nullptr)
+    {
+        Submit(Create(std::forward<F>(Work), Group));
+    }
+
+    // Help out until the group is done instead of blocking the thread.
+    void Wait(const Waitgroup_t &Group)
+    {
+        for (size_t Idle = 0; !Group.Done();)
+        {
+            if (const auto Job = Findwork())
+            {
+                Execute(Job);
+                Idle = 0;
+            }
+            else if (++Idle < 64) _mm_pause();
+            else std::this_thread::yield();
+        }
+    }
+
+private:
+    void Execute(Job_t *Job)
+    {
+        // Owned by the frame, which may well be gone once resumed.
+        if (Job->Coroutine) return Job->Coroutine.resume();
+
+        Job->Work();
+
+        const auto Successor = Job->Successor;
+        const auto Group = Job->Group;
+        delete Job;
+
+        if (Successor) Submit(Successor);
+        if (Group) Group->Pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    Job_t *Findwork()
+    {
+        if (Currentpool == this)
+            if (const auto Job = Workers[Currentindex]->Deque.Pop())
+                return Job;
+
+        if (Globalsize.load(std::memory_order_acquire))
+        {
+            std::scoped_lock Guard(Globallock);
+            if (!Global.empty())
+            {
+                const auto Job = Global.front();
+                Global.pop_front();
+                Globalsize.fetch_sub(1, std::memory_order_relaxed);
+                return Job;
+            }
+        }
+
+        // Random victim to spread the thieves out.
+        thread_local uint64_t Seed = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+        Seed ^= Seed << 13; Seed ^= Seed >> 7; Seed ^= Seed << 17;
+
+        const auto Start = size_t(Seed % Workers.size());
+        for (size_t i = 0; i < Workers.size(); ++i)
+        {
+            const auto Victim = (Start + i) % Workers.size();
+            if (Currentpool == this && Victim == Currentindex) continue;
+            if (const auto Job = Workers[Victim]->Deque.Steal()) return Job;
+        }
+
+        return nullptr;
+    }
+
+    void Workerloop(size_t Index)
+    {
+        Currentpool = this;
+        Currentindex = Index;
+
+        while (!Terminate.load(std::memory_order_relaxed))
+        {
+            if (const auto Job = Findwork()) { Execute(Job); continue; }
+
+            // Check once more after announcing ourselves, submissions bump the epoch first.
+            const auto Current = Epoch.load(std::memory_order_seq_cst);
+            Sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+            if (const auto Job = Findwork())
+            {
+                Sleepers.fetch_sub(1, std::memory_order_relaxed);
+                Execute(Job);
+                continue;
+            }
+
+            if (!Terminate.load()) Epoch.wait(Current, std::memory_order_seq_cst);
+            Sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+// ParallelFor(Range(0, 100, 2), [](int i) {}), or anything else random-access and sized such as Enumerate().
+template <std::ranges::random_access_range R, typename F> requires std::ranges::sized_range<R>
+void ParallelFor(R &&Input, F &&Function, size_t Grainsize = 0, Scheduler_t &Scheduler = Scheduler_t::Default())
+{
+    const auto Count = size_t(std::ranges::size(Input));
+    if (Count == 0) return;
+
+    // A few chunks per worker leaves room for stealing to balance things out.
+    if (Grainsize == 0) Grainsize = std::max<size_t>(1, Count / ((Scheduler.Workers.size() + 1) * 8));
+
+    const auto First = std::ranges::begin(Input);
+    Waitgroup_t Group{};
+
+    for (size_t Offset = 0; Offset < Count; Offset += Grainsize)
+    {
+        const auto Last = std::min(Count, Offset + Grainsize);
+        Scheduler.Spawn([&Function, First, Offset, Last]()
+        {
+            for (size_t i = Offset; i < Last; ++i) Function(First[i]);
+        }, &Group);
+    }
+
+    Scheduler.Wait(Group);
+}
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Schedulertest()
+    {
+        Scheduler_t Pool(3);
+
+        // Asking for no workers still gets one.
+        {
+            Scheduler_t Empty(0);
+            Waitgroup_t Group{};
+            Empty.Spawn([]() {}, &Group);
+            Empty.Wait(Group);
+            if (Empty.Workers.size() != 1) std::printf("BROKEN: Scheduler without workers\n");
+        }
+
+        std::vector<std::atomic<uint32_t>> Hits(10000);
+        ParallelFor(Range(0, 10000), [&](int i) { Hits[i]++; }, 0, Pool);
+        if (!std::ranges::all_of(Hits, [](const auto &Item) { return Item == 1; })) std::printf("BROKEN: Scheduler ParallelFor\n");
+
+        // Nested waits from inside tasks.
+        std::atomic<size_t> Sum{};
+        ParallelFor(std::views::iota(0, 8), [&](int)
+        {
+            Waitgroup_t Inner{};
+            for (size_t i = 0; i < 100; ++i) Pool.Spawn([&]() { Sum++; }, &Inner);
+            Pool.Wait(Inner);
+        }, 1, Pool);
+        if (Sum != 800) std::printf("BROKEN: Scheduler nested waits\n");
+
+        // C runs once both A and B are done.
+        Waitgroup_t Group{};
+        std::atomic<uint32_t> Order{};
+        uint32_t Seen{};
+
+        const auto A = Pool.Create([&]() { Order++; }, &Group);
+        const auto B = Pool.Create([&]() { Order++; }, &Group);
+        const auto C = Pool.Create([&]() { Seen = Order; }, &Group);
+        Scheduler_t::Then(A, C); Scheduler_t::Then(B, C);
+        Pool.Submit(C); Pool.Submit(A); Pool.Submit(B);
+
+        Pool.Wait(Group);
+        if (Seen != 2) std::printf("BROKEN: Scheduler continuations\n");
+    }
+}
+#endif
@@ -0,0 +1,51 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    FIFO spinlock, waiters back off in proportion to their place in line.
+*/
+
+#pragma once
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <cstdint>
+#include <intrin.h>
+
+struct Ticketlock_t
+{
+    // Separate lines so that taking a ticket doesn't disturb the spinners.
+    alignas(64) std::atomic<uint32_t> Next{};
+    alignas(64) std::atomic<uint32_t> Serving{};
+
+    // More waiters ahead of us than cores means the holder may not even be running.
+    static inline const uint32_t Cores = std::max(1U, std::thread::hardware_concurrency());
+
+    bool try_lock() noexcept
+    {
+        auto Current = Serving.load(std::memory_order_relaxed);
+        return Next.compare_exchange_strong(Current, Current + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    void unlock() noexcept
+    {
+        // Only the owner writes Serving.
+        Serving.store(Serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void lock() noexcept
+    {
+        const auto Ticket = Next.fetch_add(1, std::memory_order_relaxed);
+
+        for (size_t Spins = 0; ; ++Spins)
+        {
+            const auto Current = Serving.load(std::memory_order_acquire);
+            if (Current == Ticket) [[likely]] return;
+
+            // Roughly a critical section per thread ahead of us, within a small budget before letting them run.
+            const auto Ahead = Ticket - Current;
+            if (Ahead >= Cores || Spins >= 16) std::this_thread::yield();
+            else for (uint32_t i = 0; i < Ahead * 32; ++i) _mm_pause();
+        }
+    }
+};
@@ -0,0 +1,342 @@
+/*
+    Initial author: Convery (tcn@ayria.se)
+    Started: 2026-10-14
+    License: MIT
+
+    Zone tracing for hot paths, TRACE_ZONE("Name") records a begin/end pair of timestamps.
+    Every thread writes to its own ring without locks, a background thread drains them into a Chrome trace (chrome://tracing, Perfetto).
+    Compiled out unless ENABLE_TRACING is defined.
+*/
+
+#pragma once
+#include <Utilities.hpp>
+#include "../Containers/Ringbuffer.hpp"
+
+namespace Tracer
+{
+    #if defined (ENABLE_TRACING)
+    constexpr bool isEnabled = true;
+    #else
+    constexpr bool isEnabled = false;
+    #endif
+
+    // TSC cycles where available, nanoseconds otherwise. Converted to wall time when flushing.
+    inline uint64_t Timestamp() noexcept
+    {
+        #if defined(HAS_CPUID)
+        return __rdtsc();
+        #else
+        return uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+    }
+
+    // Names must have static storage, only the pointer is kept.
+    struct Event_t
+    {
+        const char *Name;
+        uint64_t Begin, End;
+    };
+
+    namespace Internal
+    {
+        // 384 KiB per thread, a few milliseconds of very dense zones between flushes.
+        using Ring_t = Spscring_t<Event_t, 16384>;
+
+        struct Thread_t
+        {
+            Ring_t Ring{};
+            std::atomic<uint64_t> Dropped{};
+            std::atomic<bool> Exited{};
+            std::atomic<const char *> Threadname{};
+            uint32_t ID{};
+        };
+
+        struct Registry_t
+        {
+            std::mutex Lock{};
+            std::vector<std::shared_ptr<Thread_t>> Threads{};
+            uint32_t NextID{ 1 };
+
+            // Events from threads whose ring couldn't be allocated.
+            std::atomic<uint64_t> Dropped{};
+        };
+        // Leaked on purpose, exiting threads and the flusher may still use it during static destruction.
+        inline Registry_t &Registry()
+        {
+            static const auto Instance = new Registry_t();
+            return *Instance;
+        }
+
+        // The ring may outlive the thread, the flusher drops it once drained.
+        struct Owner_t
+        {
+            std::shared_ptr<Thread_t> Thread{};
+            ~Owner_t() { if (Thread) Thread->Exited.store(true, std::memory_order_release); }
+        };
+
+        // Plain pointer so the hot path doesn't go through a TLS init guard.
+        inline thread_local constinit Thread_t *Current{};
+
+        // Runs from zone destructors, so running out of memory leaves the thread unregistered rather than throwing.
+        [[gnu::noinline]] inline Thread_t *Register() noexcept
+        {
+            thread_local Owner_t Owner{};
+            auto &Registry = Internal::Registry();
+
+            try
+            {
+                auto Thread = std::make_shared<Thread_t>();
+
+                std::scoped_lock Guard(Registry.Lock);
+                Registry.Threads.push_back(Thread);
+                Thread->ID = Registry.NextID++;
+                Owner.Thread = std::move(Thread);
+            }
+            catch (const std::bad_alloc &) { return nullptr; }
+
+            return Current = Owner.Thread.get();
+        }
+        inline Thread_t *Local() noexcept
+        {
+            if (!Current) [[unlikely]] return Register();
+            return Current;
+        }
+    }
+
+    // Full rings drop the event rather than block.
+    inline void Record(const char *Name, uint64_t Begin, uint64_t End) noexcept
+    {
+        const auto Local = Internal::Local();
+        if (!Local) [[unlikely]] Internal::Registry().Dropped.fetch_add(1, std::memory_order_relaxed);
+        else if (!Local->Ring.try_emplace(Name, Begin, End)) [[unlikely]] Local->Dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Shown instead of the numeric ID, needs static storage like the zone names.
+    inline void Setthreadname(const char *Name) noexcept
+    {
+        if (const auto Local = Internal::Local()) Local->Threadname.store(Name, std::memory_order_release);
+    }
+
+    struct Zone_t
+    {
+        const char *Name;
+        uint64_t Begin;
+
+        explicit Zone_t(const char *Zonename) noexcept : Name(Zonename), Begin(Timestamp()) {}
+        ~Zone_t() noexcept { Record(Name, Begin, Timestamp()); }
+
+        Zone_t(const Zone_t &) = delete;
+        Zone_t &operator=(const Zone_t &) = delete;
+    };
+
+    namespace Internal
+    {
+        struct Flusher_t
+        {
+            std::mutex Lock{};
+            std::FILE *File{};
+            bool Firstevent{ true };
+
+            // Ticks are mapped to microseconds since Start(), calibrated there and refined on every flush.
+            uint64_t Epochticks{};
+            std::chrono::steady_clock::time_point Epochtime{};
+            double Ticksperus{ 1.0 };
+
+            std::vector<uint32_t> Named{};
+
+            // Last, so that it's gone before anything it uses.
+            std::jthread Worker{};
+
+            void Calibrate()
+            {
+                const auto Ticks = Timestamp() - Epochticks;
+                const auto Elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - Epochtime).count();
+                if (Elapsed > 1000.0) Ticksperus = double(Ticks) / Elapsed;
+            }
+
+            void Write(const char *Format, auto... Args)
+            {
+                std::fputs(Firstevent ? "[\n" : ",\n", File);
+                std::fprintf(File, Format, Args...);
+                Firstevent = false;
+            }
+            static std::string Escape(const char *Input)
+            {
+                std::string Output{};
+                for (; *Input; ++Input)
+                {
+                    if (*Input == '"' || *Input == '\\') Output += '\\';
+                    if (uint8_t(*Input) >= 0x20) Output += *Input;
+                }
+                return Output;
+            }
+
+            void Drain()
+            {
+                std::scoped_lock Guard(Lock);
+                if (!File) return;
+                Calibrate();
+
+                std::vector<std::shared_ptr<Thread_t>> Threads{};
+                {
+                    std::scoped_lock Inner(Registry().Lock);
+                    Threads = Registry().Threads;
+                }
+
+                std::array<Event_t, 256> Batch;
+                for (const auto &Thread : Threads)
+                {
+                    // Exited is read first so nothing written before the thread left can be missed.
+                    const auto hasExited = Thread->Exited.load(std::memory_order_acquire);
+
+                    if (const auto Name = Thread->Threadname.load(std::memory_order_acquire); Name && std::ranges::find(Named, Thread->ID) == Named.end())
+                    {
+                        Write(R"({"name":"thread_name","ph":"M","pid":1,"tid":%u,"args":{"name":"%s"}})", Thread->ID, Escape(Name).c_str());
+                        Named.push_back(Thread->ID);
+                    }
+
+                    while (const auto Count = Thread->Ring.pop_batch(Batch))
+                    {
+                        for (size_t i = 0; i < Count; ++i)
+                        {
+                            const auto &Event = Batch[i];
+                            const auto Begin = double(int64_t(Event.Begin - Epochticks)) / Ticksperus;
+                            const auto Duration = double(Event.End - Event.Begin) / Ticksperus;
+                            Write(R"({"name":"%s","ph":"X","pid":1,"tid":%u,"ts":%.3f,"dur":%.3f})", Escape(Event.Name).c_str(), Thread->ID, Begin, Duration);
+                        }
+                    }
+
+                    if (const auto Dropped = Thread->Dropped.exchange(0, std::memory_order_relaxed))
+                        Write(R"({"name":"Dropped %llu events","ph":"i","s":"t","pid":1,"tid":%u,"ts":%.3f})", (unsigned long long)Dropped, Thread->ID,
+                              double(Timestamp() - Epochticks) / Ticksperus);
+
+                    if (hasExited)
+                    {
+                        std::scoped_lock Inner(Registry().Lock);
+                        std::erase(Registry().Threads, Thread);
+                    }
+                }
+
+                if (const auto Dropped = Registry().Dropped.exchange(0, std::memory_order_relaxed))
+                    Write(R"({"name":"Dropped %llu events","ph":"i","s":"g","pid":1,"tid":0,"ts":%.3f})", (unsigned long long)Dropped,
+                          double(Timestamp() - Epochticks) / Ticksperus);
+
+                std::fflush(File);
+            }
+
+            // Stop the worker, write what's left, and terminate the array.
+            void Close()
+            {
+                if (Worker.joinable())
+                {
+                    Worker.request_stop();
+                    Worker.join();
+                }
+
+                Drain();
+
+                std::scoped_lock Guard(Lock);
+                if (!File) return;
+
+                std::fputs(Firstevent ? "[]\n" : "\n]\n", File);
+                std::fclose(File);
+                File = nullptr;
+            }
+
+            // Returning from main without Stop() still leaves a valid trace.
+            ~Flusher_t() { Close(); }
+        };
+        inline Flusher_t &Flusher()
+        {
+            static Flusher_t Instance{};
+            return Instance;
+        }
+    }
+
+    // Output goes to a new file, events recorded before Start() are written out with the first flush.
+    inline bool Start(const std::filesystem::path &Path, std::chrono::milliseconds Interval = std::chrono::milliseconds(10))
+    {
+        auto &Flusher = Internal::Flusher();
+        {
+            std::scoped_lock Guard(Flusher.Lock);
+            if (Flusher.File) return false;
+
+            Flusher.File = std::fopen(Path.string().c_str(), "wb");
+            if (!Flusher.File) return false;
+
+            Flusher.Firstevent = true;
+            Flusher.Named.clear();
+            Flusher.Epochticks = Timestamp();
+            Flusher.Epochtime = std::chrono::steady_clock::now();
+
+            // A millisecond of spinning, so that even an immediate flush has a usable tick rate.
+            while (std::chrono::steady_clock::now() - Flusher.Epochtime <= std::chrono::milliseconds(1)) {}
+            Flusher.Calibrate();
+        }
+
+        Flusher.Worker = std::jthread([&Flusher, Interval](std::stop_token Token)
+        {
+            while (!Token.stop_requested())
+            {
+                std::this_thread::sleep_for(Interval);
+                Flusher.Drain();
+            }
+        });
+
+        return true;
+    }
+
+    // Drain whatever is buffered right now, without waiting for the interval.
+    inline void Flush() { Internal::Flusher().Drain(); }
+
+    inline void Stop() { Internal::Flusher().Close(); }
+}
+
+// Name must be a string literal.
+#if defined (ENABLE_TRACING)
+    #define TRACE_CONCAT_(A, B) A##B
+    #define TRACE_CONCAT(A, B) TRACE_CONCAT_(A, B)
+    #define TRACE_ZONE(Name) const Tracer::Zone_t TRACE_CONCAT(Tracezone_, __LINE__){ "" Name }
+    #define TRACE_FUNCTION() const Tracer::Zone_t TRACE_CONCAT(Tracezone_, __LINE__){ __func__ }
+#else
+    #define TRACE_ZONE(Name)
+    #define TRACE_FUNCTION()
+#endif
+
+#if defined(ENABLE_UNITTESTS)
+namespace Unittests
+{
+    inline void Tracertest()
+    {
+        const auto Path = std::filesystem::temp_directory_path() / "Tracertest.json";
+        if (!Tracer::Start(Path, std::chrono::milliseconds(1))) { std::printf("BROKEN: Tracer::Start\n"); return; }
+
+        Tracer::Setthreadname("Main");
+        { const Tracer::Zone_t Outer("Outer"); const Tracer::Zone_t Inner("Inner \"quoted\""); }
+
+        // Flushed right after Start(), so the tick rate must already be calibrated.
+        Tracer::Flush();
+
+        // Threads that exit before the flush must still show up.
+        std::thread([]()
+        {
+            Tracer::Setthreadname("Worker");
+            for (int i = 0; i < 1000; ++i) const Tracer::Zone_t Zone("Work");
+        }).join();
+
+        Tracer::Stop();
+
+        std::string Content(std::filesystem::file_size(Path), '\0');
+        const auto File = std::fopen(Path.string().c_str(), "rb");
+        Content.resize(std::fread(Content.data(), 1, Content.size(), File));
+        std::fclose(File);
+        std::filesystem::remove(Path);
+
+        // 1002 zones and two thread names.
+        const auto Parsed = JSON::Parse(Content);
+        const JSON::Array_t &Events = Parsed;
+        if (Events.size() != 1004 || std::string(Events.back()[u8"name"]) != "Work") std::printf("BROKEN: Tracer output\n");
+        if (const JSON::Number_t &Begin = Events[1][u8"ts"]; Begin <= 0.0 || Begin > 100000.0) std::printf("BROKEN: Tracer calibration\n");
+    }
+}
+#endif
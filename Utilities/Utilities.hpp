@@ -8,7 +8,10 @@
 
 #pragma once
 #include <Stdinclude.hpp>
+#include "CPUID.hpp"
 #include "Constexpr.hpp"
+#include "Benchmark.hpp"
+#include "Memory.hpp"
 #include "Containers.hpp"
 #include "Crypto.hpp"
 #include "Datatypes.hpp"
@@ -16,3 +19,6 @@
 #include "Python.hpp"
 #include "Strings.hpp"
 #include "Threading.hpp"
+
+// Builds on Crypto and Threading.
+#include "Compression.hpp"